@@ -0,0 +1,35 @@
+#pragma once
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "llvm/Support/ThreadPool.h"
+#include "rain/lang/code/module.hpp"
+#include "rain/lang/options.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain {
+
+struct Source {
+    /** The name used to refer to the source in diagnostics. */
+    std::string_view file_name = "<unknown>";
+    std::string_view code;
+};
+
+/**
+ * Compile each of the independent sources in parallel on the given thread pool.
+ *
+ * The results (or the diagnostic for any source that failed to compile) are returned in the same
+ * order as the sources. Each source is compiled into its own module, with its own LLVM context,
+ * so that the resulting modules can be further processed (optimized, linked, ...) in parallel as
+ * well.
+ *
+ * The options are shared between all of the compiles, and must be safe to use from multiple
+ * threads. The LLVM targets must have been initialized before calling this function.
+ */
+std::vector<util::Result<lang::code::Module>> compile_batch(std::span<const Source> sources,
+                                                            lang::Options&          options,
+                                                            llvm::ThreadPool&       thread_pool);
+
+}  // namespace rain
@@ -0,0 +1,81 @@
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+#include "llvm/Support/ThreadPool.h"
+#include "rain/batch.hpp"
+#include "rain/lang/target/wasm/init.hpp"
+#include "rain/lang/target/wasm/options.hpp"
+
+namespace {
+
+// A small "shader-like" snippet; each copy is given a unique function name so that the sources
+// are not trivially identical.
+std::string make_source(int index) {
+    return absl::StrCat(R"(
+struct Vec4 {
+    x: f32,
+    y: f32,
+    z: f32,
+    w: f32,
+}
+
+fn dot(a: Vec4, b: Vec4) -> f32 {
+    a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w
+}
+
+export fn shade_)",
+                        index, R"((n: i32, a: Vec4, b: Vec4) -> f32 {
+    let sum = 0.0
+    let i = 0
+    while i < n {
+        sum = sum + dot(a, b)
+        i = i + 1
+    }
+    sum
+}
+)");
+}
+
+constexpr int SOURCE_COUNT = 256;
+
+void BM_CompileBatch(benchmark::State& state) {
+    rain::lang::wasm::initialize_llvm();
+
+    std::vector<std::string>  codes;
+    std::vector<rain::Source> sources;
+    codes.reserve(SOURCE_COUNT);
+    sources.reserve(SOURCE_COUNT);
+    for (int i = 0; i < SOURCE_COUNT; ++i) {
+        codes.emplace_back(make_source(i));
+        sources.push_back(rain::Source{.file_name = "<bench>", .code = codes.back()});
+    }
+
+    rain::lang::wasm::Options options;
+    llvm::ThreadPool          thread_pool(
+        llvm::hardware_concurrency(static_cast<unsigned>(state.range(0))));
+
+    for (auto _ : state) {
+        auto results = rain::compile_batch(sources, options, thread_pool);
+        for (auto& result : results) {
+            if (!result.has_value()) {
+                state.SkipWithError(result.error()->message().c_str());
+                return;
+            }
+        }
+        benchmark::DoNotOptimize(results);
+    }
+
+    state.SetItemsProcessed(state.iterations() * SOURCE_COUNT);
+}
+
+BENCHMARK(BM_CompileBatch)
+    ->RangeMultiplier(2)
+    ->Range(1, 32)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
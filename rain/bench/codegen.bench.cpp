@@ -0,0 +1,448 @@
+#include <array>
+#include <string>
+#include <string_view>
+
+#include "benchmark/benchmark.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "rain/lang/target/wasm/init.hpp"
+#include "rain/lang/target/wasm/options.hpp"
+#include "rain/link.hpp"
+#include "rain/load.hpp"
+#include "rain/run.hpp"
+#include "rain/spec/read_with_std.hpp"
+
+// Measures the speed of the code that the compiler produces (rather than the speed of the compiler
+// itself), by running it on wabt's interpreter. Each benchmark reports the number of wasm
+// instructions that a single call executes, along with the wall time, for each optimization level.
+//
+// Programs may import lib/std (which the benchmark depends on as data), to compare the standard
+// library against the scalar code it replaces.
+
+namespace {
+
+struct Program {
+    std::string_view code;
+    int32_t          arg;
+};
+
+constexpr Program FIB = {
+    .code = R"(
+fn fib(n: i32) -> i32 {
+    if n < 2 {
+        n
+    } else {
+        fib(n - 1) + fib(n - 2)
+    }
+}
+
+export fn run(n: i32) -> i32 {
+    fib(n)
+}
+)",
+    .arg  = 16,
+};
+
+constexpr Program MAT4_MULTIPLY = {
+    .code = R"(
+struct Vec4 {
+    x: f32,
+    y: f32,
+    z: f32,
+    w: f32,
+}
+
+struct Mat4 {
+    x: Vec4,
+    y: Vec4,
+    z: Vec4,
+    w: Vec4,
+}
+
+fn Vec4.new(x: f32, y: f32, z: f32, w: f32) -> Vec4 {
+    Vec4{ x: x, y: y, z: z, w: w }
+}
+
+fn Mat4.mul_vec4(self, v: Vec4) -> Vec4 {
+    Vec4{
+        x: self.x.x * v.x + self.y.x * v.y + self.z.x * v.z + self.w.x * v.w,
+        y: self.x.y * v.x + self.y.y * v.y + self.z.y * v.z + self.w.y * v.w,
+        z: self.x.z * v.x + self.y.z * v.y + self.z.z * v.z + self.w.z * v.w,
+        w: self.x.w * v.x + self.y.w * v.y + self.z.w * v.z + self.w.w * v.w,
+    }
+}
+
+fn Mat4.mul(self, other: Mat4) -> Mat4 {
+    Mat4{
+        x: self.mul_vec4(other.x),
+        y: self.mul_vec4(other.y),
+        z: self.mul_vec4(other.z),
+        w: self.mul_vec4(other.w),
+    }
+}
+
+export fn run(n: i32) -> f32 {
+    let rotate = Mat4{
+        x: Vec4.new(0.0, 1.0, 0.0, 0.0),
+        y: Vec4.new(-1.0, 0.0, 0.0, 0.0),
+        z: Vec4.new(0.0, 0.0, 1.0, 0.0),
+        w: Vec4.new(0.0, 0.0, 0.0, 1.0),
+    }
+
+    let m = rotate
+    let i = 0
+    while i < n {
+        m = m.mul(rotate)
+        i = i + 1
+    }
+    m.x.x + m.y.y + m.z.z + m.w.w
+}
+)",
+    .arg  = 256,
+};
+
+// The same as MAT4_MULTIPLY, using the SIMD-backed standard library.
+constexpr Program STD_MAT4_MULTIPLY = {
+    .code = R"(
+import { Mat4 } from "lib/std/math/mat4"
+
+export fn run(n: i32) -> f32 {
+    let rotate = Mat4.new(
+        0.0, -1.0, 0.0, 0.0,
+        1.0, 0.0, 0.0, 0.0,
+        0.0, 0.0, 1.0, 0.0,
+        0.0, 0.0, 0.0, 1.0,
+    )
+
+    let m = rotate
+    let i = 0
+    while i < n {
+        m = m.mul(rotate)
+        i = i + 1
+    }
+    m.x.x + m.y.y + m.z.z + m.w.w
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program MAT4_TRANSFORM = {
+    .code = R"(
+struct Vec4 {
+    x: f32,
+    y: f32,
+    z: f32,
+    w: f32,
+}
+
+struct Mat4 {
+    x: Vec4,
+    y: Vec4,
+    z: Vec4,
+    w: Vec4,
+}
+
+fn Vec4.new(x: f32, y: f32, z: f32, w: f32) -> Vec4 {
+    Vec4{ x: x, y: y, z: z, w: w }
+}
+
+fn Mat4.mul_vec4(self, v: Vec4) -> Vec4 {
+    Vec4{
+        x: self.x.x * v.x + self.y.x * v.y + self.z.x * v.z + self.w.x * v.w,
+        y: self.x.y * v.x + self.y.y * v.y + self.z.y * v.z + self.w.y * v.w,
+        z: self.x.z * v.x + self.y.z * v.y + self.z.z * v.z + self.w.z * v.w,
+        w: self.x.w * v.x + self.y.w * v.y + self.z.w * v.z + self.w.w * v.w,
+    }
+}
+
+export fn run(n: i32) -> f32 {
+    let m = Mat4{
+        x: Vec4.new(0.0, 1.0, 0.0, 0.0),
+        y: Vec4.new(-1.0, 0.0, 0.0, 0.0),
+        z: Vec4.new(0.0, 0.0, 1.0, 0.0),
+        w: Vec4.new(1.0, 2.0, 3.0, 1.0),
+    }
+
+    let v = Vec4.new(1.0, 0.0, 0.0, 1.0)
+    let i = 0
+    while i < n {
+        v = m.mul_vec4(v)
+        i = i + 1
+    }
+    v.x + v.y + v.z + v.w
+}
+)",
+    .arg  = 256,
+};
+
+// The same as MAT4_TRANSFORM, using the SIMD-backed standard library.
+constexpr Program STD_MAT4_TRANSFORM = {
+    .code = R"(
+import { Mat4 } from "lib/std/math/mat4"
+import { Vec4 } from "lib/std/math/vec4"
+
+export fn run(n: i32) -> f32 {
+    let m = Mat4.new(
+        0.0, -1.0, 0.0, 1.0,
+        1.0, 0.0, 0.0, 2.0,
+        0.0, 0.0, 1.0, 3.0,
+        0.0, 0.0, 0.0, 1.0,
+    )
+
+    let v = Vec4.new(1.0, 0.0, 0.0, 1.0)
+    let i = 0
+    while i < n {
+        v = m.mul_vec4(v)
+        i = i + 1
+    }
+    v.v.sum()
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program STD_MAT4_INVERSE = {
+    .code = R"(
+import { Mat4 } from "lib/std/math/mat4"
+
+export fn run(n: i32) -> f32 {
+    let m = Mat4.new(
+        2.0, 0.0, 1.0, 1.0,
+        1.0, 3.0, 0.0, 2.0,
+        0.0, 1.0, 4.0, 1.0,
+        1.0, 0.0, 0.0, 1.0,
+    )
+
+    let i = 0
+    while i < n {
+        m = m.inverse()
+        i = i + 1
+    }
+    m.x.x + m.y.y + m.z.z + m.w.w
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program SLICE_SUM = {
+    .code = R"(
+export fn run(n: i32) -> i32 {
+    let values = []i32{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }
+
+    let sum = 0
+    let i = 0
+    while i < n {
+        let j = 0
+        while j < values.length() {
+            sum = sum + values[j]
+            j = j + 1
+        }
+        i = i + 1
+    }
+    sum
+}
+)",
+    .arg  = 256,
+};
+
+// The bulk-memory slice builtins, and the loops they replace.
+
+constexpr Program SLICE_FILL_LOOP = {
+    .code = R"(
+export fn run(n: i32) -> i32 {
+    let values = []i32{ n, n, n, n, n, n, n, n, n, n, n, n, n, n, n, n }
+
+    let i = 0
+    while i < n {
+        let j = 0
+        while j < values.length() {
+            values[j] = i
+            j = j + 1
+        }
+        i = i + 1
+    }
+    values[15]
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program SLICE_FILL = {
+    .code = R"(
+export fn run(n: i32) -> i32 {
+    let values = []i32{ n, n, n, n, n, n, n, n, n, n, n, n, n, n, n, n }
+
+    let i = 0
+    while i < n {
+        values.fill(i)
+        i = i + 1
+    }
+    values[15]
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program SLICE_INDEX_OF_LOOP = {
+    .code = R"(
+export fn run(n: i32) -> i32 {
+    let values = []i32{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }
+
+    let sum = 0
+    let i = 0
+    while i < n {
+        let j = 0
+        while j < values.length() {
+            if values[j] == 16 {
+                break
+            }
+            j = j + 1
+        }
+        sum = sum + j
+        i = i + 1
+    }
+    sum
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program SLICE_INDEX_OF = {
+    .code = R"(
+export fn run(n: i32) -> i32 {
+    let values = []i32{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16 }
+
+    let sum = 0
+    let i = 0
+    while i < n {
+        sum = sum + values.index_of(16)
+        i = i + 1
+    }
+    sum
+}
+)",
+    .arg  = 256,
+};
+
+constexpr Program INTERFACE_DISPATCH = {
+    .code = R"(
+struct Counter {
+    value: i32,
+}
+
+interface Step {
+    fn step(&self, by: i32) -> i32
+}
+
+impl Counter : Step {
+    fn step(&self, by: i32) -> i32 {
+        self.value = self.value + by
+        self.value
+    }
+}
+
+fn step_all(step: Step, n: i32) -> i32 {
+    let sum = 0
+    let i = 0
+    while i < n {
+        sum = sum + step.step(i)
+        i = i + 1
+    }
+    sum
+}
+
+export fn run(n: i32) -> i32 {
+    let counter = Counter{ value: 0 }
+    step_all(counter as Step, n)
+}
+)",
+    .arg  = 256,
+};
+
+struct Level {
+    std::string_view        name;
+    llvm::OptimizationLevel level;
+};
+
+const std::array<Level, 6> LEVELS = {{
+    {"O0", llvm::OptimizationLevel::O0},
+    {"O1", llvm::OptimizationLevel::O1},
+    {"O2", llvm::OptimizationLevel::O2},
+    {"O3", llvm::OptimizationLevel::O3},
+    {"Os", llvm::OptimizationLevel::Os},
+    {"Oz", llvm::OptimizationLevel::Oz},
+}};
+
+void BM_Run(benchmark::State& state, const Program& program) {
+    rain::lang::wasm::initialize_llvm();
+
+    const auto& level = LEVELS[static_cast<size_t>(state.range(0))];
+    state.SetLabel(std::string(level.name));
+
+    rain::lang::wasm::Options options;
+    rain::ModuleGraph         graph(rain::spec::read_with_std(program.code));
+    if (auto load_result = graph.load("main.rain", options); !load_result.has_value()) {
+        state.SkipWithError(load_result.error()->message().c_str());
+        return;
+    }
+
+    auto module_result = graph.compile(options);
+    if (!module_result.has_value()) {
+        state.SkipWithError(module_result.error()->message().c_str());
+        return;
+    }
+    auto mod = std::move(module_result).value();
+    mod.optimize(level.level);
+
+    auto link_result = rain::link(mod, options);
+    if (!link_result.has_value()) {
+        state.SkipWithError(link_result.error()->message().c_str());
+        return;
+    }
+    const auto wasm = std::move(link_result).value();
+
+    auto instance_result = rain::WasmInstance::instantiate(wasm->data());
+    if (!instance_result.has_value()) {
+        state.SkipWithError(instance_result.error()->message().c_str());
+        return;
+    }
+    auto instance = std::move(instance_result).value();
+
+    const std::array<rain::WasmValue, 1> args = {program.arg};
+
+    // Count the instructions of a single call up front, as counting slows the interpreter down.
+    instance.set_count_instructions(true);
+    if (auto result = instance.call("run", args); !result.has_value()) {
+        state.SkipWithError(result.error()->message().c_str());
+        return;
+    }
+    const auto instructions = instance.instructions_executed();
+    instance.set_count_instructions(false);
+
+    for (auto _ : state) {
+        auto result = instance.call("run", args);
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.counters["instructions"] = static_cast<double>(instructions);
+    state.counters["wasm_bytes"]   = static_cast<double>(wasm->data().size());
+}
+
+BENCHMARK_CAPTURE(BM_Run, fib, FIB)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, mat4_multiply, MAT4_MULTIPLY)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, std_mat4_multiply, STD_MAT4_MULTIPLY)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, mat4_transform, MAT4_TRANSFORM)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, std_mat4_transform, STD_MAT4_TRANSFORM)
+    ->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, std_mat4_inverse, STD_MAT4_INVERSE)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, slice_sum, SLICE_SUM)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, slice_fill_loop, SLICE_FILL_LOOP)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, slice_fill, SLICE_FILL)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, slice_index_of_loop, SLICE_INDEX_OF_LOOP)
+    ->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, slice_index_of, SLICE_INDEX_OF)->DenseRange(0, LEVELS.size() - 1);
+BENCHMARK_CAPTURE(BM_Run, interface_dispatch, INTERFACE_DISPATCH)
+    ->DenseRange(0, LEVELS.size() - 1);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>  // size_t
+#include <cstdint>  // uint32_t
 #include <cstdlib>  // malloc, free
 #include <string_view>
 
@@ -16,6 +17,34 @@ enum Action {
     CompileRain,
     CompileLLVM,
     DecompileWasm,
+
+    /** Part of the WAT text, when it is streamed (see `StageStreamDecompile`). */
+    DecompileWasmChunk,
+};
+
+/**
+ * Selects which artifacts a compile produces; each one is reported through `callback` with the
+ * matching `Action`. Stages that were not asked for are skipped entirely.
+ */
+enum Stage : uint32_t {
+    StageNone = 0,
+
+    /** Print the (optionally optimized) module as LLVM IR text. */
+    StageEmitIR = 1 << 0,
+
+    /** Link the module into a WebAssembly binary. */
+    StageLink = 1 << 1,
+
+    /** Decompile the WebAssembly binary into WAT. This runs the link, even if it is not reported. */
+    StageDecompile = 1 << 2,
+
+    /**
+     * Report the WAT text in chunks (`DecompileWasmChunk`) as it is written, instead of all at
+     * once. Implies `StageDecompile`.
+     */
+    StageStreamDecompile = 1 << 3,
+
+    StageAll = StageEmitIR | StageLink | StageDecompile,
 };
 
 WASM_IMPORT("env", "callback")
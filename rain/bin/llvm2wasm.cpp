@@ -1,24 +1,70 @@
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include "rain/bin/common.hpp"
-#include "rain/lang/code/target/default.hpp"
+#include "rain/lang/target/wasm/init.hpp"
+#include "rain/lang/target/wasm/options.hpp"
 #include "rain/link.hpp"
 #include "rain/util/wasm.hpp"
 
+namespace {
+
+rain::lang::wasm::Options _options;
+
+}  // namespace
+
 WASM_EXPORT("init")
 void initialize() {
 #if defined(__wasm__)
     __wasm_call_ctors();
 #endif  // defined(__wasm__)
-    rain::lang::code::initialize_llvm();
+    rain::lang::wasm::initialize_llvm();
+}
+
+WASM_EXPORT("set_memory_export")
+void export_memory(const char* memory_name_start, const char* memory_name_end) {
+    _options.set_memory_export_name(std::string{memory_name_start, memory_name_end});
+}
+
+WASM_EXPORT("set_stack_size")
+void set_stack_size(uint32_t stack_size) { _options.set_stack_size(stack_size); }
+
+WASM_EXPORT("set_max_memory")
+void set_max_memory(uint32_t max_memory) { _options.set_max_memory(max_memory); }
+
+// The memory is then imported as "env" "memory".
+WASM_EXPORT("set_shared_memory")
+void set_shared_memory(bool shared_memory) { _options.set_shared_memory(shared_memory); }
+
+// Errors (an unknown CPU or feature, or a feature missing one it depends on) are reported through
+// the callback, and leave the options unchanged.
+WASM_EXPORT("set_cpu")
+void set_cpu(const char* cpu_start, const char* cpu_end) {
+    if (auto result = _options.set_cpu(std::string{cpu_start, cpu_end}); !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+    }
+}
+
+// For example "+tail-call,+relaxed-simd" or "-simd128".
+WASM_EXPORT("set_features")
+void set_features(const char* features_start, const char* features_end) {
+    if (auto result = _options.set_features(std::string_view{features_start, features_end});
+        !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+    }
 }
 
+// The source may be either textual LLVM IR or LLVM bitcode.
 WASM_EXPORT("compile")
 void compile(const char* source_start, const char* source_end) {
     static std::unique_ptr<rain::Buffer> prev_result;
     prev_result.reset();
 
     // Link the LLVM IR into WebAssembly.
-    auto llvm_target_machine = rain::lang::code::target_machine();
-    auto link_result = rain::link(std::string_view{source_start, source_end}, *llvm_target_machine);
+    auto link_result = rain::link(std::string_view{source_start, source_end}, _options);
     if (!link_result.has_value()) {
         const auto msg = link_result.error()->message();
         callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
@@ -26,7 +72,8 @@ void compile(const char* source_start, const char* source_end) {
     }
 
     prev_result = std::move(link_result).value();
-    callback(rain::Action::CompileLLVM, prev_result->string().begin(), prev_result->string().end());
+    callback(rain::Action::CompileLLVM, &*prev_result->string().begin(),
+             &*prev_result->string().end());
 }
 
 #if !defined(__wasm__)
@@ -1,20 +1,64 @@
+#include <string>
+
 #include "rain/bin/common.hpp"
 #include "rain/compile.hpp"
-#include "rain/lang/code/target/default.hpp"
+#include "rain/lang/target/wasm/init.hpp"
+#include "rain/lang/target/wasm/options.hpp"
 #include "rain/util/wasm.hpp"
 
+namespace {
+
+enum OutputFormat : uint32_t {
+    OutputIR                = 0,
+    OutputBitcode           = 1,
+    OutputCompressedBitcode = 2,
+};
+
+rain::lang::wasm::Options _options;
+uint32_t                  _output_format = OutputIR;
+
+}  // namespace
+
 WASM_EXPORT("init")
 void initialize() {
 #if defined(__wasm__)
     __wasm_call_ctors();
 #endif  // defined(__wasm__)
-    rain::lang::code::initialize_llvm();
+    rain::lang::wasm::initialize_llvm();
     // load_external_functions_into_llvm();
 }
 
-uint32_t stack_size = 0;
 WASM_EXPORT("set_stack_size")
-void set_stack_size(const int32_t size) { rain::lang::code::set_stack_size(size); }
+void set_stack_size(uint32_t stack_size) { _options.set_stack_size(stack_size); }
+
+// Enables the atomics and bulk-memory features, which shared memory needs.
+WASM_EXPORT("set_shared_memory")
+void set_shared_memory(bool shared_memory) { _options.set_shared_memory(shared_memory); }
+
+// Errors (an unknown CPU or feature, or a feature missing one it depends on) are reported through
+// the callback, and leave the options unchanged.
+WASM_EXPORT("set_cpu")
+void set_cpu(const char* cpu_start, const char* cpu_end) {
+    if (auto result = _options.set_cpu(std::string{cpu_start, cpu_end}); !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+    }
+}
+
+// For example "+tail-call,+relaxed-simd" or "-simd128".
+WASM_EXPORT("set_features")
+void set_features(const char* features_start, const char* features_end) {
+    if (auto result = _options.set_features(std::string_view{features_start, features_end});
+        !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+    }
+}
+
+// 0: textual LLVM IR (the default), 1: LLVM bitcode, 2: zstd compressed LLVM bitcode.
+// Bitcode can be passed to llvm2wasm in place of the textual IR.
+WASM_EXPORT("set_output_format")
+void set_output_format(uint32_t output_format) { _output_format = output_format; }
 
 WASM_EXPORT("compile")
 void compile(const char* source_start, const char* source_end) {
@@ -22,7 +66,7 @@ void compile(const char* source_start, const char* source_end) {
     prev_result.clear();
 
     // Compile the source code.
-    auto compile_result = rain::compile(std::string_view{source_start, source_end});
+    auto compile_result = rain::compile(std::string_view{source_start, source_end}, _options);
     if (!compile_result.has_value()) {
         const auto msg = compile_result.error()->message();
         callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
@@ -34,7 +78,16 @@ void compile(const char* source_start, const char* source_end) {
     module.optimize();
 
     // Get the LLVM IR.
-    auto ir_result = module.emit_ir();
+    auto ir_result = [&]() {
+        switch (_output_format) {
+            case OutputBitcode:
+                return module.emit_bitcode();
+            case OutputCompressedBitcode:
+                return module.emit_bitcode(rain::lang::code::BitcodeCompression::Zstd);
+            default:
+                return module.emit_ir();
+        }
+    }();
     if (!ir_result.has_value()) {
         const auto msg = ir_result.error()->message();
         callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
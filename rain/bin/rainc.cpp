@@ -1,3 +1,4 @@
+#include <memory>
 #include <string>
 
 #include "rain/bin/common.hpp"
@@ -9,6 +10,16 @@ namespace {
 
 rain::lang::wasm::Options _options;
 
+// The session is created lazily, so that it picks up any options set before the first compile.
+std::unique_ptr<rain::Session> _session;
+
+rain::Session& session() {
+    if (_session == nullptr) {
+        _session = std::make_unique<rain::Session>(_options);
+    }
+    return *_session;
+}
+
 }  // namespace
 
 WASM_EXPORT("init")
@@ -28,15 +39,53 @@ void export_memory(const char* memory_name_start, const char* memory_name_end) {
 WASM_EXPORT("set_stack_size")
 void set_stack_size(uint32_t stack_size) { _options.set_stack_size(stack_size); }
 
-WASM_EXPORT("compile")
-void compile(const char* source_start, const char* source_end, bool optimize) {
-    using namespace rain;
+WASM_EXPORT("set_max_memory")
+void set_max_memory(uint32_t max_memory) { _options.set_max_memory(max_memory); }
 
-    static std::string prev_result;
-    prev_result.clear();
+// Enables the atomics and bulk-memory features too. The memory is then imported as "env" "memory".
+WASM_EXPORT("set_shared_memory")
+void set_shared_memory(bool shared_memory) {
+    _options.set_shared_memory(shared_memory);
+
+    // The session's target machine was created with the old features.
+    _session.reset();
+}
+
+// Errors (an unknown CPU or feature, or a feature missing one it depends on) are reported through
+// the callback, and leave the options unchanged.
+WASM_EXPORT("set_cpu")
+void set_cpu(const char* cpu_start, const char* cpu_end) {
+    if (auto result = _options.set_cpu(std::string{cpu_start, cpu_end}); !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+        return;
+    }
+
+    // The session's target machine was created with the old features.
+    _session.reset();
+}
+
+// For example "+tail-call,+relaxed-simd" or "-simd128".
+WASM_EXPORT("set_features")
+void set_features(const char* features_start, const char* features_end) {
+    if (auto result = _options.set_features(std::string_view{features_start, features_end});
+        !result.has_value()) {
+        const auto msg = result.error()->message();
+        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+        return;
+    }
+
+    // The session's target machine was created with the old features.
+    _session.reset();
+}
+
+WASM_EXPORT("compile_stages")
+void compile_stages(const char* source_start, const char* source_end, bool optimize,
+                    uint32_t stages) {
+    using namespace rain;
 
     // Compile the source code.
-    auto compile_result = rain::compile(std::string_view{source_start, source_end}, _options);
+    auto compile_result = session().compile(std::string_view{source_start, source_end});
     if (!compile_result.has_value()) {
         const auto msg = compile_result.error()->message();
         callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
@@ -49,14 +98,20 @@ void compile(const char* source_start, const char* source_end, bool optimize) {
     }
 
     // Get the LLVM IR.
-    auto ir_result = rain_module.emit_ir();
-    if (!ir_result.has_value()) {
-        const auto msg = ir_result.error()->message();
-        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+    if ((stages & rain::StageEmitIR) != 0) {
+        auto ir_result = rain_module.emit_ir();
+        if (!ir_result.has_value()) {
+            const auto msg = ir_result.error()->message();
+            callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+            return;
+        }
+        auto ir = std::move(ir_result).value();
+        callback(rain::Action::CompileRain, ir.c_str(), ir.c_str() + ir.size());
+    }
+
+    if ((stages & (rain::StageLink | rain::StageDecompile | rain::StageStreamDecompile)) == 0) {
         return;
     }
-    auto ir = std::move(ir_result).value();
-    callback(rain::Action::CompileRain, ir.c_str(), ir.c_str() + ir.size());
 
     // Link the module into WebAssembly.
     auto link_result = rain::link(rain_module, _options);
@@ -66,17 +121,35 @@ void compile(const char* source_start, const char* source_end, bool optimize) {
         return;
     }
     auto wasm = std::move(link_result).value();
-    callback(rain::Action::CompileLLVM, &*wasm->string().begin(), &*wasm->string().end());
+    if ((stages & rain::StageLink) != 0) {
+        callback(rain::Action::CompileLLVM, &*wasm->string().begin(), &*wasm->string().end());
+    }
 
     // Decompile the WebAssembly into WAT.
-    auto decompile_result = rain::decompile(wasm->data());
-    if (!decompile_result.has_value()) {
-        const auto msg = decompile_result.error()->message();
-        callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
-        return;
+    if ((stages & rain::StageStreamDecompile) != 0) {
+        auto decompile_result = rain::decompile(wasm->data(), [](std::string_view chunk) {
+            callback(rain::Action::DecompileWasmChunk, chunk.data(), chunk.data() + chunk.size());
+        });
+        if (!decompile_result.has_value()) {
+            const auto msg = decompile_result.error()->message();
+            callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+            return;
+        }
+    } else if ((stages & rain::StageDecompile) != 0) {
+        auto decompile_result = rain::decompile(wasm->data());
+        if (!decompile_result.has_value()) {
+            const auto msg = decompile_result.error()->message();
+            callback(rain::Action::Error, msg.c_str(), msg.c_str() + msg.size());
+            return;
+        }
+        auto wat = std::move(decompile_result).value();
+        callback(rain::Action::DecompileWasm, &*wat->string().begin(), &*wat->string().end());
     }
-    auto wat = std::move(decompile_result).value();
-    callback(rain::Action::DecompileWasm, &*wat->string().begin(), &*wat->string().end());
+}
+
+WASM_EXPORT("compile")
+void compile(const char* source_start, const char* source_end, bool optimize) {
+    compile_stages(source_start, source_end, optimize, rain::StageAll);
 }
 
 #if !defined(__wasm__)
@@ -2,13 +2,36 @@
 
 #include <string_view>
 
+#include "absl/base/nullability.h"
 #include "rain/lang/ast/module.hpp"
+#include "rain/lang/code/incremental.hpp"
 #include "rain/lang/code/module.hpp"
 #include "rain/lang/options.hpp"
 #include "rain/util/result.hpp"
 
 namespace rain {
 
+/** Compile the source for wasm with the default options, which the module owns. */
+util::Result<lang::code::Module> compile(const std::string_view source);
+
+/** Compile the source. The options must outlive the module. */
 util::Result<lang::code::Module> compile(const std::string_view source, lang::Options& options);
 
+/**
+ * Compile the source, reusing the generated code of every function that has not changed since
+ * the last compile that used the same cache.
+ */
+util::Result<lang::code::Module> compile(const std::string_view source, lang::Options& options,
+                                         lang::code::FunctionCache& function_cache);
+
+/**
+ * Compile the source into `module`, which must not have been compiled into before.
+ *
+ * This lets the caller decide where the module's LLVM state comes from (see `rain::Session`).
+ */
+util::Result<void> compile(const std::string_view source, lang::Options& options,
+                           lang::code::Module&                        module,
+                           absl::Nullable<lang::code::FunctionCache*> function_cache = nullptr,
+                           const std::string_view                     file_name = "<unknown>");
+
 }  // namespace rain
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <span>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "rain/buffer.hpp"
 #include "rain/util/result.hpp"
@@ -10,6 +15,28 @@
 
 namespace rain {
 
+struct DecompileOptions {
+    /**
+     * The names of the functions to decompile the bodies of (with or without the leading '$'). If
+     * empty, every function is decompiled. Every other function is still listed, but without its
+     * body, so that the output stays readable.
+     */
+    std::vector<std::string> functions;
+
+    /** The (approximate) number of bytes of WAT text passed to the sink at a time. */
+    size_t chunk_size = 64 * 1024;
+};
+
+/** Receives the WAT text in order, one chunk at a time. */
+using DecompileSink = std::function<void(std::string_view chunk)>;
+
 util::Result<std::unique_ptr<Buffer>> decompile(const std::span<const uint8_t> wasm);
 
+/**
+ * Decompile the wasm binary, streaming the WAT text to `sink` as it is written instead of
+ * collecting all of it into a single buffer.
+ */
+util::Result<void> decompile(const std::span<const uint8_t> wasm, const DecompileSink& sink,
+                             const DecompileOptions& options = {});
+
 }  // namespace rain
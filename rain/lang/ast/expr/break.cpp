@@ -0,0 +1,15 @@
+#include "rain/lang/ast/expr/break.hpp"
+
+#include "rain/lang/err/syntax.hpp"
+
+namespace rain::lang::ast {
+
+util::Result<void> BreakExpression::validate(Options& options, Scope& scope) {
+    if (!scope.in_loop()) {
+        return ERR_PTR(err::SyntaxError, _location, "'break' can only be used inside of a loop");
+    }
+    scope.mark_loop_exit();
+    return {};
+}
+
+}  // namespace rain::lang::ast
@@ -2,6 +2,7 @@
 
 #include "rain/lang/ast/expr/identifier.hpp"
 #include "rain/lang/ast/expr/member.hpp"
+#include "rain/lang/ast/type/interface.hpp"
 #include "rain/lang/ast/type/meta.hpp"
 #include "rain/lang/ast/var/function.hpp"
 #include "rain/lang/err/syntax.hpp"
@@ -47,6 +48,20 @@ util::Result<void> CallExpression::validate(Options& options, Scope& scope) {
                                             callee_type->display_name(), "\""));
             }
 
+            // Interface methods are looked up in the vtbl of the value they are called on, so they
+            // must take it as their self argument.
+            const bool takes_self =
+                callee_type->kind() != serial::TypeKind::Meta &&
+                function->function_type()->argument_types().size() != argument_types.size();
+            if (auto* method_callee_type = function->function_type()->callee_type();
+                !takes_self && method_callee_type->kind() == serial::TypeKind::Interface &&
+                static_cast<InterfaceType*>(method_callee_type)->find_method(*function)) {
+                return ERR_PTR(err::SyntaxError, member.member_location(),
+                               absl::StrCat("interface method \"", member.name(),
+                                            "\" can only be called on a value of type \"",
+                                            method_callee_type->display_name(), "\""));
+            }
+
             _function = function;
             _type     = function->function_type()->return_type();
             break;
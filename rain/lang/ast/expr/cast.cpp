@@ -26,6 +26,14 @@ util::Result<void> CastExpression::validate(Options& options, Scope& scope) {
 
     const Scope::TypeList argument_types{_expression->type()};
     _method = scope.find_method(serial::OperatorNames::CastFrom, _type, argument_types);
+    if (_method == nullptr && _expression->type()->kind() != serial::TypeKind::Reference) {
+        // Look for a cast from a reference to the value, which is taken implicitly (as it is for
+        // methods that take `&self`).
+        const Scope::TypeList reference_argument_types{
+            &_expression->type()->get_reference_type(scope)};
+        _method =
+            scope.find_method(serial::OperatorNames::CastFrom, _type, reference_argument_types);
+    }
     if (_method == nullptr) {
         return ERR_PTR(err::BinaryOperatorError, _expression->location(), _type_location,
                        _op_location,
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+#include "absl/base/nullability.h"
+#include "rain/lang/ast/expr/expression.hpp"
+
+namespace rain::lang::ast {
+
+class ContinueExpression : public Expression {
+    lex::Location _location;
+
+  public:
+    ContinueExpression(lex::Location location) : _location(location) {}
+    ~ContinueExpression() override = default;
+
+    // Expression
+    [[nodiscard]] constexpr serial::ExpressionKind kind() const noexcept override {
+        return serial::ExpressionKind::Continue;
+    }
+    [[nodiscard]] constexpr absl::Nullable<Type*> type() const noexcept override { return nullptr; }
+    [[nodiscard]] constexpr lex::Location location() const noexcept override { return _location; }
+
+    [[nodiscard]] constexpr bool is_compile_time_capable() const noexcept override { return true; }
+
+    util::Result<void> validate(Options& options, Scope& scope) override;
+};
+
+}  // namespace rain::lang::ast
@@ -16,15 +16,8 @@ util::Result<void> ExternExpression::validate(Options& options, Scope& scope) {
                        "function is located");
     }
 
-    if (_keys[0] != "js") {
-        return ERR_PTR(err::SyntaxError, _location,
-                       "'js' is (currently) the only valid extern key");
-    }
-
-    if (_keys.size() != 3) {
-        return ERR_PTR(err::SyntaxError, _location,
-                       "extern 'js' functions must have 3 keys: 'js', the namespace, and the "
-                       "function name");
+    if (auto keys_result = options.validate_extern_keys(_keys); !keys_result.has_value()) {
+        return ERR_PTR(err::SyntaxError, _location, keys_result.error()->message());
     }
 
     _compile_time_capable = options.extern_is_compile_time_runnable(_keys);
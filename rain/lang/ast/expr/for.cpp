@@ -0,0 +1,62 @@
+#include "rain/lang/ast/expr/for.hpp"
+
+#include "absl/strings/str_cat.h"
+#include "rain/lang/ast/scope/builtin.hpp"
+#include "rain/lang/ast/var/block.hpp"
+#include "rain/lang/err/syntax.hpp"
+
+namespace rain::lang::ast {
+
+bool ForExpression::is_compile_time_capable() const noexcept {
+    return _start->is_compile_time_capable() &&
+           (_end == nullptr || _end->is_compile_time_capable()) &&
+           _loop->is_compile_time_capable();
+}
+
+util::Result<void> ForExpression::validate(Options& options, Scope& scope) {
+    {
+        auto result = _start->validate(options, scope);
+        FORWARD_ERROR(result);
+    }
+    if (_end != nullptr) {
+        auto result = _end->validate(options, scope);
+        FORWARD_ERROR(result);
+    }
+
+    absl::Nullable<Type*> variable_type = nullptr;
+    if (_end != nullptr) {
+        auto* const builtin = scope.builtin();
+        auto* const type    = _start->type();
+        if (type != builtin->i32_type() && type != builtin->i64_type() &&
+            type != builtin->i16_type()) {
+            return ERR_PTR(err::SyntaxError, _start->location(),
+                           absl::StrCat("for range must be over a signed integer type, found \"",
+                                        Type::display_name(type), "\""));
+        }
+        if (_end->type() != type) {
+            return ERR_PTR(err::SyntaxError, _end->location(),
+                           absl::StrCat("for range end must have the same type as its start, \"",
+                                        type->display_name(), "\""));
+        }
+        variable_type = type;
+    } else if (_start->type() != nullptr && _start->type()->kind() == serial::TypeKind::Slice) {
+        variable_type = &static_cast<SliceType*>(_start->type())->type();
+    } else if (_start->type() != nullptr && _start->type()->kind() == serial::TypeKind::Array) {
+        variable_type = &static_cast<ArrayType*>(_start->type())->type();
+    } else {
+        return ERR_PTR(err::SyntaxError, _start->location(),
+                       absl::StrCat("for loop must be over a range, slice or array, found \"",
+                                    Type::display_name(_start->type()), "\""));
+    }
+
+    // The loop variable is a new (immutable) value on every iteration, only visible in the loop.
+    _loop->scope().set_kind(BlockScope::Kind::Loop);
+    _variable = _loop->scope().add_variable(
+        std::make_unique<BlockVariable>(_name, variable_type, false));
+
+    auto result = _loop->validate(options, scope);
+    FORWARD_ERROR(result);
+    return {};
+}
+
+}  // namespace rain::lang::ast
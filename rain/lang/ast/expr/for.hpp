@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "absl/base/nullability.h"
+#include "rain/lang/ast/expr/block.hpp"
+#include "rain/lang/ast/expr/expression.hpp"
+#include "rain/lang/ast/var/variable.hpp"
+
+namespace rain::lang::ast {
+
+/**
+ * Either counts over a range of integers (`for i in start..end { ... }`, which does not include
+ * `end`), or visits every element of a slice or array (`for x in items { ... }`).
+ */
+class ForExpression : public Expression {
+    std::string_view _name;
+
+    /** The start of the range, or the slice or array being iterated over. */
+    std::unique_ptr<Expression> _start;
+
+    /** The (exclusive) end of the range; null when iterating over a slice or array. */
+    std::unique_ptr<Expression> _end;
+
+    std::unique_ptr<BlockExpression> _loop;
+    absl::Nullable<Variable*>        _variable = nullptr;
+
+    lex::Location _for_location;
+    lex::Location _variable_location;
+
+  public:
+    ForExpression(std::string_view name, std::unique_ptr<Expression> start,
+                  std::unique_ptr<Expression> end, std::unique_ptr<BlockExpression> loop,
+                  lex::Location for_location, lex::Location variable_location)
+        : _name(name),
+          _start(std::move(start)),
+          _end(std::move(end)),
+          _loop(std::move(loop)),
+          _for_location(for_location),
+          _variable_location(variable_location) {}
+    ~ForExpression() override = default;
+
+    // Expression
+    [[nodiscard]] constexpr serial::ExpressionKind kind() const noexcept override {
+        return serial::ExpressionKind::For;
+    }
+    [[nodiscard]] constexpr absl::Nullable<Type*> type() const noexcept override { return nullptr; }
+    [[nodiscard]] /*constexpr*/ lex::Location location() const noexcept override {
+        return _for_location.merge(_loop->location());
+    }
+
+    [[nodiscard]] bool is_compile_time_capable() const noexcept override;
+
+    // ForExpression
+    [[nodiscard]] constexpr std::string_view name() const noexcept { return _name; }
+    [[nodiscard]] constexpr bool             is_range() const noexcept { return _end != nullptr; }
+
+    [[nodiscard]] /*constexpr*/ const Expression& start() const noexcept { return *_start; }
+    [[nodiscard]] /*constexpr*/ Expression&       start() noexcept { return *_start; }
+    [[nodiscard]] /*constexpr*/ const Expression& end() const noexcept { return *_end; }
+    [[nodiscard]] /*constexpr*/ Expression&       end() noexcept { return *_end; }
+
+    [[nodiscard]] /*constexpr*/ const BlockExpression& loop() const noexcept { return *_loop; }
+    [[nodiscard]] /*constexpr*/ BlockExpression&       loop() noexcept { return *_loop; }
+
+    [[nodiscard]] constexpr absl::Nullable<Variable*> variable() const noexcept {
+        return _variable;
+    }
+    [[nodiscard]] constexpr lex::Location variable_location() const noexcept {
+        return _variable_location;
+    }
+
+    util::Result<void> validate(Options& options, Scope& scope) override;
+};
+
+}  // namespace rain::lang::ast
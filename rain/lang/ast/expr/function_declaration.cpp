@@ -13,6 +13,8 @@ FunctionDeclarationExpression::FunctionDeclarationExpression(
       _scope(std::make_unique<BlockScope>(parent)),
       _declaration_location(declaration_location),
       _return_type_location(return_type_location) {
+    _scope->set_kind(BlockScope::Kind::Function);
+
     for (auto& argument : arguments) {
         assert(argument != nullptr && "argument is null");
         _arguments.emplace_back(_scope->add_variable(std::move(argument)));
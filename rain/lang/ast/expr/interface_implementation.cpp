@@ -1,7 +1,11 @@
 #include "rain/lang/ast/expr/interface_implementation.hpp"
 
+#include "absl/strings/str_cat.h"
 #include "rain/lang/ast/type/interface.hpp"
+#include "rain/lang/ast/var/builtin_function.hpp"
+#include "rain/lang/code/interface.hpp"
 #include "rain/lang/err/syntax.hpp"
+#include "rain/lang/serial/operator_names.hpp"
 
 namespace rain::lang::ast {
 
@@ -13,42 +17,112 @@ InterfaceImplementationExpression::InterfaceImplementationExpression(
       _methods(std::move(methods)),
       _location(location) {}
 
-util::Result<void> InterfaceImplementationExpression::validate(Options& options, Scope& scope) {
-    {
-        auto implementer_type = _implementer_type->resolve(options, scope);
-        FORWARD_ERROR(implementer_type);
+util::Result<void> InterfaceImplementationExpression::declare(Options& options, Scope& scope) {
+    if (_declared) {
+        return {};
     }
+    _declared = true;
 
-    InterfaceType* interface_type = nullptr;
     {
-        auto interface_type_result = _interface_type->resolve(options, scope);
-        FORWARD_ERROR(interface_type_result);
+        auto result = _implementer_type->resolve(options, scope);
+        FORWARD_ERROR(result);
 
-        interface_type = static_cast<InterfaceType*>(std::move(interface_type_result).value());
+        _implementer_type = std::move(result).value();
     }
 
-    absl::flat_hash_set<Scope::FunctionVariableKey> function_keys;
-    for (const auto& method : _methods) {
-        auto result = method->validate(options, scope);
+    {
+        auto result = _interface_type->resolve(options, scope);
         FORWARD_ERROR(result);
 
-        const auto& type = method->function_type();
-        function_keys.emplace(Scope::FunctionVariableKey{method->name(), type->callee_type(),
-                                                         type->argument_types()});
+        _interface_type = std::move(result).value();
+    }
+
+    if (_interface_type->kind() != serial::TypeKind::Interface) {
+        return ERR_PTR(err::SyntaxError, _location,
+                       absl::StrCat("type '", _interface_type->display_name(),
+                                    "' is not an interface"));
     }
+    auto* interface_type = static_cast<InterfaceType*>(_interface_type);
+
+    absl::flat_hash_map<Scope::FunctionVariableKey, FunctionVariable*> methods;
+    for (const auto& method : _methods) {
+        const auto* type = method->variable()->function_type();
+        methods.emplace(
+            Scope::FunctionVariableKey{method->name(), _implementer_type, type->argument_types()},
+            method->variable());
+    }
+
+    // The receiver of each interface method (its first argument, if that is the interface or a
+    // reference to it) is the implementing type in the implementation, and every other argument
+    // is the same.
+    auto* interface_reference_type   = &_interface_type->get_reference_type(scope);
+    auto* implementer_reference_type = &_implementer_type->get_reference_type(scope);
 
     for (const auto& declaration : interface_type->methods()) {
-        const auto& type = declaration->function_type();
-        const auto  key  = Scope::FunctionVariableKey{declaration->name(), type->callee_type(),
-                                                    type->argument_types()};
-        if (function_keys.contains(key)) {
-            continue;
+        const auto* type           = declaration->variable()->function_type();
+        auto        argument_types = type->argument_types();
+        if (!argument_types.empty()) {
+            if (argument_types[0] == _interface_type) {
+                argument_types[0] = _implementer_type;
+            } else if (argument_types[0] == interface_reference_type) {
+                argument_types[0] = implementer_reference_type;
+            }
+        }
+
+        const auto it = methods.find(
+            Scope::FunctionVariableKey{declaration->name(), _implementer_type, argument_types});
+        if (it == methods.end()) {
+            return ERR_PTR(err::SyntaxError, _location,
+                           absl::StrCat("type '", _implementer_type->display_name(),
+                                        "' does not implement the function '",
+                                        declaration->name(), "' of interface '",
+                                        interface_type->name(), "' with type '",
+                                        type->display_name(), "'"));
+        }
+
+        if (auto* return_type = it->second->function_type()->return_type();
+            return_type != type->return_type()) {
+            return ERR_PTR(err::SyntaxError, it->second->location(),
+                           absl::StrCat("function '", declaration->name(), "' returns '",
+                                        Type::display_name(return_type), "', but interface '",
+                                        interface_type->name(), "' expects '",
+                                        Type::display_name(type->return_type()), "'"));
         }
 
+        _vtbl_methods.push_back(it->second);
+    }
+
+    // Interface values point to the value that implements them, so they are made from a reference
+    // to it (which is taken implicitly when casting a value, as when calling a `&self` method).
+    const Scope::TypeList argument_types{implementer_reference_type};
+    if (scope.find_function(serial::OperatorNames::CastFrom, _interface_type, argument_types) !=
+        nullptr) {
         return ERR_PTR(err::SyntaxError, _location,
-                       absl::StrCat("interface '", interface_type->name(),
-                                    "' does not contain a function named '", declaration->name(),
-                                    "' with type '", type->display_name(), "'"));
+                       absl::StrCat("type '", _implementer_type->display_name(),
+                                    "' already implements interface '", interface_type->name(),
+                                    "'"));
+    }
+
+    auto* function_type =
+        scope.get_resolved_function_type(_interface_type, argument_types, _interface_type);
+    auto method = make_builtin_function_variable(
+        serial::OperatorNames::CastFrom, function_type, [this](auto& ctx, auto& arguments) {
+            return code::create_interface_value(ctx, *this, arguments[0]);
+        });
+    scope.add_resolved_function(std::move(method));
+
+    return {};
+}
+
+util::Result<void> InterfaceImplementationExpression::validate(Options& options, Scope& scope) {
+    {
+        auto result = declare(options, scope);
+        FORWARD_ERROR(result);
+    }
+
+    for (const auto& method : _methods) {
+        auto result = method->validate(options, scope);
+        FORWARD_ERROR(result);
     }
 
     return {};
@@ -5,6 +5,7 @@
 #include <string_view>
 
 #include "absl/base/nullability.h"
+#include "llvm/ADT/SmallVector.h"
 #include "rain/lang/ast/expr/expression.hpp"
 #include "rain/lang/ast/expr/function.hpp"
 #include "rain/lang/ast/var/variable.hpp"
@@ -17,6 +18,10 @@ class InterfaceImplementationExpression : public Expression {
 
     std::vector<std::unique_ptr<FunctionExpression>> _methods;
 
+    /** The method that implements each of the interface's methods, in the order of its vtbl. */
+    llvm::SmallVector<absl::Nonnull<FunctionVariable*>, 4> _vtbl_methods;
+
+    bool          _declared = false;
     lex::Location _location;
 
   public:
@@ -37,6 +42,16 @@ class InterfaceImplementationExpression : public Expression {
     [[nodiscard]] constexpr auto implementer_type() const noexcept { return _implementer_type; }
     [[nodiscard]] constexpr auto interface_type() const noexcept { return _interface_type; }
     [[nodiscard]] constexpr const auto& methods() const noexcept { return _methods; }
+    [[nodiscard]] constexpr const auto& vtbl_methods() const noexcept { return _vtbl_methods; }
+
+    /**
+     * Match the methods to the ones of the interface, and add the cast from a reference to the
+     * implementing type into the interface to the scope.
+     *
+     * This is done before any other expression in the module is validated, so that the cast can
+     * be used before the `impl` block.
+     */
+    util::Result<void> declare(Options& options, Scope& scope);
 
     util::Result<void> validate(Options& options, Scope& scope) override;
 };
@@ -0,0 +1,13 @@
+#include "rain/lang/ast/expr/loop.hpp"
+
+namespace rain::lang::ast {
+
+util::Result<void> LoopExpression::validate(Options& options, Scope& scope) {
+    _loop->scope().set_kind(BlockScope::Kind::Loop);
+
+    auto result = _loop->validate(options, scope);
+    FORWARD_ERROR(result);
+    return {};
+}
+
+}  // namespace rain::lang::ast
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/base/nullability.h"
+#include "rain/lang/ast/expr/block.hpp"
+#include "rain/lang/ast/expr/expression.hpp"
+
+namespace rain::lang::ast {
+
+/** Repeats its block until a `break` exits it. */
+class LoopExpression : public Expression {
+    std::unique_ptr<BlockExpression> _loop;
+
+    lex::Location _loop_location;
+
+  public:
+    LoopExpression(std::unique_ptr<BlockExpression> loop, lex::Location loop_location)
+        : _loop(std::move(loop)), _loop_location(loop_location) {}
+    ~LoopExpression() override = default;
+
+    // Expression
+    [[nodiscard]] constexpr serial::ExpressionKind kind() const noexcept override {
+        return serial::ExpressionKind::Loop;
+    }
+    [[nodiscard]] constexpr absl::Nullable<Type*> type() const noexcept override { return nullptr; }
+    [[nodiscard]] /*constexpr*/ lex::Location location() const noexcept override {
+        return _loop_location.merge(_loop->location());
+    }
+
+    [[nodiscard]] bool is_compile_time_capable() const noexcept override {
+        return _loop->is_compile_time_capable();
+    }
+
+    // LoopExpression
+    [[nodiscard]] /*constexpr*/ const BlockExpression& loop() const noexcept { return *_loop; }
+    [[nodiscard]] /*constexpr*/ BlockExpression&       loop() noexcept { return *_loop; }
+
+    util::Result<void> validate(Options& options, Scope& scope) override;
+};
+
+}  // namespace rain::lang::ast
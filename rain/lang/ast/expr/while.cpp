@@ -13,6 +13,8 @@ bool WhileExpression::is_compile_time_capable() const noexcept {
 }
 
 util::Result<void> WhileExpression::validate(Options& options, Scope& scope) {
+    _loop->scope().set_kind(BlockScope::Kind::Loop);
+
     {
         auto result = _condition->validate(options, scope);
         FORWARD_ERROR(result);
@@ -31,14 +33,17 @@ util::Result<void> WhileExpression::validate(Options& options, Scope& scope) {
                        "while condition must result in a boolean value");
     }
 
-    // TODO: Handle optional types
-    assert(!_else.has_value() && "optional types not yet implemented in while expressions");
-    // if (_loop->type() != _else.value()->type()) {
-    //     return ERR_PTR(err::SimpleError, "while branches must have the same type");
-    // }
-
-    // _type = _then->type();
+    // A while-else has the value of the last iteration of the loop, or of the else block if the
+    // loop did not run at all; but an iteration left through a `break` or `continue` has no value.
     _type = nullptr;
+    if (_else.has_value() && _loop->type() != nullptr && _loop->type() == _else.value()->type()) {
+        if (_loop->scope().exits_loop()) {
+            return ERR_PTR(
+                err::SyntaxError, _while_location,
+                "a while-else with a value cannot use 'break' or 'continue' in its loop");
+        }
+        _type = _loop->type();
+    }
     return {};
 }
 
@@ -1,5 +1,7 @@
 #include "rain/lang/ast/module.hpp"
 
+#include "rain/lang/ast/expr/interface_implementation.hpp"
+
 namespace rain::lang::ast {
 
 util::Result<void> Module::validate(Options& options) {
@@ -8,6 +10,18 @@ util::Result<void> Module::validate(Options& options) {
         FORWARD_ERROR(result);
     }
 
+    // Interface implementations add the casts into their interfaces, which may be used anywhere
+    // in the module.
+    for (auto& expression : _expressions) {
+        if (expression->kind() != serial::ExpressionKind::Implementation) {
+            continue;
+        }
+
+        auto result =
+            static_cast<InterfaceImplementationExpression&>(*expression).declare(options, _scope);
+        FORWARD_ERROR(result);
+    }
+
     for (auto& expression : _expressions) {
         auto result = expression->validate(options, _scope);
         FORWARD_ERROR(result);
@@ -10,8 +10,27 @@
 
 namespace rain::lang::ast {
 
+/**
+ * An `import { a, b } from "path"` statement.
+ *
+ * Imports are not expressions; they are resolved between modules (see `rain::ModuleGraph`) before
+ * the importing module is validated.
+ */
+struct Import {
+    struct Name {
+        std::string_view name;
+        lex::Location    location;
+    };
+
+    /** The path as written in the source, relative to the importing file. */
+    std::string       path;
+    lex::Location     path_location;
+    std::vector<Name> names;
+};
+
 class Module {
     std::vector<std::unique_ptr<Expression>> _expressions;
+    std::vector<Import>                      _imports;
     ast::ModuleScope                         _scope;
 
   public:
@@ -25,11 +44,14 @@ class Module {
         const noexcept {
         return _expressions;
     }
-    [[nodiscard]] constexpr ast::ModuleScope& scope() noexcept { return _scope; }
+    [[nodiscard]] constexpr const std::vector<Import>& imports() const noexcept { return _imports; }
+    [[nodiscard]] constexpr ast::ModuleScope&          scope() noexcept { return _scope; }
+    [[nodiscard]] constexpr const ast::ModuleScope&    scope() const noexcept { return _scope; }
 
     void add_expression(std::unique_ptr<Expression> expression) {
         _expressions.push_back(std::move(expression));
     }
+    void add_import(Import import) { _imports.push_back(std::move(import)); }
 
     util::Result<void> validate(Options& options);
 };
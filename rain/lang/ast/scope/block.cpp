@@ -5,6 +5,34 @@ namespace rain::lang::ast {
 BlockScope::BlockScope(Scope& parent) : _parent(parent), _module(*parent.module()) {}
 
 BlockScope::BlockScope(BlockScope&& other)
-    : Scope(std::move(other)), _parent(other._parent), _module(other._module) {}
+    : Scope(std::move(other)),
+      _parent(other._parent),
+      _module(other._module),
+      _kind(other._kind),
+      _exits_loop(other._exits_loop) {}
+
+bool BlockScope::in_loop() const noexcept {
+    switch (_kind) {
+        case Kind::Loop:
+            return true;
+        case Kind::Function:
+            return false;
+        default:
+            return _parent.in_loop();
+    }
+}
+
+void BlockScope::mark_loop_exit() noexcept {
+    switch (_kind) {
+        case Kind::Loop:
+            _exits_loop = true;
+            break;
+        case Kind::Function:
+            break;
+        default:
+            _parent.mark_loop_exit();
+            break;
+    }
+}
 
 }  // namespace rain::lang::ast
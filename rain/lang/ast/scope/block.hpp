@@ -12,8 +12,24 @@
 namespace rain::lang::ast {
 
 class BlockScope : public Scope {
+  public:
+    enum class Kind {
+        Block,
+
+        /** The body of a loop. */
+        Loop,
+
+        /** The arguments of a function, which loops in the enclosing code do not extend into. */
+        Function,
+    };
+
+  private:
     Scope&       _parent;
     ModuleScope& _module;
+    Kind         _kind = Kind::Block;
+
+    /** Whether a `break` or `continue` leaves this loop body early. */
+    bool _exits_loop = false;
 
   public:
     explicit BlockScope(Scope& parent);
@@ -28,6 +44,13 @@ class BlockScope : public Scope {
     [[nodiscard]] absl::Nonnull<BuiltinScope*> builtin() const noexcept override {
         return _module.builtin();
     }
+    [[nodiscard]] bool in_loop() const noexcept override;
+    void               mark_loop_exit() noexcept override;
+
+    [[nodiscard]] constexpr Kind kind() const noexcept { return _kind; }
+    constexpr void               set_kind(const Kind kind) noexcept { _kind = kind; }
+
+    [[nodiscard]] constexpr bool exits_loop() const noexcept { return _exits_loop; }
 };
 
 }  // namespace rain::lang::ast
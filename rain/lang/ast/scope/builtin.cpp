@@ -1,8 +1,11 @@
 #include "rain/lang/ast/scope/builtin.hpp"
 
 #include <array>
+#include <span>
+#include <string_view>
 #include <vector>
 
+#include "llvm/IR/IntrinsicsWebAssembly.h"
 #include "rain/lang/ast/type/meta.hpp"
 #include "rain/lang/ast/type/opaque.hpp"
 #include "rain/lang/ast/type/struct.hpp"
@@ -14,28 +17,118 @@
 
 namespace rain::lang::ast {
 
+namespace {
+
+// clang-format off
+constexpr std::array<std::string_view, 4>  XYZW_LANE_NAMES    = {"x", "y", "z", "w"};
+constexpr std::array<std::string_view, 16> INDEXED_LANE_NAMES = {
+    "s0", "s1", "s2",  "s3",  "s4",  "s5",  "s6",  "s7",
+    "s8", "s9", "s10", "s11", "s12", "s13", "s14", "s15",
+};
+// clang-format on
+
+/**
+ * Turn a scalar shift amount into one for every lane of `vector_type`, wrapping it to the width of
+ * a lane (as wasm does), so that the shift lowers to a single instruction.
+ */
+llvm::Value* splat_shift_amount(llvm::IRBuilder<>& llvm_ir, llvm::Type* vector_type,
+                                llvm::Value* amount) {
+    auto*      llvm_vector_type = llvm::cast<llvm::FixedVectorType>(vector_type);
+    auto*      llvm_lane_type   = llvm_vector_type->getElementType();
+    const auto lane_bits        = llvm_lane_type->getIntegerBitWidth();
+
+    amount = llvm_ir.CreateAnd(amount, lane_bits - 1);
+    amount = llvm_ir.CreateZExtOrTrunc(amount, llvm_lane_type);
+    return llvm_ir.CreateVectorSplat(llvm_vector_type->getNumElements(), amount);
+}
+
+/** The low (or high) half of the lanes of `value`, each extended to twice its width. */
+llvm::Value* extend_half(llvm::IRBuilder<>& llvm_ir, llvm::Value* value, const bool high,
+                         const bool is_signed) {
+    auto*          llvm_vector_type = llvm::cast<llvm::FixedVectorType>(value->getType());
+    const unsigned half_count       = llvm_vector_type->getNumElements() / 2;
+
+    llvm::SmallVector<int, 8> mask;
+    for (unsigned i = 0; i < half_count; ++i) {
+        mask.push_back(static_cast<int>(high ? half_count + i : i));
+    }
+
+    auto* llvm_wide_type = llvm::FixedVectorType::get(
+        llvm_ir.getIntNTy(llvm_vector_type->getScalarSizeInBits() * 2), half_count);
+    auto* half = llvm_ir.CreateShuffleVector(value, mask);
+    return is_signed ? llvm_ir.CreateSExt(half, llvm_wide_type)
+                     : llvm_ir.CreateZExt(half, llvm_wide_type);
+}
+
+/**
+ * Saturate the lanes of `low` and `high` to half their width, and concatenate them (the lanes of
+ * `low` first).
+ */
+llvm::Value* narrow_saturate(llvm::IRBuilder<>& llvm_ir, llvm::Value* low, llvm::Value* high,
+                             const bool is_signed) {
+    auto*          llvm_vector_type = llvm::cast<llvm::FixedVectorType>(low->getType());
+    const unsigned count            = llvm_vector_type->getNumElements();
+    const unsigned narrow_bits      = llvm_vector_type->getScalarSizeInBits() / 2;
+
+    const auto min = is_signed ? llvm::APInt::getSignedMinValue(narrow_bits)
+                               : llvm::APInt::getMinValue(narrow_bits);
+    const auto max = is_signed ? llvm::APInt::getSignedMaxValue(narrow_bits)
+                               : llvm::APInt::getMaxValue(narrow_bits);
+    auto* llvm_min = llvm::ConstantInt::get(
+        llvm_vector_type, is_signed ? min.sext(narrow_bits * 2) : min.zext(narrow_bits * 2));
+    auto* llvm_max = llvm::ConstantInt::get(
+        llvm_vector_type, is_signed ? max.sext(narrow_bits * 2) : max.zext(narrow_bits * 2));
+    auto* llvm_narrow_type = llvm::FixedVectorType::get(llvm_ir.getIntNTy(narrow_bits), count);
+
+    const auto saturate = [&](llvm::Value* value) {
+        // The input lanes are signed either way; only the range that they saturate to differs.
+        value = llvm_ir.CreateBinaryIntrinsic(llvm::Intrinsic::smax, value, llvm_min);
+        value = llvm_ir.CreateBinaryIntrinsic(llvm::Intrinsic::smin, value, llvm_max);
+        return llvm_ir.CreateTrunc(value, llvm_narrow_type);
+    };
+
+    llvm::SmallVector<int, 16> mask;
+    for (unsigned i = 0; i < count * 2; ++i) {
+        mask.push_back(static_cast<int>(i));
+    }
+    return llvm_ir.CreateShuffleVector(saturate(low), saturate(high), mask);
+}
+
+/**
+ * Reduce the lanes of `value` to a single scalar, by repeatedly combining the high half of the
+ * remaining lanes into the low half (which takes log2(lanes) vector operations).
+ */
+template <typename CombineFn>
+llvm::Value* reduce_lanes(llvm::IRBuilder<>& llvm_ir, llvm::Value* value, CombineFn&& combine) {
+    const unsigned count = llvm::cast<llvm::FixedVectorType>(value->getType())->getNumElements();
+
+    llvm::SmallVector<int, 16> mask(count, -1);  // The upper lanes are left undefined.
+    for (unsigned half = count / 2; half > 0; half /= 2) {
+        for (unsigned i = 0; i < half; ++i) {
+            mask[i] = static_cast<int>(half + i);
+        }
+        value = combine(value, llvm_ir.CreateShuffleVector(value, mask));
+    }
+    return llvm_ir.CreateExtractElement(value, uint64_t{0});
+}
+
+}  // namespace
+
 BuiltinScope::BuiltinScope() {
     _bool_type = _add_builtin_type("bool", std::make_unique<OpaqueType>("bool"));
     _u8_type   = _add_builtin_type("u8", std::make_unique<OpaqueType>("u8"));
+    _i16_type  = _add_builtin_type("i16", std::make_unique<OpaqueType>("i16"));
     _i32_type  = _add_builtin_type("i32", std::make_unique<OpaqueType>("i32"));
     _i64_type  = _add_builtin_type("i64", std::make_unique<OpaqueType>("i64"));
     _f32_type  = _add_builtin_type("f32", std::make_unique<OpaqueType>("f32"));
     _f64_type  = _add_builtin_type("f64", std::make_unique<OpaqueType>("f64"));
-    _f32x4_type =
-        _add_builtin_type("f32x4", std::make_unique<StructType>(
-                                       "f32x4",
-                                       [_f32_type = this->_f32_type]() -> std::vector<StructField> {
-                                           // std::initializer_list of move-only types is not
-                                           // allowed (for some unknown reason).
-                                           std::vector<StructField> fields;
-                                           fields.reserve(4);
-                                           fields.emplace_back(StructField{"x", _f32_type});
-                                           fields.emplace_back(StructField{"y", _f32_type});
-                                           fields.emplace_back(StructField{"z", _f32_type});
-                                           fields.emplace_back(StructField{"w", _f32_type});
-                                           return fields;
-                                       }(),
-                                       lex::Location()));
+
+    _f32x4_type = _add_vector_type("f32x4", _f32_type, 4);
+    _f64x2_type = _add_vector_type("f64x2", _f64_type, 2);
+    _i16x8_type = _add_vector_type("i16x8", _i16_type, 8);
+    _i32x4_type = _add_vector_type("i32x4", _i32_type, 4);
+    _u32x4_type = _add_vector_type("u32x4", _i32_type, 4);
+    _u8x16_type = _add_vector_type("u8x16", _u8_type, 16);
 
     {
         // The no-return-value, no-argument function type has to be specially added to the builtin
@@ -69,7 +162,10 @@ absl::Nonnull<Variable*> BuiltinScope::add_variable(std::unique_ptr<Variable> va
 
 absl::Nonnull<FunctionVariable*> BuiltinScope::add_resolved_function(
     std::unique_ptr<FunctionVariable> function_variable) noexcept {
-    util::panic("the builtin scope is immutable and cannot have custom functions added to it");
+    // Once the scope has been created, only the methods of the types derived from builtin types
+    // (such as `[]i32`) are added to it, as they belong to the scope that owns the underlying type.
+    const auto lock = lock_shared_state();
+    return Scope::add_resolved_function(std::move(function_variable));
 }
 
 void BuiltinScope::declare_external_function(std::unique_ptr<ExternalFunctionVariable> variable) {
@@ -79,9 +175,29 @@ void BuiltinScope::declare_external_function(std::unique_ptr<ExternalFunctionVar
     _external_functions.emplace_back(std::move(variable));
 }
 
+absl::Nonnull<Type*> BuiltinScope::_add_vector_type(const std::string_view name,
+                                                     absl::Nonnull<Type*>   lane_type,
+                                                     const size_t           lane_count) noexcept {
+    assert(lane_count <= INDEXED_LANE_NAMES.size());
+    const auto lane_names = lane_count <= XYZW_LANE_NAMES.size()
+                                ? std::span<const std::string_view>(XYZW_LANE_NAMES)
+                                : std::span<const std::string_view>(INDEXED_LANE_NAMES);
+
+    // std::initializer_list of move-only types is not allowed (for some unknown reason).
+    std::vector<StructField> fields;
+    fields.reserve(lane_count);
+    for (size_t i = 0; i < lane_count; ++i) {
+        fields.emplace_back(StructField{lane_names[i], lane_type});
+    }
+
+    return _add_builtin_type(name,
+                             std::make_unique<StructType>(name, std::move(fields), lex::Location()));
+}
+
 absl::Nonnull<Type*> BuiltinScope::_add_builtin_type(const std::string_view name,
                                                      std::unique_ptr<Type>  type) noexcept {
     auto* const type_ptr = type.get();
+    type_ptr->set_owner_scope(this);
     _named_types.emplace(name, type_ptr);
     _owned_types.insert(std::move(type));
 
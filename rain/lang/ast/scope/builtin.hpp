@@ -2,6 +2,7 @@
 
 #include <cstdlib>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -18,14 +19,26 @@ class BuiltinScope : public Scope {
     // looked up by name for every literal).
     absl::Nonnull<Type*> _bool_type;
     absl::Nonnull<Type*> _u8_type;
+    absl::Nonnull<Type*> _i16_type;
     absl::Nonnull<Type*> _i32_type;
     absl::Nonnull<Type*> _i64_type;
     absl::Nonnull<Type*> _f32_type;
     absl::Nonnull<Type*> _f64_type;
+
+    // SIMD types, which are structs with a field for each lane. The u32x4 lanes are read as i32, as
+    // there is no scalar u32 type.
     absl::Nonnull<Type*> _f32x4_type;
+    absl::Nonnull<Type*> _f64x2_type;
+    absl::Nonnull<Type*> _i16x8_type;
+    absl::Nonnull<Type*> _i32x4_type;
+    absl::Nonnull<Type*> _u32x4_type;
+    absl::Nonnull<Type*> _u8x16_type;
 
     std::vector<std::unique_ptr<ExternalFunctionVariable>> _external_functions;
 
+    /** Guards the state that is shared between modules, see `lock_shared_state()`. */
+    mutable std::recursive_mutex _shared_state_mutex;
+
   public:
     BuiltinScope();
     ~BuiltinScope() override = default;
@@ -42,16 +55,32 @@ class BuiltinScope : public Scope {
 
     [[nodiscard]] absl::Nonnull<Type*> bool_type() const noexcept { return _bool_type; }
     [[nodiscard]] absl::Nonnull<Type*> u8_type() const noexcept { return _u8_type; }
+    [[nodiscard]] absl::Nonnull<Type*> i16_type() const noexcept { return _i16_type; }
     [[nodiscard]] absl::Nonnull<Type*> i32_type() const noexcept { return _i32_type; }
     [[nodiscard]] absl::Nonnull<Type*> i64_type() const noexcept { return _i64_type; }
     [[nodiscard]] absl::Nonnull<Type*> f32_type() const noexcept { return _f32_type; }
     [[nodiscard]] absl::Nonnull<Type*> f64_type() const noexcept { return _f64_type; }
     [[nodiscard]] absl::Nonnull<Type*> f32x4_type() const noexcept { return _f32x4_type; }
+    [[nodiscard]] absl::Nonnull<Type*> f64x2_type() const noexcept { return _f64x2_type; }
+    [[nodiscard]] absl::Nonnull<Type*> i16x8_type() const noexcept { return _i16x8_type; }
+    [[nodiscard]] absl::Nonnull<Type*> i32x4_type() const noexcept { return _i32x4_type; }
+    [[nodiscard]] absl::Nonnull<Type*> u32x4_type() const noexcept { return _u32x4_type; }
+    [[nodiscard]] absl::Nonnull<Type*> u8x16_type() const noexcept { return _u8x16_type; }
     [[nodiscard]] const std::vector<std::unique_ptr<ExternalFunctionVariable>>& external_functions()
         const noexcept {
         return _external_functions;
     }
 
+    /**
+     * Lock the state that every module using this scope shares: the function types and methods
+     * added to this scope, the types derived from (and cached on) other types, and the methods
+     * added to the modules that own those types. Holding it while parsing or validating touches
+     * any of these lets modules that do not import each other be handled on different threads.
+     */
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> lock_shared_state() const {
+        return std::unique_lock(_shared_state_mutex);
+    }
+
     ////////////////////////////////////////////////////////////////
     // Add AST nodes
 
@@ -71,6 +100,11 @@ class BuiltinScope : public Scope {
   private:
     absl::Nonnull<Type*> _add_builtin_type(const std::string_view name,
                                            std::unique_ptr<Type>  type) noexcept;
+
+    /** Add a SIMD type with `lane_count` lanes (at most 16), named x, y, z, w or s0, s1, ... */
+    absl::Nonnull<Type*> _add_vector_type(const std::string_view name,
+                                          absl::Nonnull<Type*>   lane_type,
+                                          size_t                 lane_count) noexcept;
 };
 
 }  // namespace rain::lang::ast
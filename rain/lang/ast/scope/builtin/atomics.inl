@@ -0,0 +1,105 @@
+{  // Atomic operations on i32 and i64, for memory that is shared between threads.
+    //
+    // These all take the value by reference, so they work on mutable variables (most usefully
+    // globals) and struct members, and are sequentially consistent.
+    //
+    // `atomic_wait` blocks until the value is notified, if it still equals `expected`, for at most
+    // `timeout` nanoseconds (forever if negative); it returns 0 once notified, 1 if the value did
+    // not equal `expected`, or 2 if it timed out. `atomic_notify` wakes up to `count` waiters, and
+    // returns how many it woke. Unless the memory is shared, nothing else can be running (and wasm
+    // traps when waiting on unshared memory), so waiting only compares the value (timing out
+    // immediately if it is equal) and notifying wakes nobody.
+
+#define ADD_ATOMIC_RMW_METHOD(name, op)                                                          \
+    ADD_BUILTIN_METHOD(name, type, rmw_type, rmw_args, {                                         \
+        return ctx.llvm_builder().CreateAtomicRMW(llvm::AtomicRMWInst::op, arguments[0],         \
+                                                  arguments[1], llvm::MaybeAlign(),              \
+                                                  llvm::AtomicOrdering::SequentiallyConsistent); \
+    })
+
+#define ADD_ATOMIC_METHODS(bits)                                                            \
+    do {                                                                                    \
+        auto* ref_type = &type->get_reference_type(*this);                                  \
+                                                                                            \
+        auto  load_args = Scope::TypeList{ref_type};                                        \
+        auto* load_type = get_resolved_function_type(type, load_args, type);                \
+        ADD_BUILTIN_METHOD("atomic_load", type, load_type, load_args, {                     \
+            auto& llvm_ir   = ctx.llvm_builder();                                           \
+            auto* llvm_load = llvm_ir.CreateLoad(llvm_ir.getInt##bits##Ty(), arguments[0]); \
+            llvm_load->setAtomic(llvm::AtomicOrdering::SequentiallyConsistent);             \
+            return llvm_load;                                                               \
+        });                                                                                 \
+                                                                                            \
+        auto  store_args = Scope::TypeList{ref_type, type};                                 \
+        auto* store_type = get_resolved_function_type(type, store_args, nullptr);           \
+        ADD_BUILTIN_METHOD("atomic_store", type, store_type, store_args, {                  \
+            auto* llvm_store = ctx.llvm_builder().CreateStore(arguments[1], arguments[0]);  \
+            llvm_store->setAtomic(llvm::AtomicOrdering::SequentiallyConsistent);            \
+            return llvm_store;                                                              \
+        });                                                                                 \
+                                                                                            \
+        /* These all return the value from before the operation. */                         \
+        auto  rmw_args = Scope::TypeList{ref_type, type};                                   \
+        auto* rmw_type = get_resolved_function_type(type, rmw_args, type);                  \
+        ADD_ATOMIC_RMW_METHOD("atomic_add", Add);                                           \
+        ADD_ATOMIC_RMW_METHOD("atomic_sub", Sub);                                           \
+        ADD_ATOMIC_RMW_METHOD("atomic_and", And);                                           \
+        ADD_ATOMIC_RMW_METHOD("atomic_or", Or);                                             \
+        ADD_ATOMIC_RMW_METHOD("atomic_xor", Xor);                                           \
+        ADD_ATOMIC_RMW_METHOD("atomic_exchange", Xchg);                                     \
+                                                                                            \
+        /* Returns the value from before the operation; it was replaced if that equals */   \
+        /* `expected`. */                                                                   \
+        auto  cmpxchg_args = Scope::TypeList{ref_type, type, type};                         \
+        auto* cmpxchg_type = get_resolved_function_type(type, cmpxchg_args, type);          \
+        ADD_BUILTIN_METHOD("atomic_compare_exchange", type, cmpxchg_type, cmpxchg_args, {   \
+            auto& llvm_ir = ctx.llvm_builder();                                             \
+            auto* llvm_cmpxchg =                                                            \
+                llvm_ir.CreateAtomicCmpXchg(arguments[0], arguments[1], arguments[2],       \
+                                            llvm::MaybeAlign(),                             \
+                                            llvm::AtomicOrdering::SequentiallyConsistent,   \
+                                            llvm::AtomicOrdering::SequentiallyConsistent);  \
+            return llvm_ir.CreateExtractValue(llvm_cmpxchg, 0);                             \
+        });                                                                                 \
+                                                                                            \
+        auto  wait_args = Scope::TypeList{ref_type, type, _i64_type};                       \
+        auto* wait_type = get_resolved_function_type(type, wait_args, _i32_type);           \
+        ADD_BUILTIN_METHOD("atomic_wait", type, wait_type, wait_args, {                     \
+            auto& llvm_ir = ctx.llvm_builder();                                             \
+            if (ctx.options().shared_memory()) {                                            \
+                return static_cast<llvm::Value*>(llvm_ir.CreateIntrinsic(                   \
+                    llvm::Intrinsic::wasm_memory_atomic_wait##bits, {},                     \
+                    {arguments[0], arguments[1], arguments[2]}));                           \
+            }                                                                               \
+            auto* llvm_load = llvm_ir.CreateLoad(llvm_ir.getInt##bits##Ty(), arguments[0]); \
+            llvm_load->setAtomic(llvm::AtomicOrdering::SequentiallyConsistent);             \
+            return llvm_ir.CreateSelect(llvm_ir.CreateICmpNE(llvm_load, arguments[1]),      \
+                                        llvm_ir.getInt32(1), llvm_ir.getInt32(2));          \
+        });                                                                                 \
+                                                                                            \
+        auto  notify_args = Scope::TypeList{ref_type, _i32_type};                           \
+        auto* notify_type = get_resolved_function_type(type, notify_args, _i32_type);       \
+        ADD_BUILTIN_METHOD("atomic_notify", type, notify_type, notify_args, {               \
+            auto& llvm_ir = ctx.llvm_builder();                                             \
+            if (ctx.options().shared_memory()) {                                            \
+                return static_cast<llvm::Value*>(                                           \
+                    llvm_ir.CreateIntrinsic(llvm::Intrinsic::wasm_memory_atomic_notify, {}, \
+                                            {arguments[0], arguments[1]}));                 \
+            }                                                                               \
+            return static_cast<llvm::Value*>(llvm_ir.getInt32(0));                          \
+        });                                                                                 \
+    } while (0)
+
+    {
+        auto type = _i32_type;
+        ADD_ATOMIC_METHODS(32);
+    }
+
+    {
+        auto type = _i64_type;
+        ADD_ATOMIC_METHODS(64);
+    }
+
+#undef ADD_ATOMIC_METHODS
+#undef ADD_ATOMIC_RMW_METHOD
+}
@@ -1,16 +1,46 @@
 {
-    auto type = _f32x4_type;
+    auto               type       = _f32x4_type;
+    auto               lane_type  = _f32_type;
+    constexpr unsigned lane_count = 4;
+#include "rain/lang/ast/scope/builtin/float_vector_ops.inl"
 
     auto  binop_args = Scope::TypeList{type, type};
     auto* math_type  = get_resolved_function_type(type, binop_args, type);
-    ADD_BUILTIN_METHOD(OperatorNames::Add, type, math_type, binop_args,
-                       { return ctx.llvm_builder().CreateFAdd(arguments[0], arguments[1]); });
-    ADD_BUILTIN_METHOD(OperatorNames::Subtract, type, math_type, binop_args,
-                       { return ctx.llvm_builder().CreateFSub(arguments[0], arguments[1]); });
-    ADD_BUILTIN_METHOD(OperatorNames::Multiply, type, math_type, binop_args,
-                       { return ctx.llvm_builder().CreateFMul(arguments[0], arguments[1]); });
-    ADD_BUILTIN_METHOD(OperatorNames::Divide, type, math_type, binop_args,
-                       { return ctx.llvm_builder().CreateFDiv(arguments[0], arguments[1]); });
     ADD_BUILTIN_METHOD(OperatorNames::Remainder, type, math_type, binop_args,
                        { return ctx.llvm_builder().CreateFRem(arguments[0], arguments[1]); });
+
+    {
+        auto  cast_args = Scope::TypeList{_i32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir = ctx.llvm_builder();
+            return llvm_ir.CreateSIToFP(arguments[0],
+                                        llvm::FixedVectorType::get(llvm_ir.getFloatTy(), 4));
+        });
+    }
+
+    {
+        auto  cast_args = Scope::TypeList{_u32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir = ctx.llvm_builder();
+            return llvm_ir.CreateUIToFP(arguments[0],
+                                        llvm::FixedVectorType::get(llvm_ir.getFloatTy(), 4));
+        });
+    }
+
+    {
+        // Both lanes are demoted into x and y, and z and w are zero.
+        auto  cast_args = Scope::TypeList{_f64x2_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir        = ctx.llvm_builder();
+            auto* llvm_half_type = llvm::FixedVectorType::get(llvm_ir.getFloatTy(), 2);
+
+            const std::array<int, 4> shuffle_mask{0, 1, 2, 3};
+            return llvm_ir.CreateShuffleVector(
+                llvm_ir.CreateFPTrunc(arguments[0], llvm_half_type),
+                llvm::Constant::getNullValue(llvm_half_type), shuffle_mask);
+        });
+    }
 }
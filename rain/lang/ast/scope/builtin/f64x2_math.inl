@@ -0,0 +1,30 @@
+{
+    auto               type       = _f64x2_type;
+    auto               lane_type  = _f64_type;
+    constexpr unsigned lane_count = 2;
+#include "rain/lang/ast/scope/builtin/float_vector_ops.inl"
+
+    {
+        // Only x and y are promoted.
+        auto  cast_args = Scope::TypeList{_f32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto&                    llvm_ir = ctx.llvm_builder();
+            const std::array<int, 2> shuffle_mask{0, 1};
+            return llvm_ir.CreateFPExt(llvm_ir.CreateShuffleVector(arguments[0], shuffle_mask),
+                                       llvm::FixedVectorType::get(llvm_ir.getDoubleTy(), 2));
+        });
+    }
+
+    {
+        // Only x and y are converted.
+        auto  cast_args = Scope::TypeList{_i32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto&                    llvm_ir = ctx.llvm_builder();
+            const std::array<int, 2> shuffle_mask{0, 1};
+            return llvm_ir.CreateSIToFP(llvm_ir.CreateShuffleVector(arguments[0], shuffle_mask),
+                                        llvm::FixedVectorType::get(llvm_ir.getDoubleTy(), 2));
+        });
+    }
+}
@@ -0,0 +1,125 @@
+// The operators shared by the floating-point SIMD types. This is included in the middle of the
+// block for each of them, which has to define:
+//   type       - the SIMD type
+//   lane_type  - the type of each lane
+//   lane_count - (constexpr) the number of lanes
+//
+// Comparisons return a mask of the same type, with every bit of a lane set where the comparison
+// holds (and clear where either lane is NaN, except for `!=`), which `select` uses to pick between
+// two values. Most of the other math methods map onto one of LLVM's vector intrinsics.
+
+{
+    auto  unop_args = Scope::TypeList{type};
+    auto* unop_type = get_resolved_function_type(type, unop_args, type);
+    ADD_BUILTIN_METHOD(OperatorNames::Negative, type, unop_type, unop_args,
+                       { return ctx.llvm_builder().CreateFNeg(arguments[0]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Positive, type, unop_type, unop_args,
+                       { return arguments[0]; });
+
+    auto  binop_args = Scope::TypeList{type, type};
+    auto* math_type  = get_resolved_function_type(type, binop_args, type);
+    ADD_BUILTIN_METHOD(OperatorNames::Add, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateFAdd(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Subtract, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateFSub(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Multiply, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateFMul(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Divide, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateFDiv(arguments[0], arguments[1]); });
+
+#define ADD_MASK_COMPARISON(name, predicate)                                           \
+    ADD_BUILTIN_METHOD(name, type, math_type, binop_args, {                            \
+        auto& llvm_ir   = ctx.llvm_builder();                                          \
+        auto* llvm_type = arguments[0]->getType();                                     \
+        auto* llvm_mask = llvm_ir.CreateSExt(                                          \
+            llvm_ir.CreateFCmp(llvm::CmpInst::predicate, arguments[0], arguments[1]),  \
+            llvm::VectorType::getInteger(llvm::cast<llvm::VectorType>(llvm_type)));    \
+        return llvm_ir.CreateBitCast(llvm_mask, llvm_type);                            \
+    })
+    ADD_MASK_COMPARISON(OperatorNames::Equal, FCMP_OEQ);
+    ADD_MASK_COMPARISON(OperatorNames::NotEqual, FCMP_UNE);
+    ADD_MASK_COMPARISON(OperatorNames::Less, FCMP_OLT);
+    ADD_MASK_COMPARISON(OperatorNames::LessEqual, FCMP_OLE);
+    ADD_MASK_COMPARISON(OperatorNames::Greater, FCMP_OGT);
+    ADD_MASK_COMPARISON(OperatorNames::GreaterEqual, FCMP_OGE);
+#undef ADD_MASK_COMPARISON
+
+    // Pick each lane from `if_true` where the mask (`self`) is set, and from `if_false` otherwise.
+    auto  select_args = Scope::TypeList{type, type, type};
+    auto* select_type = get_resolved_function_type(type, select_args, type);
+    ADD_BUILTIN_METHOD("select", type, select_type, select_args, {
+        auto& llvm_ir   = ctx.llvm_builder();
+        auto* llvm_type = arguments[0]->getType();
+        auto* llvm_bits_type =
+            llvm::VectorType::getInteger(llvm::cast<llvm::VectorType>(llvm_type));
+        auto* mask           = llvm_ir.CreateBitCast(arguments[0], llvm_bits_type);
+        auto* if_true        = llvm_ir.CreateBitCast(arguments[1], llvm_bits_type);
+        auto* if_false       = llvm_ir.CreateBitCast(arguments[2], llvm_bits_type);
+        return llvm_ir.CreateBitCast(
+            llvm_ir.CreateOr(llvm_ir.CreateAnd(if_true, mask),
+                             llvm_ir.CreateAnd(if_false, llvm_ir.CreateNot(mask))),
+            llvm_type);
+    });
+
+    auto  splat_args = Scope::TypeList{lane_type};
+    auto* splat_type = get_resolved_function_type(type, splat_args, type);
+    ADD_BUILTIN_METHOD("splat", type, splat_type, splat_args,
+                       { return ctx.llvm_builder().CreateVectorSplat(lane_count, arguments[0]); });
+
+#define ADD_UNARY_INTRINSIC(name, intrinsic)                                       \
+    ADD_BUILTIN_METHOD(name, type, unop_type, unop_args, {                         \
+        return ctx.llvm_builder().CreateUnaryIntrinsic(llvm::Intrinsic::intrinsic, \
+                                                       arguments[0]);              \
+    })
+    ADD_UNARY_INTRINSIC("abs", fabs);
+    ADD_UNARY_INTRINSIC("sqrt", sqrt);
+    ADD_UNARY_INTRINSIC("floor", floor);
+    ADD_UNARY_INTRINSIC("ceil", ceil);
+    ADD_UNARY_INTRINSIC("trunc", trunc);
+    ADD_UNARY_INTRINSIC("nearest", nearbyint);  // Rounds halfway values to even.
+#undef ADD_UNARY_INTRINSIC
+
+    // These return NaN if either lane is NaN, as the wasm instructions do.
+    ADD_BUILTIN_METHOD("min", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateMinimum(arguments[0], arguments[1]);
+    });
+    ADD_BUILTIN_METHOD("max", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateMaximum(arguments[0], arguments[1]);
+    });
+
+    // `a.fma(b, c)` is `a * b + c`, fused only where the target has an instruction for it (a fused
+    // multiply-add would otherwise be a call to a libm function for every lane).
+    auto  fma_args = Scope::TypeList{type, type, type};
+    auto* fma_type = get_resolved_function_type(type, fma_args, type);
+    ADD_BUILTIN_METHOD("fma", type, fma_type, fma_args, {
+        return static_cast<llvm::Value*>(ctx.llvm_builder().CreateIntrinsic(
+            llvm::Intrinsic::fmuladd, {arguments[0]->getType()},
+            {arguments[0], arguments[1], arguments[2]}));
+    });
+
+    // Horizontal reductions, which combine the high half of the lanes into the low half until
+    // there is only one lane left.
+    auto* reduce_type = get_resolved_function_type(type, unop_args, lane_type);
+    ADD_BUILTIN_METHOD("sum", type, reduce_type, unop_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return reduce_lanes(llvm_ir, arguments[0],
+                            [&](auto* lhs, auto* rhs) { return llvm_ir.CreateFAdd(lhs, rhs); });
+    });
+    ADD_BUILTIN_METHOD("min_lane", type, reduce_type, unop_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return reduce_lanes(llvm_ir, arguments[0],
+                            [&](auto* lhs, auto* rhs) { return llvm_ir.CreateMinimum(lhs, rhs); });
+    });
+    ADD_BUILTIN_METHOD("max_lane", type, reduce_type, unop_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return reduce_lanes(llvm_ir, arguments[0],
+                            [&](auto* lhs, auto* rhs) { return llvm_ir.CreateMaximum(lhs, rhs); });
+    });
+
+    auto* dot_type = get_resolved_function_type(type, binop_args, lane_type);
+    ADD_BUILTIN_METHOD("dot", type, dot_type, binop_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return reduce_lanes(llvm_ir, llvm_ir.CreateFMul(arguments[0], arguments[1]),
+                            [&](auto* lhs, auto* rhs) { return llvm_ir.CreateFAdd(lhs, rhs); });
+    });
+}
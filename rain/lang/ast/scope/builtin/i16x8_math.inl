@@ -0,0 +1,27 @@
+{  // i16x8
+    auto               type       = _i16x8_type;
+    auto               lane_type  = _i16_type;
+    constexpr bool     is_signed  = true;
+    constexpr unsigned lane_count = 8;
+#include "rain/lang/ast/scope/builtin/int_vector_ops.inl"
+
+    {
+        auto  extend_args = Scope::TypeList{type};
+        auto* extend_type = get_resolved_function_type(type, extend_args, _i32x4_type);
+        ADD_BUILTIN_METHOD("extend_low", type, extend_type, extend_args, {
+            return extend_half(ctx.llvm_builder(), arguments[0], false, true);
+        });
+        ADD_BUILTIN_METHOD("extend_high", type, extend_type, extend_args, {
+            return extend_half(ctx.llvm_builder(), arguments[0], true, true);
+        });
+    }
+
+    {
+        // Both sets of lanes are saturated to 0..255, and concatenated (`self` first).
+        auto  narrow_args = Scope::TypeList{type, type};
+        auto* narrow_type = get_resolved_function_type(type, narrow_args, _u8x16_type);
+        ADD_BUILTIN_METHOD("narrow", type, narrow_type, narrow_args, {
+            return narrow_saturate(ctx.llvm_builder(), arguments[0], arguments[1], false);
+        });
+    }
+}
@@ -53,6 +53,24 @@
         });
     }
 
+    {
+        auto  cast_args = Scope::TypeList{_i16_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir = ctx.llvm_builder();
+            return llvm_ir.CreateSExt(arguments[0], llvm_ir.getInt32Ty());
+        });
+    }
+
+    {
+        auto  cast_args = Scope::TypeList{_u8_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir = ctx.llvm_builder();
+            return llvm_ir.CreateZExt(arguments[0], llvm_ir.getInt32Ty());
+        });
+    }
+
     {
         auto  cast_args = Scope::TypeList{_f32_type};
         auto* cast_type = get_resolved_function_type(type, cast_args, type);
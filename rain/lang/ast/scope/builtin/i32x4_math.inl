@@ -0,0 +1,36 @@
+{  // i32x4
+    auto               type       = _i32x4_type;
+    auto               lane_type  = _i32_type;
+    constexpr bool     is_signed  = true;
+    constexpr unsigned lane_count = 4;
+#include "rain/lang/ast/scope/builtin/int_vector_ops.inl"
+
+    {
+        // Lanes that are out of range saturate, and NaN lanes become 0.
+        auto  cast_args = Scope::TypeList{_f32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir   = ctx.llvm_builder();
+            auto* llvm_type = llvm::FixedVectorType::get(llvm_ir.getInt32Ty(), 4);
+            return static_cast<llvm::Value*>(llvm_ir.CreateIntrinsic(
+                llvm::Intrinsic::fptosi_sat, {llvm_type, arguments[0]->getType()},
+                {arguments[0]}));
+        });
+    }
+
+    {
+        auto  cast_args = Scope::TypeList{_u32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args,
+                           { return arguments[0]; });
+    }
+
+    {
+        // Both sets of lanes are saturated to 16 bits, and concatenated (`self` first).
+        auto  narrow_args = Scope::TypeList{type, type};
+        auto* narrow_type = get_resolved_function_type(type, narrow_args, _i16x8_type);
+        ADD_BUILTIN_METHOD("narrow", type, narrow_type, narrow_args, {
+            return narrow_saturate(ctx.llvm_builder(), arguments[0], arguments[1], true);
+        });
+    }
+}
@@ -0,0 +1,109 @@
+// The operators shared by the integer SIMD types. This is included in the middle of the block for
+// each of them, which has to define:
+//   type       - the SIMD type
+//   lane_type  - the type of each lane
+//   is_signed  - (constexpr) whether the lanes are signed
+//   lane_count - (constexpr) the number of lanes
+//
+// Comparisons return a mask of the same type, with every bit of a lane set where the comparison
+// holds, which `select` uses to pick between two values. There is no division, as wasm has no
+// integer SIMD division instruction.
+
+{
+    auto  unop_args = Scope::TypeList{type};
+    auto* unop_type = get_resolved_function_type(type, unop_args, type);
+    ADD_BUILTIN_METHOD(OperatorNames::Negative, type, unop_type, unop_args,
+                       { return ctx.llvm_builder().CreateNeg(arguments[0]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Positive, type, unop_type, unop_args,
+                       { return arguments[0]; });
+    ADD_BUILTIN_METHOD(OperatorNames::Not, type, unop_type, unop_args,
+                       { return ctx.llvm_builder().CreateNot(arguments[0]); });
+    if (is_signed) {
+        ADD_BUILTIN_METHOD("abs", type, unop_type, unop_args, {
+            auto& llvm_ir = ctx.llvm_builder();
+            return llvm_ir.CreateBinaryIntrinsic(llvm::Intrinsic::abs, arguments[0],
+                                                 llvm_ir.getFalse());
+        });
+    }
+
+    auto  binop_args = Scope::TypeList{type, type};
+    auto* math_type  = get_resolved_function_type(type, binop_args, type);
+    ADD_BUILTIN_METHOD(OperatorNames::Add, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateAdd(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Subtract, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateSub(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Multiply, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateMul(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::And, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateAnd(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Or, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateOr(arguments[0], arguments[1]); });
+    ADD_BUILTIN_METHOD(OperatorNames::Xor, type, math_type, binop_args,
+                       { return ctx.llvm_builder().CreateXor(arguments[0], arguments[1]); });
+
+    ADD_BUILTIN_METHOD("add_sat", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateBinaryIntrinsic(
+            is_signed ? llvm::Intrinsic::sadd_sat : llvm::Intrinsic::uadd_sat, arguments[0],
+            arguments[1]);
+    });
+    ADD_BUILTIN_METHOD("sub_sat", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateBinaryIntrinsic(
+            is_signed ? llvm::Intrinsic::ssub_sat : llvm::Intrinsic::usub_sat, arguments[0],
+            arguments[1]);
+    });
+    ADD_BUILTIN_METHOD("min", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateBinaryIntrinsic(
+            is_signed ? llvm::Intrinsic::smin : llvm::Intrinsic::umin, arguments[0], arguments[1]);
+    });
+    ADD_BUILTIN_METHOD("max", type, math_type, binop_args, {
+        return ctx.llvm_builder().CreateBinaryIntrinsic(
+            is_signed ? llvm::Intrinsic::smax : llvm::Intrinsic::umax, arguments[0], arguments[1]);
+    });
+
+    // Every lane is shifted by the same amount, modulo the lane's width (as wasm does).
+    auto  shift_args = Scope::TypeList{type, _i32_type};
+    auto* shift_type = get_resolved_function_type(type, shift_args, type);
+    ADD_BUILTIN_METHOD(OperatorNames::ShiftLeft, type, shift_type, shift_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return llvm_ir.CreateShl(arguments[0], splat_shift_amount(llvm_ir, arguments[0]->getType(),
+                                                                  arguments[1]));
+    });
+    ADD_BUILTIN_METHOD(OperatorNames::ShiftRight, type, shift_type, shift_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        auto* amount  = splat_shift_amount(llvm_ir, arguments[0]->getType(), arguments[1]);
+        return is_signed ? llvm_ir.CreateAShr(arguments[0], amount)
+                         : llvm_ir.CreateLShr(arguments[0], amount);
+    });
+
+#define ADD_MASK_COMPARISON(name, signed_predicate, unsigned_predicate)                         \
+    ADD_BUILTIN_METHOD(name, type, math_type, binop_args, {                                     \
+        auto& llvm_ir = ctx.llvm_builder();                                                     \
+        return llvm_ir.CreateSExt(                                                              \
+            llvm_ir.CreateICmp(is_signed ? llvm::CmpInst::signed_predicate                      \
+                                         : llvm::CmpInst::unsigned_predicate,                   \
+                               arguments[0], arguments[1]),                                     \
+            arguments[0]->getType());                                                           \
+    })
+    ADD_MASK_COMPARISON(OperatorNames::Equal, ICMP_EQ, ICMP_EQ);
+    ADD_MASK_COMPARISON(OperatorNames::NotEqual, ICMP_NE, ICMP_NE);
+    ADD_MASK_COMPARISON(OperatorNames::Less, ICMP_SLT, ICMP_ULT);
+    ADD_MASK_COMPARISON(OperatorNames::LessEqual, ICMP_SLE, ICMP_ULE);
+    ADD_MASK_COMPARISON(OperatorNames::Greater, ICMP_SGT, ICMP_UGT);
+    ADD_MASK_COMPARISON(OperatorNames::GreaterEqual, ICMP_SGE, ICMP_UGE);
+#undef ADD_MASK_COMPARISON
+
+    // Pick each lane from `if_true` where the mask (`self`) is set, and from `if_false` otherwise.
+    auto  select_args = Scope::TypeList{type, type, type};
+    auto* select_type = get_resolved_function_type(type, select_args, type);
+    ADD_BUILTIN_METHOD("select", type, select_type, select_args, {
+        auto& llvm_ir = ctx.llvm_builder();
+        return llvm_ir.CreateOr(
+            llvm_ir.CreateAnd(arguments[1], arguments[0]),
+            llvm_ir.CreateAnd(arguments[2], llvm_ir.CreateNot(arguments[0])));
+    });
+
+    auto  splat_args = Scope::TypeList{lane_type};
+    auto* splat_type = get_resolved_function_type(type, splat_args, type);
+    ADD_BUILTIN_METHOD("splat", type, splat_type, splat_args,
+                       { return ctx.llvm_builder().CreateVectorSplat(lane_count, arguments[0]); });
+}
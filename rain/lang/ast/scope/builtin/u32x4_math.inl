@@ -0,0 +1,27 @@
+{  // u32x4
+    auto               type       = _u32x4_type;
+    auto               lane_type  = _i32_type;
+    constexpr bool     is_signed  = false;
+    constexpr unsigned lane_count = 4;
+#include "rain/lang/ast/scope/builtin/int_vector_ops.inl"
+
+    {
+        // Lanes that are out of range saturate, and NaN lanes become 0.
+        auto  cast_args = Scope::TypeList{_f32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args, {
+            auto& llvm_ir   = ctx.llvm_builder();
+            auto* llvm_type = llvm::FixedVectorType::get(llvm_ir.getInt32Ty(), 4);
+            return static_cast<llvm::Value*>(llvm_ir.CreateIntrinsic(
+                llvm::Intrinsic::fptoui_sat, {llvm_type, arguments[0]->getType()},
+                {arguments[0]}));
+        });
+    }
+
+    {
+        auto  cast_args = Scope::TypeList{_i32x4_type};
+        auto* cast_type = get_resolved_function_type(type, cast_args, type);
+        ADD_BUILTIN_METHOD(OperatorNames::CastFrom, type, cast_type, cast_args,
+                           { return arguments[0]; });
+    }
+}
@@ -0,0 +1,18 @@
+{  // u8x16
+    auto               type       = _u8x16_type;
+    auto               lane_type  = _u8_type;
+    constexpr bool     is_signed  = false;
+    constexpr unsigned lane_count = 16;
+#include "rain/lang/ast/scope/builtin/int_vector_ops.inl"
+
+    {
+        auto  extend_args = Scope::TypeList{type};
+        auto* extend_type = get_resolved_function_type(type, extend_args, _i16x8_type);
+        ADD_BUILTIN_METHOD("extend_low", type, extend_type, extend_args, {
+            return extend_half(ctx.llvm_builder(), arguments[0], false, false);
+        });
+        ADD_BUILTIN_METHOD("extend_high", type, extend_type, extend_args, {
+            return extend_half(ctx.llvm_builder(), arguments[0], true, false);
+        });
+    }
+}
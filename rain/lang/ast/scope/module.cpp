@@ -1,3 +1,55 @@
 #include "rain/lang/ast/scope/module.hpp"
 
-namespace rain::lang::ast {}  // namespace rain::lang::ast
+#include "absl/strings/str_cat.h"
+#include "rain/lang/err/syntax.hpp"
+
+namespace rain::lang::ast {
+
+util::Result<void> ModuleScope::import_name(const ModuleScope& from, const std::string_view name,
+                                            lex::Location location) {
+    // Other modules may be adding the methods of derived types to `from` at the same time.
+    const auto lock = _builtin.lock_shared_state();
+
+    bool found = false;
+
+    if (const auto it = from._named_types.find(name); it != from._named_types.end()) {
+        auto* type = it->second;
+        _named_types.insert_or_assign(name, type);
+
+        // Bring along all of the methods of the type, so that they can be called on values of the
+        // imported type.
+        for (const auto& [key, function] : from._function_variables) {
+            if (std::get<1>(key) == type) {
+                _function_variables.insert_or_assign(key, function);
+            }
+        }
+        found = true;
+    }
+
+    for (const auto& [key, function] : from._function_variables) {
+        if (std::get<0>(key) == name && std::get<1>(key) == nullptr) {
+            if (const auto [it, inserted] = _function_variables.try_emplace(key, function);
+                !inserted && it->second != function) {
+                return ERR_PTR(err::SyntaxError, location,
+                               absl::StrCat("imported function '", name,
+                                            "' conflicts with an existing function"));
+            }
+            found = true;
+        }
+    }
+
+    if (const auto it = from._named_variables.find(name); it != from._named_variables.end()) {
+        _named_variables.insert_or_assign(name, it->second);
+        found = true;
+    }
+
+    if (!found) {
+        return ERR_PTR(err::SyntaxError, location,
+                       absl::StrCat("no type, function, or variable named '", name,
+                                    "' found in the imported module"));
+    }
+
+    return {};
+}
+
+}  // namespace rain::lang::ast
@@ -16,7 +16,7 @@ namespace rain::lang::ast {
  * in a single source file.
  *
  * This scope is the parent of all other scopes in the module. It depends only on the single shared
- * immutable BuiltinScope that contains all builtin language features.
+ * BuiltinScope that contains all builtin language features.
  */
 class ModuleScope : public Scope {
     BuiltinScope& _builtin;
@@ -32,6 +32,16 @@ class ModuleScope : public Scope {
     [[nodiscard]] absl::Nonnull<BuiltinScope*> builtin() const noexcept override {
         return &_builtin;
     }
+
+    /**
+     * Make the top-level type, function (including all of its overloads), or global variable
+     * called `name` in the `from` scope visible in this scope.
+     *
+     * Importing a type also imports all of the methods defined on it in the `from` scope. The
+     * `from` scope must already have been validated.
+     */
+    util::Result<void> import_name(const ModuleScope& from, const std::string_view name,
+                                   lex::Location location);
 };
 
 }  // namespace rain::lang::ast
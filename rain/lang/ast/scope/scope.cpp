@@ -94,6 +94,9 @@ absl::Nonnull<FunctionType*> Scope::get_resolved_function_type(
 
     const auto key = std::make_tuple(callee_type, argument_types, return_type);
 
+    // The function type may be added to any of the parent scopes, which other modules share.
+    const auto lock = builtin()->lock_shared_state();
+
     Scope* scope = this;
     do {
         if (const auto it = scope->_function_types.find(key); it != scope->_function_types.end()) {
@@ -141,6 +144,8 @@ absl::Nullable<FunctionVariable*> Scope::find_function_in_scope(
 absl::Nullable<FunctionVariable*> Scope::find_function(const std::string_view name,
                                                        absl::Nullable<Type*>  callee_type,
                                                        TypeList argument_types) const noexcept {
+    const auto lock = builtin()->lock_shared_state();
+
     const Scope* scope = this;
     do {
         auto* function_variable = scope->find_function_in_scope(name, callee_type, argument_types);
@@ -157,6 +162,10 @@ absl::Nullable<FunctionVariable*> Scope::find_function(const std::string_view na
 absl::Nullable<FunctionVariable*> Scope::find_method(const std::string_view name,
                                                      absl::Nonnull<Type*>   callee_type,
                                                      TypeList argument_types) const noexcept {
+    // Methods of derived types are added to the builtin scope or the scope of an imported module
+    // while other modules are being validated, and looking up a method can derive a reference type.
+    const auto lock = builtin()->lock_shared_state();
+
     Scope* scope = const_cast<Scope*>(this);
 
     if (callee_type->kind() == serial::TypeKind::Meta) {
@@ -175,34 +184,47 @@ absl::Nullable<FunctionVariable*> Scope::find_method(const std::string_view name
         return nullptr;
     }
 
-    do {
-        {  // First check if there is a method that takes self exactly.
-            argument_types.insert(argument_types.begin(), callee_type);
-            auto function = scope->find_function_in_scope(name, callee_type, argument_types);
-            if (function != nullptr) {
-                return function;
+    const auto find_in_scopes = [&](Scope* scope) -> absl::Nullable<FunctionVariable*> {
+        do {
+            {  // First check if there is a method that takes self exactly.
+                argument_types.insert(argument_types.begin(), callee_type);
+                auto function = scope->find_function_in_scope(name, callee_type, argument_types);
+                if (function != nullptr) {
+                    return function;
+                }
             }
-        }
 
-        {  // Look for a method that takes a reference to self as the first argument.
-            argument_types[0] = &callee_type->get_reference_type(*scope);
-            auto function     = scope->find_function_in_scope(name, callee_type, argument_types);
-            if (function != nullptr) {
-                return function;
+            {  // Look for a method that takes a reference to self as the first argument.
+                argument_types[0] = &callee_type->get_reference_type(*scope);
+                auto function = scope->find_function_in_scope(name, callee_type, argument_types);
+                if (function != nullptr) {
+                    return function;
+                }
             }
-        }
 
-        {  // Look for a method that takes no self argument.
-            argument_types.erase(argument_types.begin());
-            auto function = scope->find_function_in_scope(name, callee_type, argument_types);
-            if (function != nullptr) {
-                return function;
+            {  // Look for a method that takes no self argument.
+                argument_types.erase(argument_types.begin());
+                auto function = scope->find_function_in_scope(name, callee_type, argument_types);
+                if (function != nullptr) {
+                    return function;
+                }
             }
-        }
 
-        scope = scope->parent();
-    } while (scope != nullptr);
+            scope = scope->parent();
+        } while (scope != nullptr);
+
+        return nullptr;
+    };
 
+    if (auto* function = find_in_scopes(scope); function != nullptr) {
+        return function;
+    }
+
+    // The builtin methods of derived types (such as slices) are added to the scope that owns the
+    // underlying type, which is not one of the parents of this scope if the type was imported.
+    if (auto* owner_scope = Type::unwrap(*callee_type).owner_scope(); owner_scope != nullptr) {
+        return find_in_scopes(owner_scope);
+    }
     return nullptr;
 }
 
@@ -229,6 +251,7 @@ absl::Nonnull<Type*> Scope::add_named_type(const std::string_view name,
     assert(type->kind() != serial::TypeKind::Unresolved);
 
     auto* type_ptr = type.get();
+    type_ptr->set_owner_scope(this);
     _named_types.insert_or_assign(name, type_ptr);
     _owned_types.insert(std::move(type));
 
@@ -99,6 +99,12 @@ class Scope {
     [[nodiscard]] virtual absl::Nonnull<ModuleScope*>  module() const noexcept  = 0;
     [[nodiscard]] virtual absl::Nonnull<BuiltinScope*> builtin() const noexcept = 0;
 
+    /** Whether this scope is (nested within) the body of a loop that `break` and `continue` exit. */
+    [[nodiscard]] virtual bool in_loop() const noexcept { return false; }
+
+    /** Record that a `break` or `continue` leaves the body of the innermost loop early. */
+    virtual void mark_loop_exit() noexcept {}
+
     ////////////////////////////////////////////////////////////////
     // Find AST nodes
 
@@ -35,6 +35,16 @@ class InterfaceType : public Type {
     [[nodiscard]] constexpr std::string_view name() const noexcept { return _name; }
     [[nodiscard]] constexpr const auto&      methods() const noexcept { return _methods; }
 
+    /** Return the index of the method in the interface's vtbl, if it is one of its methods. */
+    [[nodiscard]] std::optional<int> find_method(const FunctionVariable& method) const noexcept {
+        for (int i = 0; i < _methods.size(); ++i) {
+            if (_methods[i]->variable() == &method) {
+                return i;
+            }
+        }
+        return std::nullopt;
+    }
+
     void add_method(std::unique_ptr<FunctionDeclarationExpression> method) {
         _methods.push_back(std::move(method));
     }
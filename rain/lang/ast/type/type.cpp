@@ -4,6 +4,7 @@
 #include "rain/lang/ast/scope/scope.hpp"
 #include "rain/lang/ast/var/builtin_function.hpp"
 #include "rain/lang/code/context.hpp"
+#include "rain/lang/code/slice.hpp"
 #include "rain/lang/code/type/all.hpp"
 #include "rain/lang/serial/operator_names.hpp"
 
@@ -46,7 +47,8 @@ Type& Type::unwrap(Type& type) noexcept {
     }
 }
 
-OptionalType& Type::get_optional_type(Scope& scope) {
+OptionalType& Type::get_optional_type(Scope& caller_scope) {
+    const auto lock = caller_scope.builtin()->lock_shared_state();
     if (_optional_type != nullptr) {
         return *_optional_type;
     }
@@ -56,6 +58,8 @@ OptionalType& Type::get_optional_type(Scope& scope) {
         return *optional_type;
     }
 
+    Scope& scope = derived_methods_scope(caller_scope);
+
     ast::Type* optional_reference_type = nullptr;
     if (optional_type->type().kind() == serial::TypeKind::Reference) {
         optional_reference_type = optional_type;
@@ -99,6 +103,7 @@ OptionalType& Type::get_optional_type(Scope& scope) {
 }
 
 ReferenceType& Type::get_reference_type(Scope& scope) {
+    const auto lock = scope.builtin()->lock_shared_state();
     if (_reference_type != nullptr) {
         return *_reference_type;
     }
@@ -106,7 +111,8 @@ ReferenceType& Type::get_reference_type(Scope& scope) {
     return *_reference_type;
 }
 
-SliceType& Type::get_slice_type(Scope& scope) {
+SliceType& Type::get_slice_type(Scope& caller_scope) {
+    const auto lock = caller_scope.builtin()->lock_shared_state();
     if (_slice_type != nullptr) {
         return *_slice_type;
     }
@@ -116,6 +122,8 @@ SliceType& Type::get_slice_type(Scope& scope) {
         return *_slice_type;
     }
 
+    Scope& scope = derived_methods_scope(caller_scope);
+
     auto* slice_type = _slice_type.get();
     {      // Add builtin functions for array types.
         {  // Array indexing.
@@ -155,12 +163,68 @@ SliceType& Type::get_slice_type(Scope& scope) {
                 });
             scope.add_resolved_function(std::move(method));
         }
+
+        {  // Copy as many elements as both slices have, returning how many were copied.
+            auto* count_type = scope.builtin()->i32_type();
+
+            auto* function_type =
+                scope.get_resolved_function_type(slice_type, {slice_type, slice_type}, count_type);
+            auto method = make_builtin_function_variable(
+                "copy_from", function_type, [slice_type](auto& ctx, auto& arguments) {
+                    return code::create_slice_copy(ctx, ctx.llvm_type(&slice_type->type()),
+                                                   arguments[0], arguments[1]);
+                });
+            scope.add_resolved_function(std::move(method));
+        }
+
+        {  // Set every element to the same value.
+            auto* function_type =
+                scope.get_resolved_function_type(slice_type, {slice_type, this}, nullptr);
+            auto method = make_builtin_function_variable(
+                "fill", function_type, [slice_type](auto& ctx, auto& arguments) -> llvm::Value* {
+                    code::create_slice_fill(ctx, ctx.llvm_type(&slice_type->type()), arguments[0],
+                                            arguments[1]);
+                    return nullptr;
+                });
+            scope.add_resolved_function(std::move(method));
+        }
+
+        // Comparing and searching for elements is only supported for numbers, which are compared
+        // the same way as with the `==` operator.
+        auto* builtin = scope.builtin();
+        if (this == builtin->u8_type() || this == builtin->i16_type() ||
+            this == builtin->i32_type() || this == builtin->i64_type() ||
+            this == builtin->f32_type() || this == builtin->f64_type()) {
+            {  // Slice equality.
+                auto* function_type = scope.get_resolved_function_type(
+                    slice_type, {slice_type, slice_type}, builtin->bool_type());
+                auto method = make_builtin_function_variable(
+                    "equals", function_type, [slice_type](auto& ctx, auto& arguments) {
+                        return code::create_slice_equals(ctx, ctx.llvm_type(&slice_type->type()),
+                                                         arguments[0], arguments[1]);
+                    });
+                scope.add_resolved_function(std::move(method));
+            }
+
+            {  // The index of the first element equal to a value, or -1.
+                auto* function_type = scope.get_resolved_function_type(
+                    slice_type, {slice_type, this}, builtin->i32_type());
+                auto method = make_builtin_function_variable(
+                    "index_of", function_type, [slice_type](auto& ctx, auto& arguments) {
+                        return code::create_slice_index_of(
+                            ctx, ctx.llvm_type(&slice_type->type()), arguments[0], arguments[1]);
+                    });
+                scope.add_resolved_function(std::move(method));
+            }
+        }
     }
 
     return *_slice_type;
 }
 
-ArrayType& Type::get_array_type(Scope& scope, size_t length) {
+ArrayType& Type::get_array_type(Scope& caller_scope, size_t length) {
+    const auto lock = caller_scope.builtin()->lock_shared_state();
+
     auto it = _array_types.find(length);
     if (it != _array_types.end()) {
         return *it->second;
@@ -172,6 +236,8 @@ ArrayType& Type::get_array_type(Scope& scope, size_t length) {
         return *array_type;
     }
 
+    Scope& scope = derived_methods_scope(caller_scope);
+
     {      // Add builtin functions for array types.
         {  // Array indexing.
             auto* index_type     = scope.builtin()->i32_type();
@@ -207,7 +273,15 @@ ArrayType& Type::get_array_type(Scope& scope, size_t length) {
     return *array_type;
 }
 
+Scope& Type::derived_methods_scope(Scope& scope) noexcept {
+    auto* owner_scope = unwrap(*this).owner_scope();
+    return owner_scope != nullptr ? *owner_scope : scope;
+}
+
 util::Result<absl::Nonnull<Type*>> Type::resolve(Options& options, Scope& scope) {
+    // Derived types (such as `[]i32`) are cached on the type they are derived from, so the same
+    // unresolved instance can be shared by several modules.
+    const auto lock = scope.builtin()->lock_shared_state();
     if (_resolves_to != nullptr) {
         return _resolves_to;
     }
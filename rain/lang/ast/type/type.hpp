@@ -33,6 +33,13 @@ class Type {
     std::vector<absl::Nonnull<Type*>> _interface_implementations;
     absl::Nullable<Type*>             _resolves_to = nullptr;
 
+    /**
+     * The scope that owns this type, if it is a named type. The builtin methods of the types
+     * derived from it (arrays, optionals, and slices) are added to this scope, so that they live
+     * exactly as long as the type that caches them.
+     */
+    absl::Nullable<Scope*> _owner_scope = nullptr;
+
   public:
     static std::string display_name(const Type* type) noexcept;
     static Type&       unwrap(Type& type) noexcept;
@@ -50,6 +57,11 @@ class Type {
 
     [[nodiscard]] constexpr const auto& array_types() const noexcept { return _array_types; }
 
+    [[nodiscard]] constexpr absl::Nullable<Scope*> owner_scope() const noexcept {
+        return _owner_scope;
+    }
+    constexpr void set_owner_scope(absl::Nullable<Scope*> scope) noexcept { _owner_scope = scope; }
+
     [[nodiscard]] constexpr bool is_exported() const noexcept { return _exported; }
     void set_exported(const bool exported) noexcept { _exported = exported; }
 
@@ -65,6 +77,12 @@ class Type {
   protected:
     [[nodiscard]] virtual util::Result<absl::Nonnull<Type*>> _resolve(Options& options,
                                                                       Scope&   scope) = 0;
+
+    /**
+     * Return the scope to add the methods of a type derived from this one to: the scope that owns
+     * the underlying named type, or `scope` if it is not owned by any.
+     */
+    [[nodiscard]] Scope& derived_methods_scope(Scope& scope) noexcept;
 };
 
 // MARK: ArrayType
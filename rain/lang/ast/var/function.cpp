@@ -1,11 +1,24 @@
 #include "rain/lang/ast/var/function.hpp"
 
+#include "rain/lang/ast/type/interface.hpp"
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/context.hpp"
+#include "rain/lang/code/interface.hpp"
 
 namespace rain::lang::ast {
 
 llvm::Value* FunctionVariable::build_call(
     code::Context& ctx, const llvm::ArrayRef<llvm::Value*> arguments) const noexcept {
+    // The methods declared by an interface have no body of their own, and are called through the
+    // vtbl of the value they are called on instead.
+    if (auto* callee_type = _function_type->callee_type();
+        callee_type != nullptr && callee_type->kind() == serial::TypeKind::Interface) {
+        auto& interface_type = static_cast<InterfaceType&>(*callee_type);
+        if (const auto method_index = interface_type.find_method(*this); method_index.has_value()) {
+            return code::create_interface_call(ctx, interface_type, *method_index, arguments);
+        }
+    }
+
     llvm::Function* llvm_function = static_cast<llvm::Function*>(ctx.llvm_value(this));
     assert(llvm_function != nullptr && "cannot create a call to a null llvm_function");
 
@@ -14,8 +27,8 @@ llvm::Value* FunctionVariable::build_call(
     //     ctx.compile_function(*_definition);
     // }
 
-    return ctx.llvm_builder().CreateCall(
-        static_cast<llvm::FunctionType*>(ctx.llvm_type(_function_type)), llvm_function,
+    return code::create_abi_call(
+        ctx, static_cast<llvm::FunctionType*>(ctx.llvm_type(_function_type)), llvm_function,
         llvm::ArrayRef<llvm::Value*>(arguments.data(), arguments.size()));
 }
 
@@ -0,0 +1,312 @@
+#include "rain/lang/code/abi.hpp"
+
+#include "absl/strings/str_cat.h"
+#include "llvm/IR/Attributes.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/InstIterator.h"
+#include "rain/lang/code/context.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+/** Add the attributes of the parameters that are passed by pointer to a function or a call. */
+template <typename T>
+void add_abi_attributes(Context& ctx, llvm::FunctionType* llvm_direct_type, T& llvm_target) {
+    auto&       llvm_ctx         = ctx.llvm_context();
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+    auto        llvm_attributes  = llvm_target.getAttributes();
+
+    unsigned    offset           = 0;
+    llvm::Type* llvm_return_type = llvm_direct_type->getReturnType();
+    if (is_passed_indirectly(llvm_data_layout, llvm_return_type)) {
+        llvm::AttrBuilder llvm_builder(llvm_ctx);
+        llvm_builder.addStructRetAttr(llvm_return_type);
+        llvm_builder.addAttribute(llvm::Attribute::NoAlias);
+        llvm_builder.addAlignmentAttr(llvm_data_layout.getABITypeAlign(llvm_return_type));
+        llvm_attributes = llvm_attributes.addParamAttributes(llvm_ctx, 0, llvm_builder);
+        offset          = 1;
+    }
+
+    // Arguments are immutable, so the callee never writes through the pointer, and it does not
+    // need its own copy (as `byval` would make).
+    for (unsigned i = 0, end = llvm_direct_type->getNumParams(); i < end; ++i) {
+        llvm::Type* llvm_param_type = llvm_direct_type->getParamType(i);
+        if (!is_passed_indirectly(llvm_data_layout, llvm_param_type)) {
+            continue;
+        }
+
+        llvm::AttrBuilder llvm_builder(llvm_ctx);
+        llvm_builder.addAttribute(llvm::Attribute::NoAlias);
+        llvm_builder.addAttribute(llvm::Attribute::NoCapture);
+        llvm_builder.addAttribute(llvm::Attribute::ReadOnly);
+        llvm_builder.addAlignmentAttr(llvm_data_layout.getABITypeAlign(llvm_param_type));
+        llvm_builder.addDereferenceableAttr(
+            llvm_data_layout.getTypeAllocSize(llvm_param_type).getFixedValue());
+        llvm_attributes = llvm_attributes.addParamAttributes(llvm_ctx, i + offset, llvm_builder);
+    }
+
+    llvm_target.setAttributes(llvm_attributes);
+}
+
+/**
+ * Return directly from the predecessors of a block that only returns the value merged from them
+ * (with a phi), where that value is a call or another such phi at the end of the predecessor.
+ * Return the predecessors that now return, erasing the block if none of them are left.
+ */
+llvm::SmallVector<llvm::BasicBlock*, 2> fold_return_into_predecessors(
+    Context& ctx, llvm::BasicBlock& llvm_block) {
+    llvm::SmallVector<llvm::BasicBlock*, 2> llvm_folded_blocks;
+
+    auto* llvm_return = llvm::dyn_cast_or_null<llvm::ReturnInst>(llvm_block.getTerminator());
+    if (llvm_return == nullptr) {
+        return llvm_folded_blocks;
+    }
+    auto* llvm_phi = llvm::dyn_cast_or_null<llvm::PHINode>(llvm_return->getReturnValue());
+    if (llvm_phi == nullptr || &llvm_block.front() != llvm_phi ||
+        llvm_phi->getNextNode() != llvm_return || !llvm_phi->hasOneUse()) {
+        return llvm_folded_blocks;
+    }
+
+    for (unsigned i = llvm_phi->getNumIncomingValues(); i-- > 0;) {
+        llvm::BasicBlock* llvm_predecessor = llvm_phi->getIncomingBlock(i);
+        auto* llvm_branch = llvm::dyn_cast<llvm::BranchInst>(llvm_predecessor->getTerminator());
+        auto* llvm_value  = llvm::dyn_cast<llvm::Instruction>(llvm_phi->getIncomingValue(i));
+        if (llvm_branch == nullptr || llvm_branch->isConditional() || llvm_value == nullptr ||
+            llvm_value->getNextNode() != llvm_branch) {
+            continue;
+        }
+        if (!llvm::isa<llvm::CallInst>(llvm_value) &&
+            !(llvm::isa<llvm::PHINode>(llvm_value) && &llvm_predecessor->front() == llvm_value)) {
+            continue;
+        }
+
+        llvm_branch->eraseFromParent();
+        llvm::ReturnInst::Create(ctx.llvm_context(), llvm_value, llvm_predecessor);
+        llvm_phi->removeIncomingValue(i, /*DeletePHIIfEmpty=*/false);
+        llvm_folded_blocks.push_back(llvm_predecessor);
+    }
+
+    if (llvm_phi->getNumIncomingValues() == 0) {
+        // Nothing branches to the block anymore.
+        llvm_return->eraseFromParent();
+        llvm_phi->eraseFromParent();
+        llvm_block.eraseFromParent();
+    }
+    return llvm_folded_blocks;
+}
+
+}  // namespace
+
+bool is_passed_indirectly(const llvm::DataLayout& llvm_data_layout, llvm::Type* llvm_type) {
+    auto* llvm_struct_type = llvm::dyn_cast<llvm::StructType>(llvm_type);
+    return llvm_struct_type != nullptr && !llvm_struct_type->isOpaque() &&
+           llvm_data_layout.getTypeAllocSize(llvm_struct_type).getFixedValue() >
+               MAX_DIRECT_AGGREGATE_SIZE;
+}
+
+llvm::FunctionType* get_abi_function_type(Context& ctx, llvm::FunctionType* llvm_direct_type) {
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+    auto*       llvm_ptr_type    = llvm::PointerType::get(ctx.llvm_context(), 0);
+
+    llvm::SmallVector<llvm::Type*, 4> llvm_param_types;
+    llvm_param_types.reserve(llvm_direct_type->getNumParams() + 1);
+
+    llvm::Type* llvm_return_type = llvm_direct_type->getReturnType();
+    if (is_passed_indirectly(llvm_data_layout, llvm_return_type)) {
+        llvm_param_types.push_back(llvm_ptr_type);
+        llvm_return_type = llvm::Type::getVoidTy(ctx.llvm_context());
+    }
+    for (llvm::Type* llvm_param_type : llvm_direct_type->params()) {
+        llvm_param_types.push_back(is_passed_indirectly(llvm_data_layout, llvm_param_type)
+                                       ? llvm_ptr_type
+                                       : llvm_param_type);
+    }
+
+    return llvm::FunctionType::get(llvm_return_type, llvm_param_types,
+                                   llvm_direct_type->isVarArg());
+}
+
+llvm::Function* create_abi_function(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                                    llvm::GlobalValue::LinkageTypes linkage,
+                                    const llvm::Twine&              name) {
+    llvm::Function* llvm_function = llvm::Function::Create(
+        get_abi_function_type(ctx, llvm_direct_type), linkage, name, ctx.llvm_module());
+    add_abi_attributes(ctx, llvm_direct_type, *llvm_function);
+    return llvm_function;
+}
+
+llvm::SmallVector<llvm::Value*, 4> get_abi_arguments(Context&            ctx,
+                                                     llvm::FunctionType* llvm_direct_type,
+                                                     llvm::Function&     llvm_function) {
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+    auto&       llvm_ir          = ctx.llvm_builder();
+
+    llvm::SmallVector<llvm::Value*, 4> llvm_arguments;
+    llvm_arguments.reserve(llvm_direct_type->getNumParams());
+
+    if (llvm_function.getFunctionType() == llvm_direct_type) {
+        for (auto& llvm_argument : llvm_function.args()) {
+            llvm_arguments.push_back(&llvm_argument);
+        }
+        return llvm_arguments;
+    }
+
+    const unsigned offset =
+        is_passed_indirectly(llvm_data_layout, llvm_direct_type->getReturnType()) ? 1 : 0;
+    for (unsigned i = 0, end = llvm_direct_type->getNumParams(); i < end; ++i) {
+        llvm::Type*     llvm_param_type = llvm_direct_type->getParamType(i);
+        llvm::Argument* llvm_argument   = llvm_function.getArg(i + offset);
+        if (is_passed_indirectly(llvm_data_layout, llvm_param_type)) {
+            llvm_arguments.push_back(llvm_ir.CreateLoad(llvm_param_type, llvm_argument));
+        } else {
+            llvm_arguments.push_back(llvm_argument);
+        }
+    }
+    return llvm_arguments;
+}
+
+void create_abi_return(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                       llvm::Function& llvm_function, llvm::Value* llvm_value) {
+    auto& llvm_ir = ctx.llvm_builder();
+
+    if (llvm_direct_type->getReturnType()->isVoidTy()) {
+        llvm_ir.CreateRetVoid();
+        return;
+    }
+
+    if (llvm_function.getFunctionType() != llvm_direct_type &&
+        is_passed_indirectly(ctx.llvm_data_layout(), llvm_direct_type->getReturnType())) {
+        llvm_ir.CreateStore(llvm_value, llvm_function.getArg(0));
+        llvm_ir.CreateRetVoid();
+        return;
+    }
+
+    llvm_ir.CreateRet(llvm_value);
+}
+
+llvm::Value* create_abi_call(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                             llvm::FunctionCallee         llvm_callee,
+                             llvm::ArrayRef<llvm::Value*> arguments) {
+    auto& llvm_ir = ctx.llvm_builder();
+
+    if (llvm_callee.getFunctionType() == llvm_direct_type) {
+        return llvm_ir.CreateCall(llvm_direct_type, llvm_callee.getCallee(), arguments);
+    }
+
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+
+    llvm::SmallVector<llvm::Value*, 4> llvm_arguments;
+    llvm_arguments.reserve(arguments.size() + 1);
+
+    llvm::Type*       llvm_return_type = llvm_direct_type->getReturnType();
+    llvm::AllocaInst* llvm_result      = nullptr;
+    if (is_passed_indirectly(llvm_data_layout, llvm_return_type)) {
+        llvm_result = ctx.create_stack_slot(llvm_return_type, "sret");
+        llvm_arguments.push_back(llvm_result);
+    }
+    for (unsigned i = 0, end = arguments.size(); i < end; ++i) {
+        llvm::Type* llvm_param_type = llvm_direct_type->getParamType(i);
+        if (is_passed_indirectly(llvm_data_layout, llvm_param_type)) {
+            auto* llvm_copy = ctx.create_stack_slot(llvm_param_type);
+            llvm_ir.CreateStore(arguments[i], llvm_copy);
+            llvm_arguments.push_back(llvm_copy);
+        } else {
+            llvm_arguments.push_back(arguments[i]);
+        }
+    }
+
+    llvm::CallInst* llvm_call = llvm_ir.CreateCall(llvm_callee, llvm_arguments);
+    add_abi_attributes(ctx, llvm_direct_type, *llvm_call);
+
+    if (llvm_result != nullptr) {
+        return llvm_ir.CreateLoad(llvm_return_type, llvm_result);
+    }
+    return llvm_call;
+}
+
+void define_abi_adapter(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                        llvm::Function& llvm_adapter, llvm::Function& llvm_target) {
+    auto&                               llvm_ir = ctx.llvm_builder();
+    llvm::IRBuilderBase::InsertPointGuard insert_point_guard(llvm_ir);
+
+    llvm_ir.SetInsertPoint(llvm::BasicBlock::Create(ctx.llvm_context(), "entry", &llvm_adapter));
+
+    const auto   llvm_arguments = get_abi_arguments(ctx, llvm_direct_type, llvm_adapter);
+    llvm::Value* llvm_result =
+        create_abi_call(ctx, llvm_direct_type, &llvm_target, llvm_arguments);
+    create_abi_return(ctx, llvm_direct_type, llvm_adapter, llvm_result);
+}
+
+llvm::Function* wrap_with_abi_adapter(Context& ctx, llvm::Function* llvm_function,
+                                      llvm::FunctionType*             llvm_direct_type,
+                                      const HostBoundary              boundary,
+                                      llvm::GlobalValue::LinkageTypes linkage) {
+    if (llvm_function->getFunctionType() != llvm_direct_type) {
+        const std::string name = llvm_function->getName().str();
+        llvm_function->setName(absl::StrCat(name, ".impl"));
+
+        llvm::Function* llvm_direct =
+            llvm::Function::Create(llvm_direct_type, linkage, name, ctx.llvm_module());
+        if (boundary == HostBoundary::Export) {
+            define_abi_adapter(ctx, llvm_direct_type, *llvm_direct, *llvm_function);
+        } else {
+            define_abi_adapter(ctx, llvm_direct_type, *llvm_function, *llvm_direct);
+        }
+        llvm_function = llvm_direct;
+    }
+
+    llvm_function->setLinkage(linkage);
+    return llvm_function;
+}
+
+void mark_tail_calls(Context& ctx, llvm::Function& llvm_function) {
+    // A tail call frees the frame of the caller before the callee runs, so nothing that is passed
+    // to the callee may point into it. Rather than tracking where the pointers to stack slots end
+    // up, functions that have any are not changed at all.
+    for (const auto& llvm_instruction : llvm::instructions(llvm_function)) {
+        if (llvm::isa<llvm::AllocaInst>(llvm_instruction)) {
+            return;
+        }
+    }
+
+    llvm::SmallVector<llvm::BasicBlock*, 8> llvm_worklist;
+    for (auto& llvm_block : llvm_function) {
+        if (llvm::isa_and_nonnull<llvm::ReturnInst>(llvm_block.getTerminator())) {
+            llvm_worklist.push_back(&llvm_block);
+        }
+    }
+    while (!llvm_worklist.empty()) {
+        llvm::BasicBlock* llvm_block = llvm_worklist.pop_back_val();
+        llvm_worklist.append(fold_return_into_predecessors(ctx, *llvm_block));
+    }
+
+    for (auto& llvm_block : llvm_function) {
+        auto* llvm_return = llvm::dyn_cast_or_null<llvm::ReturnInst>(llvm_block.getTerminator());
+        if (llvm_return == nullptr) {
+            continue;
+        }
+        auto* llvm_call = llvm::dyn_cast_or_null<llvm::CallInst>(llvm_return->getPrevNode());
+        if (llvm_call == nullptr ||
+            (llvm_return->getReturnValue() != llvm_call &&
+             !(llvm_return->getReturnValue() == nullptr && llvm_call->getType()->isVoidTy()))) {
+            continue;
+        }
+        llvm::Function* llvm_callee = llvm_call->getCalledFunction();
+        if (llvm_callee == nullptr || llvm_callee->isIntrinsic()) {
+            continue;
+        }
+
+        // `musttail` also needs the ABI attributes of both functions to match, which they only
+        // might not for `sret` (the other parameters passed by pointer need stack slots).
+        const bool same_signature =
+            llvm_callee->getFunctionType() == llvm_function.getFunctionType() &&
+            llvm_callee->getCallingConv() == llvm_function.getCallingConv() &&
+            !llvm_function.isVarArg() && !llvm_function.hasStructRetAttr() &&
+            !llvm_callee->hasStructRetAttr();
+        llvm_call->setTailCallKind(same_signature ? llvm::CallInst::TCK_MustTail
+                                                  : llvm::CallInst::TCK_Tail);
+    }
+}
+
+}  // namespace rain::lang::code
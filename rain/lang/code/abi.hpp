@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/Twine.h"
+#include "llvm/IR/DataLayout.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Value.h"
+
+namespace rain::lang::code {
+
+class Context;
+
+/**
+ * The calling convention used between functions defined in rain.
+ *
+ * Structs larger than this many bytes are passed by pointer: arguments as a pointer to a (readonly)
+ * copy owned by the caller, and return values through an `sret` pointer to memory owned by the
+ * caller. Smaller values are passed directly as first-class values, which wasm returns as multiple
+ * values (with the multivalue feature), and native targets return in registers.
+ *
+ * Exported and external functions are called or implemented by the host, so they keep the direct
+ * signature of their rain function type, and are adapted to this convention wherever the two
+ * differ.
+ */
+constexpr uint64_t MAX_DIRECT_AGGREGATE_SIZE = 16;
+
+/** Whether values of the given type are passed to and returned from functions by pointer. */
+[[nodiscard]] bool is_passed_indirectly(const llvm::DataLayout& llvm_data_layout,
+                                        llvm::Type*             llvm_type);
+
+/** Return the type of a rain function, given the direct type of its signature. */
+llvm::FunctionType* get_abi_function_type(Context& ctx, llvm::FunctionType* llvm_direct_type);
+
+/** Create a rain function (with the convention's parameter attributes) for the direct type. */
+llvm::Function* create_abi_function(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                                    llvm::GlobalValue::LinkageTypes linkage,
+                                    const llvm::Twine&              name);
+
+/**
+ * Return the (direct) values of the arguments of the function being compiled, loading the ones
+ * that are passed by pointer.
+ */
+llvm::SmallVector<llvm::Value*, 4> get_abi_arguments(Context&            ctx,
+                                                     llvm::FunctionType* llvm_direct_type,
+                                                     llvm::Function&     llvm_function);
+
+/**
+ * Return the (direct) value from the function being compiled, storing it through the `sret`
+ * pointer if it is returned indirectly.
+ */
+void create_abi_return(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                       llvm::Function& llvm_function, llvm::Value* llvm_value);
+
+/**
+ * Call a function with direct argument values, and return its direct result (or null if it does
+ * not return a value). The callee may either be a rain function, or an external function that
+ * takes its direct signature; or a pointer to either, along with the type of the function.
+ */
+llvm::Value* create_abi_call(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                             llvm::FunctionCallee         llvm_callee,
+                             llvm::ArrayRef<llvm::Value*> arguments);
+
+/**
+ * Define the body of `llvm_adapter` as a call to `llvm_target`, where one of them takes the direct
+ * signature and the other is a rain function.
+ */
+void define_abi_adapter(Context& ctx, llvm::FunctionType* llvm_direct_type,
+                        llvm::Function& llvm_adapter, llvm::Function& llvm_target);
+
+/** The side of the boundary with the host that a function with the direct signature is on. */
+enum class HostBoundary {
+    /** The host calls an exported rain function. */
+    Export,
+
+    /** A rain function calls an extern that the host implements. */
+    Extern,
+};
+
+/**
+ * Give a function the direct signature that the host calls or implements it with, and the linkage.
+ *
+ * If that is not how rain functions pass its arguments or return value, the rain function is
+ * renamed with an `.impl` suffix, and a new function with the direct signature takes its name: for
+ * an export, it adapts calls from the host into the rain function; for an extern, the rain function
+ * becomes the adapter that calls it. Returns the function with the direct signature.
+ */
+llvm::Function* wrap_with_abi_adapter(Context& ctx, llvm::Function* llvm_function,
+                                      llvm::FunctionType* llvm_direct_type, HostBoundary boundary,
+                                      llvm::GlobalValue::LinkageTypes linkage);
+
+/**
+ * Mark the calls whose result the (fully compiled) function returns as tail calls: `musttail` when
+ * the callee has the same signature, so that mutual recursion is guaranteed to run in constant
+ * stack space, or `tail` otherwise. Branches that only merge the values they return are made to
+ * return directly, so that calls at the end of an `if` are in tail position too.
+ *
+ * Functions that have stack slots are left alone, as their frame may still be pointed to.
+ */
+void mark_tail_calls(Context& ctx, llvm::Function& llvm_function);
+
+}  // namespace rain::lang::code
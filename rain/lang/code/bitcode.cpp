@@ -0,0 +1,110 @@
+#include "rain/lang/code/bitcode.hpp"
+
+#include "absl/strings/str_cat.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/Endian.h"
+#include "rain/lang/err/simple.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+constexpr size_t COMPRESSED_BITCODE_HEADER_SIZE =
+    COMPRESSED_BITCODE_MAGIC.size() + sizeof(uint8_t) + sizeof(uint64_t);
+
+util::Result<llvm::compression::Format> compression_format(BitcodeCompression compression) {
+    switch (compression) {
+        case BitcodeCompression::Zlib:
+            return llvm::compression::Format::Zlib;
+        case BitcodeCompression::Zstd:
+            return llvm::compression::Format::Zstd;
+        default:
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("unknown bitcode compression: ",
+                                        static_cast<int>(compression)));
+    }
+}
+
+llvm::ArrayRef<uint8_t> as_bytes(std::string_view data) {
+    return llvm::ArrayRef<uint8_t>(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+}  // namespace
+
+void write_bitcode(const llvm::Module& llvm_module, llvm::raw_ostream& ostream) {
+    llvm::WriteBitcodeToFile(llvm_module, ostream);
+}
+
+util::Result<std::string> emit_bitcode(const llvm::Module& llvm_module,
+                                       BitcodeCompression compression) {
+    std::string              bitcode;
+    llvm::raw_string_ostream ostream(bitcode);
+    write_bitcode(llvm_module, ostream);
+    ostream.flush();
+
+    if (compression == BitcodeCompression::None) {
+        return bitcode;
+    }
+
+    auto format_result = compression_format(compression);
+    FORWARD_ERROR(format_result);
+    const auto format = format_result.value();
+
+    if (const char* reason = llvm::compression::getReasonIfUnsupported(format);
+        reason != nullptr) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("cannot compress bitcode: ", reason));
+    }
+
+    llvm::SmallVector<uint8_t, 0> compressed;
+    llvm::compression::compress(format, as_bytes(bitcode), compressed);
+
+    std::string result;
+    result.reserve(COMPRESSED_BITCODE_HEADER_SIZE + compressed.size());
+    result.append(COMPRESSED_BITCODE_MAGIC);
+    result.push_back(static_cast<char>(compression));
+
+    char size[sizeof(uint64_t)];
+    llvm::support::endian::write64le(size, bitcode.size());
+    result.append(size, sizeof(size));
+
+    result.append(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+    return result;
+}
+
+bool is_compressed_bitcode(std::string_view data) noexcept {
+    return data.size() >= COMPRESSED_BITCODE_HEADER_SIZE &&
+           data.starts_with(COMPRESSED_BITCODE_MAGIC);
+}
+
+util::Result<std::string> decompress_bitcode(std::string_view data) {
+    if (!is_compressed_bitcode(data)) {
+        return ERR_PTR(err::SimpleError, "not a compressed bitcode container");
+    }
+    data.remove_prefix(COMPRESSED_BITCODE_MAGIC.size());
+
+    auto format_result = compression_format(static_cast<BitcodeCompression>(data.front()));
+    FORWARD_ERROR(format_result);
+    const auto format = format_result.value();
+    data.remove_prefix(sizeof(uint8_t));
+
+    const uint64_t uncompressed_size = llvm::support::endian::read64le(data.data());
+    data.remove_prefix(sizeof(uint64_t));
+
+    if (const char* reason = llvm::compression::getReasonIfUnsupported(format);
+        reason != nullptr) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("cannot decompress bitcode: ", reason));
+    }
+
+    llvm::SmallVector<uint8_t, 0> bitcode;
+    if (auto error = llvm::compression::decompress(format, as_bytes(data), bitcode,
+                                                   uncompressed_size)) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("cannot decompress bitcode: ",
+                                                      llvm::toString(std::move(error))));
+    }
+    return std::string(reinterpret_cast<const char*>(bitcode.data()), bitcode.size());
+}
+
+}  // namespace rain::lang::code
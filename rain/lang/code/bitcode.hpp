@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::code {
+
+enum class BitcodeCompression : uint8_t {
+    None = 0,
+    Zlib = 1,
+    Zstd = 2,
+};
+
+/**
+ * Compressed bitcode is stored in a small container, so that it can be told apart from plain
+ * bitcode and textual IR:
+ *
+ *   "RNBC" | compression (1 byte) | uncompressed size (8 bytes, little endian) | compressed data
+ */
+constexpr std::string_view COMPRESSED_BITCODE_MAGIC = "RNBC";
+
+/** Write the module as (uncompressed) LLVM bitcode. */
+void write_bitcode(const llvm::Module& llvm_module, llvm::raw_ostream& ostream);
+
+/**
+ * Return the module as LLVM bitcode, compressed if asked to.
+ *
+ * Compression fails if LLVM was built without support for the chosen format.
+ */
+util::Result<std::string> emit_bitcode(const llvm::Module& llvm_module,
+                                       BitcodeCompression compression);
+
+[[nodiscard]] bool is_compressed_bitcode(std::string_view data) noexcept;
+
+/** Return the plain bitcode stored in a compressed bitcode container. */
+util::Result<std::string> decompress_bitcode(std::string_view data);
+
+}  // namespace rain::lang::code
@@ -2,6 +2,95 @@
 
 namespace rain::lang::code {
 
+namespace {
+
+llvm::ConstantInt* stack_slot_size(Context& ctx, llvm::AllocaInst* llvm_alloca) {
+    return ctx.llvm_builder().getInt64(
+        ctx.llvm_data_layout().getTypeAllocSize(llvm_alloca->getAllocatedType()).getFixedValue());
+}
+
+}  // namespace
+
+llvm::GlobalVariable* Context::get_or_create_constant_global(llvm::Constant*    llvm_value,
+                                                             const llvm::Twine& name) {
+    // LLVM constants are uniqued by their type and contents, so equal literals share a key.
+    auto [it, inserted] = _constant_globals.try_emplace(llvm_value, nullptr);
+    if (inserted) {
+        it->second = new llvm::GlobalVariable(llvm_module(), llvm_value->getType(), true,
+                                              llvm::GlobalValue::InternalLinkage, llvm_value, name);
+
+        // The address of a literal is never observed, so the linker may also merge it with the
+        // same data from other modules.
+        it->second->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    }
+    return it->second;
+}
+
+llvm::AllocaInst* Context::create_stack_slot(llvm::Type* llvm_type, const llvm::Twine& name) {
+    llvm::Function* const llvm_function = _llvm_builder.GetInsertBlock()->getParent();
+
+    llvm::AllocaInst* llvm_alloca = nullptr;
+    if (auto it = _free_stack_slots.find(std::make_pair(llvm_function, llvm_type));
+        it != _free_stack_slots.end() && !it->second.empty()) {
+        llvm_alloca = it->second.pop_back_val();
+    } else {
+        // Allocas at the start of the entry block are part of the fixed size stack frame, rather
+        // than being allocated again each time that the block they are used in is run.
+        llvm::BasicBlock& llvm_entry_block = llvm_function->getEntryBlock();
+        llvm::IRBuilder<> llvm_entry_ir(&llvm_entry_block, llvm_entry_block.getFirstInsertionPt());
+        llvm_alloca = llvm_entry_ir.CreateAlloca(llvm_type, nullptr, name);
+    }
+
+    if (!_stack_scopes.empty() && _stack_scopes.back().function == llvm_function) {
+        _llvm_builder.CreateLifetimeStart(llvm_alloca, stack_slot_size(*this, llvm_alloca));
+        _stack_scopes.back().slots.push_back(llvm_alloca);
+    }
+    return llvm_alloca;
+}
+
+void Context::push_stack_scope() {
+    llvm::BasicBlock* const llvm_block = _llvm_builder.GetInsertBlock();
+    _stack_scopes.push_back(StackScope{
+        .function = llvm_block != nullptr ? llvm_block->getParent() : nullptr,
+    });
+}
+
+void Context::pop_stack_scope(bool keep_alive) {
+    StackScope scope = _stack_scopes.pop_back_val();
+
+    if (keep_alive) {
+        if (!_stack_scopes.empty() && _stack_scopes.back().function == scope.function) {
+            _stack_scopes.back().slots.append(scope.slots.begin(), scope.slots.end());
+        }
+        return;
+    }
+
+    // A block that ends in a `break` or `continue` has already ended the lifetimes of its slots.
+    if (!_returned) {
+        for (auto* llvm_alloca : scope.slots) {
+            _llvm_builder.CreateLifetimeEnd(llvm_alloca, stack_slot_size(*this, llvm_alloca));
+        }
+    }
+    for (auto* llvm_alloca : scope.slots) {
+        _free_stack_slots[std::make_pair(scope.function, llvm_alloca->getAllocatedType())]
+            .push_back(llvm_alloca);
+    }
+}
+
+void Context::end_loop_stack_slots() {
+    for (size_t i = loop().stack_scope_depth, end = _stack_scopes.size(); i < end; ++i) {
+        for (auto* llvm_alloca : _stack_scopes[i].slots) {
+            _llvm_builder.CreateLifetimeEnd(llvm_alloca, stack_slot_size(*this, llvm_alloca));
+        }
+    }
+}
+
+void Context::release_stack_slots(llvm::Function* llvm_function) {
+    absl::erase_if(_free_stack_slots, [llvm_function](const auto& entry) {
+        return entry.first.first == llvm_function;
+    });
+}
+
 void Context::set_llvm_type(const ast::Type* type, llvm::Type* llvm_type) {
     _llvm_types.emplace(type, llvm_type);
 }
@@ -24,4 +113,34 @@ llvm::Value* Context::llvm_value(const ast::Variable* variable) const {
     return nullptr;
 }
 
+void Context::set_llvm_vtbl(const ast::Type* implementer_type, const ast::Type* interface_type,
+                            llvm::GlobalVariable* llvm_vtbl) {
+    _llvm_vtbls.emplace(std::make_pair(implementer_type, interface_type), llvm_vtbl);
+}
+
+llvm::GlobalVariable* Context::llvm_vtbl(const ast::Type* implementer_type,
+                                         const ast::Type* interface_type) const {
+    if (const auto it = _llvm_vtbls.find(std::make_pair(implementer_type, interface_type));
+        it != _llvm_vtbls.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+void Context::add_implementation(const ast::InterfaceImplementationExpression& implementation) {
+    const auto [it, inserted] =
+        _implementations.try_emplace(implementation.interface_type(), &implementation);
+    if (!inserted) {
+        it->second = nullptr;
+    }
+}
+
+absl::Nullable<const ast::InterfaceImplementationExpression*> Context::sole_implementation(
+    const ast::Type* interface_type) const {
+    if (const auto it = _implementations.find(interface_type); it != _implementations.end()) {
+        return it->second;
+    }
+    return nullptr;
+}
+
 }  // namespace rain::lang::code
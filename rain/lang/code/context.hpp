@@ -2,20 +2,44 @@
 
 #include <memory>
 #include <tuple>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Type.h"
 #include "llvm/Target/TargetMachine.h"
+#include "rain/lang/ast/expr/interface_implementation.hpp"
 #include "rain/lang/ast/type/type.hpp"
+#include "rain/lang/ast/var/function.hpp"
 #include "rain/lang/ast/var/variable.hpp"
+#include "rain/lang/code/incremental.hpp"
 #include "rain/lang/code/module.hpp"
 #include "rain/lang/options.hpp"
+#include "rain/util/result.hpp"
 
 namespace rain::lang::code {
 
+/** The blocks that `continue` and `break` jump to within a loop. */
+struct LoopBlocks {
+    llvm::BasicBlock* continue_block;
+    llvm::BasicBlock* break_block;
+
+    /** The number of stack scopes outside of the loop; filled in by `Context::push_loop`. */
+    size_t stack_scope_depth = 0;
+};
+
+/** The stack slots created while compiling a single block. */
+struct StackScope {
+    absl::Nullable<llvm::Function*>         function;
+    llvm::SmallVector<llvm::AllocaInst*, 4> slots;
+};
+
 class Context {
     Module&           _module;
     Options&          _options;
@@ -24,8 +48,44 @@ class Context {
     absl::flat_hash_map<const ast::Type*, llvm::Type*>      _llvm_types;
     absl::flat_hash_map<const ast::Variable*, llvm::Value*> _llvm_values;
 
+    /** The constant globals (such as string literals) in the module, by their uniqued value. */
+    absl::flat_hash_map<llvm::Constant*, llvm::GlobalVariable*> _constant_globals;
+
+    /** The vtbl of each type's implementation of an interface, by the type and the interface. */
+    absl::flat_hash_map<std::pair<const ast::Type*, const ast::Type*>, llvm::GlobalVariable*>
+        _llvm_vtbls;
+
+    /**
+     * The `impl` of each interface in the modules being compiled, or null for interfaces that
+     * more than one type implements.
+     */
+    absl::flat_hash_map<const ast::Type*, const ast::InterfaceImplementationExpression*>
+        _implementations;
+
+    /** The module scope functions whose symbol names include their argument types. */
+    absl::flat_hash_set<const ast::FunctionVariable*> _overloaded_functions;
+
+    absl::Nullable<FunctionCache*> _function_cache = nullptr;
+
     bool _returned = false;
 
+    /** The loops being compiled, innermost last. */
+    llvm::SmallVector<LoopBlocks, 4> _loops;
+
+    /** The blocks being compiled, innermost last. */
+    llvm::SmallVector<StackScope, 8> _stack_scopes;
+
+    /**
+     * Stack slots whose lifetimes have ended, by function and type. A later slot of the same type
+     * in the same function takes one of these instead of growing the stack frame.
+     */
+    absl::flat_hash_map<std::pair<llvm::Function*, llvm::Type*>,
+                        llvm::SmallVector<llvm::AllocaInst*, 2>>
+        _free_stack_slots;
+
+    /** The first error found while compiling, which is returned once the module is compiled. */
+    std::unique_ptr<util::Error> _error;
+
   public:
     Context(Module& module, Options& options)
         : _module(module), _options(options), _llvm_builder(module.llvm_context()) {}
@@ -49,10 +109,10 @@ class Context {
     [[nodiscard]] /*constexpr*/ llvm::Module& llvm_module() noexcept {
         return _module.llvm_module();
     }
-    [[nodiscard]] /*constexpr*/ const llvm::ExecutionEngine& llvm_engine() const noexcept {
-        return _module.llvm_engine();
+    [[nodiscard]] /*constexpr*/ const llvm::DataLayout& llvm_data_layout() const noexcept {
+        return _module.llvm_data_layout();
     }
-    [[nodiscard]] /*constexpr*/ llvm::ExecutionEngine& llvm_engine() noexcept {
+    [[nodiscard]] /*constexpr*/ llvm::ExecutionEngine& llvm_engine() {
         return _module.llvm_engine();
     }
     [[nodiscard]] /*constexpr*/ const llvm::TargetMachine& llvm_target_machine() const noexcept {
@@ -63,14 +123,109 @@ class Context {
     }
     [[nodiscard]] constexpr llvm::IRBuilder<>& llvm_builder() noexcept { return _llvm_builder; }
 
+    [[nodiscard]] constexpr absl::Nullable<FunctionCache*> function_cache() const noexcept {
+        return _function_cache;
+    }
+    constexpr void set_function_cache(absl::Nullable<FunctionCache*> function_cache) noexcept {
+        _function_cache = function_cache;
+    }
+
+    [[nodiscard]] bool is_overloaded(
+        absl::Nonnull<const ast::FunctionVariable*> function_variable) const noexcept {
+        return _overloaded_functions.contains(function_variable);
+    }
+    void add_overloaded_functions(
+        const absl::flat_hash_set<const ast::FunctionVariable*>& overloaded_functions) {
+        _overloaded_functions.insert(overloaded_functions.begin(), overloaded_functions.end());
+    }
+
     [[nodiscard]] constexpr bool returned() const noexcept { return _returned; }
     constexpr void               set_returned(bool returned) noexcept { _returned = returned; }
 
+    void push_loop(LoopBlocks loop) {
+        loop.stack_scope_depth = _stack_scopes.size();
+        _loops.push_back(loop);
+    }
+    void pop_loop() noexcept { _loops.pop_back(); }
+    [[nodiscard]] const LoopBlocks& loop() const noexcept {
+        assert(!_loops.empty() && "not compiling a loop");
+        return _loops.back();
+    }
+
+    /**
+     * Return a constant global holding the value, which is shared by every literal in the module
+     * with the same contents and type.
+     */
+    llvm::GlobalVariable* get_or_create_constant_global(llvm::Constant*    llvm_value,
+                                                        const llvm::Twine& name);
+
+    /**
+     * Get a stack slot for a local value, which is alive from the current insert point until the
+     * end of the innermost block being compiled.
+     *
+     * The slot is always allocated in the entry block of the current function (so that mem2reg
+     * and SROA can promote it, and a slot used in a loop is only allocated once), and it reuses a
+     * slot of the same type whose lifetime has already ended when there is one.
+     */
+    llvm::AllocaInst* create_stack_slot(llvm::Type* llvm_type, const llvm::Twine& name = "");
+
+    /** Start compiling a block, whose stack slots are freed when it ends. */
+    void push_stack_scope();
+
+    /**
+     * Finish compiling a block, ending the lifetimes of its stack slots. If `keep_alive` is set
+     * (the value of the block may point to one of them), they are moved to the enclosing block
+     * instead.
+     */
+    void pop_stack_scope(bool keep_alive);
+
+    /**
+     * End the lifetimes of the stack slots in all of the blocks within the innermost loop, before
+     * jumping out of them with a `break` or `continue`.
+     */
+    void end_loop_stack_slots();
+
+    /**
+     * Forget the free stack slots of a function once it has been compiled, before it may be
+     * erased (as compile-time functions are, once they have run).
+     */
+    void release_stack_slots(llvm::Function* llvm_function);
+
+    /**
+     * Report an error found while compiling, such as an extern that the target cannot import.
+     * Compiling carries on, and only the first error is kept.
+     */
+    void report_error(std::unique_ptr<util::Error> error) noexcept {
+        if (_error == nullptr) {
+            _error = std::move(error);
+        }
+    }
+
+    /** Return the first error reported while compiling, if there was one. */
+    [[nodiscard]] util::Result<void> take_error() noexcept {
+        if (_error == nullptr) {
+            return {};
+        }
+        return tl::unexpected(std::move(_error));
+    }
+
     void                      set_llvm_type(const ast::Type* type, llvm::Type* llvm_type);
     [[nodiscard]] llvm::Type* llvm_type(const ast::Type* type) const;
 
     void set_llvm_value(const ast::Variable* variable, llvm::Value* llvm_value);
     [[nodiscard]] llvm::Value* llvm_value(const ast::Variable* variable) const;
+
+    void set_llvm_vtbl(const ast::Type* implementer_type, const ast::Type* interface_type,
+                       llvm::GlobalVariable* llvm_vtbl);
+    [[nodiscard]] llvm::GlobalVariable* llvm_vtbl(const ast::Type* implementer_type,
+                                                  const ast::Type* interface_type) const;
+
+    /** Record an `impl` of an interface, before any function body is compiled. */
+    void add_implementation(const ast::InterfaceImplementationExpression& implementation);
+
+    /** Return the `impl` of the interface, if it is the only one in the modules being compiled. */
+    [[nodiscard]] absl::Nullable<const ast::InterfaceImplementationExpression*>
+    sole_implementation(const ast::Type* interface_type) const;
 };
 
 }  // namespace rain::lang::code
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "rain/lang/code/context.hpp"
 #include "rain/lang/code/expr/any.hpp"
 
@@ -8,19 +10,24 @@
 #include "rain/lang/ast/expr/binary_operator.hpp"
 #include "rain/lang/ast/expr/block.hpp"
 #include "rain/lang/ast/expr/boolean.hpp"
+#include "rain/lang/ast/expr/break.hpp"
 #include "rain/lang/ast/expr/call.hpp"
 #include "rain/lang/ast/expr/cast.hpp"
 #include "rain/lang/ast/expr/compile_time.hpp"
+#include "rain/lang/ast/expr/continue.hpp"
 #include "rain/lang/ast/expr/export.hpp"
 #include "rain/lang/ast/expr/expression.hpp"
 #include "rain/lang/ast/expr/extern.hpp"
 #include "rain/lang/ast/expr/float.hpp"
+#include "rain/lang/ast/expr/for.hpp"
 #include "rain/lang/ast/expr/function.hpp"
 #include "rain/lang/ast/expr/function_declaration.hpp"
 #include "rain/lang/ast/expr/identifier.hpp"
 #include "rain/lang/ast/expr/if.hpp"
 #include "rain/lang/ast/expr/integer.hpp"
+#include "rain/lang/ast/expr/interface_implementation.hpp"
 #include "rain/lang/ast/expr/let.hpp"
+#include "rain/lang/ast/expr/loop.hpp"
 #include "rain/lang/ast/expr/member.hpp"
 #include "rain/lang/ast/expr/parenthesis.hpp"
 #include "rain/lang/ast/expr/slice_literal.hpp"
@@ -35,6 +42,13 @@ namespace rain::lang::code {
 
 void compile_module(Context& ctx, ast::Module& module);
 
+/**
+ * Compile several modules that import from each other into a single LLVM module. The modules must
+ * share the same builtin scope, and be ordered such that every module comes after the modules it
+ * imports from.
+ */
+void compile_modules(Context& ctx, std::span<const absl::Nonnull<ast::Module*>> modules);
+
 // Expressions
 llvm::Value* compile_boolean(Context& ctx, ast::BooleanExpression& boolean);
 llvm::Value* compile_integer(Context& ctx, ast::IntegerExpression& integer);
@@ -58,9 +72,16 @@ llvm::Function* compile_function_declaration(Context&               ctx,
 llvm::Function* compile_function(Context& ctx, ast::FunctionExpression& function);
 llvm::Value*    compile_if(Context& ctx, ast::IfExpression& if_);
 llvm::Value*    compile_while(Context& ctx, ast::WhileExpression& while_);
+llvm::Value*    compile_for(Context& ctx, ast::ForExpression& for_);
+llvm::Value*    compile_loop(Context& ctx, ast::LoopExpression& loop);
+llvm::Value*    compile_break(Context& ctx, ast::BreakExpression& break_);
+llvm::Value*    compile_continue(Context& ctx, ast::ContinueExpression& continue_);
 llvm::Value*    compile_export(Context& ctx, ast::ExportExpression& export_);
 llvm::Value*    compile_extern(Context& ctx, ast::ExternExpression& extern_);
 
+void compile_interface_implementation(Context&                                ctx,
+                                      ast::InterfaceImplementationExpression& implementation);
+
 llvm::Value* get_element_pointer(Context& ctx, ast::Expression& expression);
 
 }  // namespace rain::lang::code
@@ -73,6 +73,18 @@ llvm::Value* compile_any_expression(Context& ctx, ast::Expression& expression) {
         case serial::ExpressionKind::While:
             return compile_while(ctx, static_cast<ast::WhileExpression&>(expression));
 
+        case serial::ExpressionKind::For:
+            return compile_for(ctx, static_cast<ast::ForExpression&>(expression));
+
+        case serial::ExpressionKind::Loop:
+            return compile_loop(ctx, static_cast<ast::LoopExpression&>(expression));
+
+        case serial::ExpressionKind::Break:
+            return compile_break(ctx, static_cast<ast::BreakExpression&>(expression));
+
+        case serial::ExpressionKind::Continue:
+            return compile_continue(ctx, static_cast<ast::ContinueExpression&>(expression));
+
         case serial::ExpressionKind::Export:
             return compile_export(ctx, static_cast<ast::ExportExpression&>(expression));
 
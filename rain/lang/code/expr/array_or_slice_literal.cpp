@@ -10,7 +10,8 @@ namespace {
 
 llvm::Value* _compile_array_literal(Context& ctx, llvm::ArrayType* llvm_type,
                                     const std::string_view constant_name,
-                                    const std::vector<std::unique_ptr<ast::Expression>>& elements) {
+                                    const std::vector<std::unique_ptr<ast::Expression>>& elements,
+                                    const bool pooled) {
     std::vector<llvm::Value*> llvm_element_values;
     llvm_element_values.resize(elements.size(), nullptr);
 
@@ -32,16 +33,19 @@ llvm::Value* _compile_array_literal(Context& ctx, llvm::ArrayType* llvm_type,
         llvm::ArrayRef<llvm::Constant*> llvm_constants(
             reinterpret_cast<llvm::Constant**>(llvm_element_values.data()),
             llvm_element_values.size());
-        llvm::GlobalVariable* llvm_global = new llvm::GlobalVariable(
-            ctx.llvm_module(), llvm_type, true, llvm::GlobalValue::InternalLinkage,
-            llvm::ConstantArray::get(llvm_type, llvm_constants), constant_name);
-        return llvm_global;
+        auto* llvm_initializer = llvm::ConstantArray::get(llvm_type, llvm_constants);
+        if (pooled) {
+            return ctx.get_or_create_constant_global(llvm_initializer, constant_name);
+        }
+        return new llvm::GlobalVariable(ctx.llvm_module(), llvm_type, false,
+                                        llvm::GlobalValue::InternalLinkage, llvm_initializer,
+                                        constant_name);
     }
 
     auto& llvm_ir = ctx.llvm_builder();
 
     // Create a runtime array.
-    llvm::Value* llvm_alloca = llvm_ir.CreateAlloca(llvm_type, nullptr, constant_name);
+    llvm::Value* llvm_alloca = ctx.create_stack_slot(llvm_type, constant_name);
     for (int i = 0, end = llvm_element_values.size(); i < end; ++i) {
         std::array<llvm::Value*, 2> indices{
             llvm::ConstantInt::get(ctx.llvm_context(), llvm::APInt(32, 0)),
@@ -61,7 +65,7 @@ llvm::Value* compile_array_literal(Context& ctx, ast::ArrayLiteralExpression& ar
         static_cast<llvm::ArrayType*>(get_or_compile_type(ctx, array_type));
 
     return _compile_array_literal(ctx, llvm_type, absl::StrCat("const.", array_type.display_name()),
-                                  array_literal.elements());
+                                  array_literal.elements(), true);
 }
 
 llvm::Value* compile_slice_literal(Context& ctx, ast::SliceLiteralExpression& slice_literal) {
@@ -72,9 +76,11 @@ llvm::Value* compile_slice_literal(Context& ctx, ast::SliceLiteralExpression& sl
     const auto       element_count   = slice_literal.elements().size();
     llvm::ArrayType* llvm_array_type = llvm::ArrayType::get(llvm_element_type, element_count);
 
+    // The elements of a slice can be written to, and the slice can outlive the function that
+    // created it, so a constant slice literal gets its own global instead of a pooled one.
     auto* llvm_array_literal = _compile_array_literal(
-        ctx, llvm_array_type, absl::StrCat("const.", slice_type.display_name()),
-        slice_literal.elements());
+        ctx, llvm_array_type, absl::StrCat("literal.", slice_type.display_name()),
+        slice_literal.elements(), false);
 
     auto& llvm_ir      = ctx.llvm_builder();
     auto* llvm_poison  = llvm::PoisonValue::get(llvm_slice_type);
@@ -22,7 +22,7 @@ llvm::Value* compile_binary_operator(Context& ctx, ast::BinaryOperatorExpression
 
         llvm::Value* llvm_value = compile_any_expression(ctx, binary_operator.rhs());
         if (binary_operator.rhs().type()->kind() == serial::TypeKind::Array) {
-            auto& llvm_data_layout  = ctx.llvm_engine().getDataLayout();
+            auto& llvm_data_layout  = ctx.llvm_data_layout();
             auto* llvm_element_type = llvm_value->getType()->getArrayElementType();
             auto  llvm_alignment    = llvm_data_layout.getABITypeAlign(llvm_element_type);
             auto  llvm_sizeof =
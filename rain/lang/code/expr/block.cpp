@@ -7,15 +7,45 @@ namespace rain::lang::code {
 llvm::Function* compile_function_declaration(Context&               ctx,
                                              ast::FunctionVariable& function_variable);
 
+namespace {
+
+/** Whether the value of a block may point into one of the stack slots created within it. */
+bool may_point_to_stack(absl::Nullable<const ast::Type*> type) {
+    if (type == nullptr) {
+        return false;
+    }
+    switch (type->kind()) {
+        case serial::TypeKind::Null:
+        case serial::TypeKind::Builtin:
+        case serial::TypeKind::Function:
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+}  // namespace
+
 llvm::Value* compile_block(Context& ctx, ast::BlockExpression& block) {
     block.scope().for_each_function([&ctx](ast::FunctionVariable& function_variable) {
         compile_function_declaration(ctx, function_variable);
     });
 
+    ctx.push_stack_scope();
+
     llvm::Value* return_value = nullptr;
     for (const auto& expression : block.expressions()) {
         return_value = compile_any_expression(ctx, *expression);
+
+        // Anything after a `break` or `continue` can never run, and the block it would be added
+        // to has already been terminated.
+        if (ctx.returned()) {
+            break;
+        }
     }
+
+    ctx.pop_stack_scope(may_point_to_stack(block.type()));
     return return_value;
 }
 
@@ -0,0 +1,12 @@
+#include "rain/lang/code/expr/all.hpp"
+
+namespace rain::lang::code {
+
+llvm::Value* compile_break(Context& ctx, ast::BreakExpression& break_) {
+    ctx.end_loop_stack_slots();
+    ctx.llvm_builder().CreateBr(ctx.loop().break_block);
+    ctx.set_returned(true);
+    return nullptr;
+}
+
+}  // namespace rain::lang::code
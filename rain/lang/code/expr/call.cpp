@@ -2,6 +2,7 @@
 
 #include "llvm/ADT/SmallVector.h"
 #include "rain/lang/ast/expr/member.hpp"
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/expr/any.hpp"
 #include "rain/lang/code/type/all.hpp"
 
@@ -35,7 +36,7 @@ llvm::Value* compile_call_method(Context& ctx, ast::Expression& callee,
         method.function_type()->argument_types()[0] != callee.type()) {
         auto* llvm_self_pointer = get_element_pointer(ctx, callee);
         if (llvm_self_pointer == nullptr) {
-            llvm_self_pointer = llvm_ir.CreateAlloca(get_or_compile_type(ctx, *callee.type()));
+            llvm_self_pointer = ctx.create_stack_slot(get_or_compile_type(ctx, *callee.type()));
             llvm_ir.CreateStore(self_value, llvm_self_pointer);
         }
         llvm_arguments[0] = llvm_self_pointer;
@@ -59,8 +60,6 @@ llvm::Value* compile_call(Context& ctx, ast::CallExpression& call) {
         return arguments;
     };
 
-    auto& ir = ctx.llvm_builder();
-
     switch (call.callee().kind()) {
         case serial::ExpressionKind::Member: {
             ast::MemberExpression& member = static_cast<ast::MemberExpression&>(call.callee());
@@ -77,14 +76,14 @@ llvm::Value* compile_call(Context& ctx, ast::CallExpression& call) {
             if (ast::FunctionVariable* function = call.function(); call.function() != nullptr) {
                 llvm::FunctionType* llvm_function_type =
                     reinterpret_cast<llvm::FunctionType*>(ctx.llvm_type(function->function_type()));
-                llvm::Value* llvm_function = ctx.llvm_value(function);
+                auto* llvm_function = static_cast<llvm::Function*>(ctx.llvm_value(function));
 
                 if (llvm_function == nullptr) {
                     llvm_function = compile_function_declaration(ctx, *function);
                 }
 
                 const auto arguments = get_arguments();
-                return ir.CreateCall(llvm_function_type, llvm_function, arguments);
+                return create_abi_call(ctx, llvm_function_type, llvm_function, arguments);
             }
 
             // The identifier is not referring to a function, so treat it as a variable that has a
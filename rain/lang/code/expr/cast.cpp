@@ -7,10 +7,26 @@ namespace rain::lang::code {
 llvm::Value* compile_call(Context& ctx, ast::Expression& callee, ast::FunctionVariable& method,
                           llvm::ArrayRef<ast::Expression*> arguments);
 
+llvm::Value* get_element_pointer(Context& ctx, ast::Expression& expression);
+
 llvm::Value* compile_cast(Context& ctx, ast::CastExpression& cast) {
+    auto& expression = cast.expression();
+
     std::vector<llvm::Value*> llvm_arguments;
     llvm_arguments.reserve(1);
-    llvm_arguments.emplace_back(compile_any_expression(ctx, cast.expression()));
+    if (cast.method()->function_type()->argument_types()[0] != expression.type()) {
+        // The cast takes a reference to the value, such as to make an interface value that points
+        // to it. Values that are not in memory are copied into a stack slot.
+        auto* llvm_value_pointer = get_element_pointer(ctx, expression);
+        if (llvm_value_pointer == nullptr) {
+            auto* llvm_value   = compile_any_expression(ctx, expression);
+            llvm_value_pointer = ctx.create_stack_slot(llvm_value->getType());
+            ctx.llvm_builder().CreateStore(llvm_value, llvm_value_pointer);
+        }
+        llvm_arguments.emplace_back(llvm_value_pointer);
+    } else {
+        llvm_arguments.emplace_back(compile_any_expression(ctx, expression));
+    }
     return cast.method()->build_call(ctx, llvm_arguments);
 }
 
@@ -146,8 +146,7 @@ llvm::Value* compile_compile_time(Context& ctx, ast::CompileTimeExpression& comp
 
     auto llvm_value = compile_any_expression(ctx, compile_time.expression());
 
-    auto&       llvm_engine      = ctx.llvm_engine();
-    const auto& llvm_data_layout = llvm_engine.getDataLayout();
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
 
     const auto     llvm_alignof = llvm_data_layout.getABITypeAlign(llvm_type);
     const uint32_t llvm_sizeof  = llvm_data_layout.getTypeAllocSize(llvm_type);
@@ -192,7 +191,10 @@ llvm::Value* compile_compile_time(Context& ctx, ast::CompileTimeExpression& comp
 
     llvm::GenericValue llvm_generic_ptr;
     llvm_generic_ptr.PointerVal = ptr;
+    // This is the only place the execution engine is needed, so it is not created until the first
+    // compile-time expression is run.
     ctx.llvm_engine().runFunction(llvm_function, llvm_generic_ptr);
+    ctx.release_stack_slots(llvm_function);
     llvm_function->eraseFromParent();
 
     return create_constant(llvm_ir, llvm_data_layout, llvm_type, ptr);
@@ -0,0 +1,12 @@
+#include "rain/lang/code/expr/all.hpp"
+
+namespace rain::lang::code {
+
+llvm::Value* compile_continue(Context& ctx, ast::ContinueExpression& continue_) {
+    ctx.end_loop_stack_slots();
+    ctx.llvm_builder().CreateBr(ctx.loop().continue_block);
+    ctx.set_returned(true);
+    return nullptr;
+}
+
+}  // namespace rain::lang::code
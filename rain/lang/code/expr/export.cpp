@@ -1,4 +1,6 @@
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/expr/all.hpp"
+#include "rain/lang/code/type/all.hpp"
 
 namespace rain::lang::code {
 
@@ -9,7 +11,11 @@ llvm::Value* compile_export(Context& ctx, ast::ExportExpression& export_) {
 
     llvm::Function* llvm_function = compile_function(ctx, function);
 
-    llvm_function->setLinkage(llvm::Function::ExternalLinkage);
+    // The host calls the export with its direct signature.
+    auto* llvm_direct_type =
+        static_cast<llvm::FunctionType*>(get_or_compile_type(ctx, *function.function_type()));
+    llvm_function = wrap_with_abi_adapter(ctx, llvm_function, llvm_direct_type,
+                                          HostBoundary::Export, llvm::Function::ExternalLinkage);
     llvm_function->addFnAttr(llvm::Attribute::get(llvm_function->getContext(), "wasm-export-name",
                                                   llvm_function->getName()));
 
@@ -1,4 +1,6 @@
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/expr/all.hpp"
+#include "rain/lang/code/type/all.hpp"
 
 namespace rain::lang::code {
 
@@ -7,10 +9,18 @@ llvm::Value* compile_extern(Context& ctx, ast::ExternExpression& extern_) {
 
     llvm::Function* llvm_function =
         compile_function_declaration(ctx, *extern_.declaration().variable());
-    llvm_function->setLinkage(llvm::Function::ExternalLinkage);
 
-    ctx.options().compile_extern_compile_time_runnable(
+    // The host implements the function with its direct signature.
+    auto* llvm_direct_type = static_cast<llvm::FunctionType*>(
+        get_or_compile_type(ctx, *extern_.declaration().function_type()));
+    llvm_function = wrap_with_abi_adapter(ctx, llvm_function, llvm_direct_type,
+                                          HostBoundary::Extern, llvm::Function::ExternalLinkage);
+
+    auto result = ctx.options().compile_extern_compile_time_runnable(
         ctx, llvm_function, std::span{extern_.keys().begin(), extern_.keys().size()});
+    if (!result.has_value()) {
+        ctx.report_error(std::move(result).error());
+    }
 
     return llvm_function;
 }
@@ -0,0 +1,113 @@
+#include "rain/lang/code/expr/all.hpp"
+#include "rain/lang/code/type/all.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+/**
+ * Emit a loop that counts from `llvm_start` up to (but not including) `llvm_end`, calling `bind`
+ * with the (signed) index at the start of each iteration.
+ *
+ * The loop is emitted in the form that LLVM's loop passes look for: the range is checked once
+ * before entering the loop, the index is a single phi that is incremented (without signed
+ * overflow) in a single latch block, and the latch compares it against the loop invariant end. So
+ * the trip count is known up front, and the loop can be unrolled and vectorized.
+ */
+template <typename BindFn>
+void compile_counted_loop(Context& ctx, ast::ForExpression& for_, llvm::Value* llvm_start,
+                          llvm::Value* llvm_end, const llvm::Twine& name, BindFn&& bind) {
+    auto& llvm_ctx = ctx.llvm_context();
+    auto& llvm_ir  = ctx.llvm_builder();
+
+    llvm::Function* const   llvm_function        = llvm_ir.GetInsertBlock()->getParent();
+    llvm::BasicBlock* const llvm_preheader_block = llvm_ir.GetInsertBlock();
+    llvm::BasicBlock* const llvm_loop_block =
+        llvm::BasicBlock::Create(llvm_ctx, "for", llvm_function);
+    llvm::BasicBlock* const llvm_latch_block =
+        llvm::BasicBlock::Create(llvm_ctx, "fornext", llvm_function);
+    llvm::BasicBlock* const llvm_merge_block =
+        llvm::BasicBlock::Create(llvm_ctx, "endfor", llvm_function);
+
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpSLT(llvm_start, llvm_end), llvm_loop_block,
+                         llvm_merge_block);
+
+    llvm_ir.SetInsertPoint(llvm_loop_block);
+    llvm::PHINode* llvm_index = llvm_ir.CreatePHI(llvm_start->getType(), 2, name);
+    llvm_index->addIncoming(llvm_start, llvm_preheader_block);
+    bind(llvm_index);
+
+    ctx.push_loop(LoopBlocks{.continue_block = llvm_latch_block, .break_block = llvm_merge_block});
+    compile_block(ctx, for_.loop());
+    ctx.pop_loop();
+    if (!ctx.returned()) {
+        llvm_ir.CreateBr(llvm_latch_block);
+    }
+    ctx.set_returned(false);
+
+    // The index is always less than the end when it is incremented, so it cannot overflow.
+    llvm_ir.SetInsertPoint(llvm_latch_block);
+    auto* llvm_next = llvm_ir.CreateNSWAdd(
+        llvm_index, llvm::ConstantInt::get(llvm_index->getType(), 1), name + ".next");
+    llvm_index->addIncoming(llvm_next, llvm_latch_block);
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpSLT(llvm_next, llvm_end), llvm_loop_block,
+                         llvm_merge_block);
+
+    llvm_ir.SetInsertPoint(llvm_merge_block);
+}
+
+}  // namespace
+
+llvm::Value* compile_for(Context& ctx, ast::ForExpression& for_) {
+    auto& llvm_ir = ctx.llvm_builder();
+
+    if (for_.is_range()) {
+        llvm::Value* llvm_start = compile_any_expression(ctx, for_.start());
+        llvm::Value* llvm_end   = compile_any_expression(ctx, for_.end());
+        compile_counted_loop(ctx, for_, llvm_start, llvm_end, for_.name(),
+                             [&](llvm::Value* llvm_index) {
+                                 ctx.set_llvm_value(for_.variable(), llvm_index);
+                             });
+        return nullptr;
+    }
+
+    // Iterate over the elements by index rather than by pointer, which is easier for the loop
+    // passes to reason about (in particular, to compute the trip count).
+    auto&        llvm_data_layout  = ctx.llvm_data_layout();
+    auto&        element_type      = *for_.variable()->type();
+    auto*        llvm_element_type = get_or_compile_type(ctx, element_type);
+    llvm::Value* llvm_iterable     = compile_any_expression(ctx, for_.start());
+
+    llvm::Value* llvm_begin_ptr = nullptr;
+    llvm::Value* llvm_count     = nullptr;
+    if (for_.start().type()->kind() == serial::TypeKind::Slice) {
+        llvm_begin_ptr     = llvm_ir.CreateExtractValue(llvm_iterable, 0);
+        auto* llvm_end_ptr = llvm_ir.CreateExtractValue(llvm_iterable, 1);
+        llvm_count = llvm_ir.CreateSExtOrTrunc(
+            llvm_ir.CreatePtrDiff(llvm_element_type, llvm_end_ptr, llvm_begin_ptr),
+            llvm_data_layout.getIndexType(llvm_begin_ptr->getType()));
+    } else {
+        // Arrays are passed around as a pointer to their first element.
+        auto& array_type = static_cast<ast::ArrayType&>(*for_.start().type());
+        llvm_begin_ptr   = llvm_iterable;
+        llvm_count       = llvm::ConstantInt::get(
+            llvm_data_layout.getIndexType(llvm_begin_ptr->getType()), array_type.length());
+    }
+
+    compile_counted_loop(
+        ctx, for_, llvm::ConstantInt::get(llvm_count->getType(), 0), llvm_count, "index",
+        [&](llvm::Value* llvm_index) {
+            auto* llvm_element_ptr =
+                llvm_ir.CreateInBoundsGEP(llvm_element_type, llvm_begin_ptr, {llvm_index});
+
+            // Like any other variable, arrays are referred to by their address.
+            ctx.set_llvm_value(for_.variable(),
+                               element_type.kind() == serial::TypeKind::Array
+                                   ? llvm_element_ptr
+                                   : llvm_ir.CreateLoad(llvm_element_type, llvm_element_ptr,
+                                                        for_.name()));
+        });
+    return nullptr;
+}
+
+}  // namespace rain::lang::code
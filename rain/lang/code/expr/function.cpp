@@ -1,5 +1,6 @@
 #include "rain/lang/ast/expr/function.hpp"
 
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/expr/all.hpp"
 #include "rain/lang/code/type/all.hpp"
 
@@ -10,22 +11,32 @@ llvm::Function* compile_function(Context& ctx, ast::FunctionExpression& function
         static_cast<llvm::Function*>(ctx.llvm_value(function.variable()));
     assert(llvm_function != nullptr && "Function not found in context");
 
+    if (auto* function_cache = ctx.function_cache();
+        function_cache != nullptr && function_cache->try_reuse(function, *llvm_function)) {
+        // The body will be taken from a previous compile once the rest of the module is done.
+        return llvm_function;
+    }
+
     auto& llvm_ir    = ctx.llvm_builder();
     auto* prev_block = llvm_ir.GetInsertBlock();
 
     llvm::BasicBlock* llvm_block =
         llvm::BasicBlock::Create(ctx.llvm_context(), "entry", llvm_function);
 
+    auto* llvm_function_type =
+        static_cast<llvm::FunctionType*>(get_or_compile_type(ctx, *function.function_type()));
+
     llvm_ir.SetInsertPoint(llvm_block);
+    const auto llvm_arguments = get_abi_arguments(ctx, llvm_function_type, *llvm_function);
     for (int i = 0; i < function.arguments().size(); ++i) {
         auto& argument = function.arguments()[i];
-        ctx.set_llvm_value(argument, llvm_function->arg_begin() + i);
+        ctx.set_llvm_value(argument, llvm_arguments[i]);
     }
 
     llvm::Value* llvm_return_value = compile_block(ctx, *function.block());
     if (auto* function_return_type = function.function_type()->return_type();
         function_return_type == nullptr) {
-        llvm_ir.CreateRetVoid();
+        create_abi_return(ctx, llvm_function_type, *llvm_function, nullptr);
     } else {
         ast::Type* block_result_type = function.block()->type();
 
@@ -62,10 +73,15 @@ llvm::Function* compile_function(Context& ctx, ast::FunctionExpression& function
             }
         } while (false);
 
-        llvm_ir.CreateRet(llvm_return_value);
+        create_abi_return(ctx, llvm_function_type, *llvm_function, llvm_return_value);
     }
 
     llvm_ir.SetInsertPoint(prev_block);
+    ctx.release_stack_slots(llvm_function);
+
+    if (ctx.options().tail_calls()) {
+        mark_tail_calls(ctx, *llvm_function);
+    }
 
     return llvm_function;
 }
@@ -1,4 +1,5 @@
 #include "rain/lang/ast/expr/function.hpp"
+#include "rain/lang/code/abi.hpp"
 #include "rain/lang/code/expr/all.hpp"
 #include "rain/lang/code/type/all.hpp"
 
@@ -17,16 +18,11 @@ llvm::Function* compile_function_declaration(Context&               ctx,
     auto* llvm_type = static_cast<llvm::FunctionType*>(get_or_compile_type(ctx, *function_type));
     assert(llvm_type != nullptr && "llvm function type not found");
 
-    std::string name;
-    if (function_type->callee_type() != nullptr) {
-        name = absl::StrCat(function_type->callee_type()->display_name(), ".",
-                            function_variable.name());
-    } else {
-        name = std::string(function_variable.name());
-    }
+    const auto name = function_symbol_name(function_variable.name(), *function_type,
+                                           ctx.is_overloaded(&function_variable));
 
     llvm::Function* llvm_function =
-        llvm::Function::Create(llvm_type, llvm::Function::InternalLinkage, name, ctx.llvm_module());
+        create_abi_function(ctx, llvm_type, llvm::Function::InternalLinkage, name);
     ctx.set_llvm_value(&function_variable, llvm_function);
 
     return llvm_function;
@@ -47,18 +43,14 @@ llvm::Function* compile_function_declaration(
     auto* llvm_type = static_cast<llvm::FunctionType*>(get_or_compile_type(ctx, *function_type));
     assert(llvm_type != nullptr && "llvm function type not found");
 
-    std::string name;
-    if (function_type->callee_type() != nullptr) {
-        name = absl::StrCat(function_type->callee_type()->display_name(), ".",
-                            function_declaration.name());
-    } else {
-        name = std::string(function_declaration.name());
-    }
+    const auto* function_variable = function_declaration.variable();
+    const auto  name =
+        function_symbol_name(function_declaration.name(), *function_type,
+                             function_variable != nullptr && ctx.is_overloaded(function_variable));
 
     llvm::Function* llvm_function =
-        llvm::Function::Create(llvm_type, llvm::Function::InternalLinkage, name, ctx.llvm_module());
-    if (const auto* function_variable = function_declaration.variable();
-        function_variable != nullptr) {
+        create_abi_function(ctx, llvm_type, llvm::Function::InternalLinkage, name);
+    if (function_variable != nullptr) {
         ctx.set_llvm_value(function_variable, llvm_function);
     }
 
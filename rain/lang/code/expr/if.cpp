@@ -9,7 +9,7 @@ llvm::Value* compile_if(Context& ctx, ast::IfExpression& if_) {
 
     auto& llvm_ctx  = ctx.llvm_context();
     auto& llvm_ir   = ctx.llvm_builder();
-    auto* llvm_type = get_or_compile_type(ctx, *if_.type());
+    auto* llvm_type = if_.type() != nullptr ? get_or_compile_type(ctx, *if_.type()) : nullptr;
 
     llvm::Function* const   llvm_function = llvm_ir.GetInsertBlock()->getParent();
     llvm::BasicBlock* const llvm_then_block =
@@ -23,13 +23,14 @@ llvm::Value* compile_if(Context& ctx, ast::IfExpression& if_) {
 
     llvm_ir.SetInsertPoint(llvm_then_block);
     llvm::Value* llvm_then_result = compile_block(ctx, if_.then());
-    if (if_.type() != if_.then().type()) {
+    if (llvm_type != nullptr && if_.type() != if_.then().type() && !ctx.returned()) {
         llvm_then_result = util::create_optional_literal(ctx, llvm_type, llvm_then_result);
     }
     if (!ctx.returned()) {
         llvm_ir.CreateBr(llvm_merge_block);
     }
-    const bool then_returned = ctx.returned();
+    const bool then_returned         = ctx.returned();
+    auto*      llvm_found_then_block = llvm_ir.GetInsertBlock();
     ctx.set_returned(false);
 
     llvm_ir.SetInsertPoint(llvm_else_block);
@@ -42,37 +43,48 @@ llvm::Value* compile_if(Context& ctx, ast::IfExpression& if_) {
         llvm_ir.CreateBr(llvm_merge_block);
     }
 
-    ctx.set_returned(then_returned && ctx.returned());
+    const bool else_returned = ctx.returned();
+    ctx.set_returned(then_returned && else_returned);
 
     // We can't assume that the saved else block is the one that actually got us to the merge block.
     // For example, an if expression within the original else block results in a new else block.
     auto* llvm_found_else_block = llvm_ir.GetInsertBlock();
     llvm_ir.SetInsertPoint(llvm_merge_block);
 
-    if (if_.has_else() && !ctx.returned()) {
+    // There is no value to merge if neither branch reaches the merge block (they both `break` or
+    // `continue` out of a loop). Otherwise only the branches that do reach it are merged.
+    if (llvm_type == nullptr || ctx.returned()) {
+        return nullptr;
+    }
+
+    if (if_.has_else()) {
         // TODO: This is a temporary hack to avoid properly having to support the case where the if
         // expression shuold return an optional value.
-        if (llvm_then_result == nullptr || llvm_else_result == nullptr) {
+        if ((!then_returned && llvm_then_result == nullptr) ||
+            (!else_returned && llvm_else_result == nullptr)) {
             return nullptr;
         }
 
-        llvm::Type* const llvm_type   = llvm_then_result->getType();
-        llvm::PHINode*    llvm_result = llvm_ir.CreatePHI(llvm_type, 2);
-        llvm_result->addIncoming(llvm_then_result, llvm_then_block);
-        llvm_result->addIncoming(llvm_else_result, llvm_found_else_block);
+        llvm::Type* const llvm_type =
+            (then_returned ? llvm_else_result : llvm_then_result)->getType();
+        llvm::PHINode* llvm_result = llvm_ir.CreatePHI(llvm_type, 2);
+        if (!then_returned) {
+            llvm_result->addIncoming(llvm_then_result, llvm_found_then_block);
+        }
+        if (!else_returned) {
+            llvm_result->addIncoming(llvm_else_result, llvm_found_else_block);
+        }
         return llvm_result;
     }
 
-    if (!if_.has_else() && !ctx.returned()) {
-        llvm_else_result = llvm::Constant::getNullValue(llvm_type);
+    llvm_else_result = llvm::Constant::getNullValue(llvm_type);
 
-        llvm::PHINode* llvm_result = llvm_ir.CreatePHI(llvm_type, 2);
-        llvm_result->addIncoming(llvm_then_result, llvm_then_block);
-        llvm_result->addIncoming(llvm_else_result, llvm_found_else_block);
-        return llvm_result;
+    llvm::PHINode* llvm_result = llvm_ir.CreatePHI(llvm_type, 2);
+    if (!then_returned) {
+        llvm_result->addIncoming(llvm_then_result, llvm_found_then_block);
     }
-
-    return nullptr;
+    llvm_result->addIncoming(llvm_else_result, llvm_found_else_block);
+    return llvm_result;
 }
 
 }  // namespace rain::lang::code
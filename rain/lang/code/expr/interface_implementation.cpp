@@ -0,0 +1,15 @@
+#include "rain/lang/ast/expr/interface_implementation.hpp"
+
+#include "rain/lang/code/expr/all.hpp"
+
+namespace rain::lang::code {
+
+void compile_interface_implementation(Context&                                ctx,
+                                      ast::InterfaceImplementationExpression& implementation) {
+    // The vtbl is only created once a value is cast into the interface.
+    for (const auto& method : implementation.methods()) {
+        compile_function(ctx, *method);
+    }
+}
+
+}  // namespace rain::lang::code
@@ -10,16 +10,16 @@ llvm::Value* compile_let(Context& ctx, ast::LetExpression& let) {
     auto* llvm_type = ctx.llvm_type(let.type());
 
     if (!let.global()) [[likely]] {
-        auto* llvm_alloca = llvm_ir.CreateAlloca(llvm_type, nullptr, let.name());
+        auto* llvm_alloca = ctx.create_stack_slot(llvm_type, let.name());
         ctx.set_llvm_value(let.variable(), llvm_alloca);
 
         if (let.value().type()->kind() == serial::TypeKind::Array) {
-            auto& llvm_data_layout  = ctx.llvm_engine().getDataLayout();
+            auto& llvm_data_layout  = ctx.llvm_data_layout();
             auto* llvm_array_type   = get_or_compile_type(ctx, *let.value().type());
             auto* llvm_element_type = llvm_array_type->getArrayElementType();
             auto  llvm_alignment    = llvm_data_layout.getABITypeAlign(llvm_element_type);
             auto  llvm_sizeof =
-                llvm_ir.getInt32(llvm_data_layout.getTypeAllocSize(llvm_element_type));
+                llvm_ir.getInt32(llvm_data_layout.getTypeAllocSize(llvm_array_type));
 
             llvm_ir.CreateMemCpy(llvm_alloca, llvm_alignment, llvm_value, llvm_alignment,
                                  llvm_sizeof);
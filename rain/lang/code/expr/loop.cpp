@@ -0,0 +1,36 @@
+#include "rain/lang/code/expr/all.hpp"
+
+namespace rain::lang::code {
+
+llvm::Value* compile_loop(Context& ctx, ast::LoopExpression& loop) {
+    auto& llvm_ctx = ctx.llvm_context();
+    auto& llvm_ir  = ctx.llvm_builder();
+
+    llvm::Function* const   llvm_function = llvm_ir.GetInsertBlock()->getParent();
+    llvm::BasicBlock* const llvm_loop_block =
+        llvm::BasicBlock::Create(llvm_ctx, "loop", llvm_function);
+    llvm::BasicBlock* const llvm_latch_block =
+        llvm::BasicBlock::Create(llvm_ctx, "loopnext", llvm_function);
+    llvm::BasicBlock* const llvm_merge_block =
+        llvm::BasicBlock::Create(llvm_ctx, "endloop", llvm_function);
+
+    llvm_ir.CreateBr(llvm_loop_block);
+
+    llvm_ir.SetInsertPoint(llvm_loop_block);
+    ctx.push_loop(LoopBlocks{.continue_block = llvm_latch_block, .break_block = llvm_merge_block});
+    compile_block(ctx, loop.loop());
+    ctx.pop_loop();
+    if (!ctx.returned()) {
+        llvm_ir.CreateBr(llvm_latch_block);
+    }
+    ctx.set_returned(false);
+
+    llvm_ir.SetInsertPoint(llvm_latch_block);
+    llvm_ir.CreateBr(llvm_loop_block);
+
+    // This is only reachable through a `break`.
+    llvm_ir.SetInsertPoint(llvm_merge_block);
+    return nullptr;
+}
+
+}  // namespace rain::lang::code
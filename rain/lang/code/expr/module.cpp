@@ -1,56 +1,101 @@
+#include "rain/lang/ast/type/interface.hpp"
 #include "rain/lang/code/expr/all.hpp"
+#include "rain/lang/code/interface.hpp"
 #include "rain/lang/code/type/all.hpp"
 
 namespace rain::lang::code {
 
-void compile_module(Context& ctx, ast::Module& module) {
-    {
-        // Handle all builtin scope types and functions.
-        ast::BuiltinScope& builtin = *module.scope().builtin();
-
-        auto* llvm_f32_type = llvm::Type::getFloatTy(ctx.llvm_context());
-
-        ctx.set_llvm_type(builtin.bool_type(), llvm::Type::getInt1Ty(ctx.llvm_context()));
-        ctx.set_llvm_type(builtin.u8_type(), llvm::Type::getInt8Ty(ctx.llvm_context()));
-        ctx.set_llvm_type(builtin.i32_type(), llvm::Type::getInt32Ty(ctx.llvm_context()));
-        ctx.set_llvm_type(builtin.i64_type(), llvm::Type::getInt64Ty(ctx.llvm_context()));
-        ctx.set_llvm_type(builtin.f32_type(), llvm_f32_type);
-        ctx.set_llvm_type(builtin.f64_type(), llvm::Type::getDoubleTy(ctx.llvm_context()));
-        ctx.set_llvm_type(builtin.f32x4_type(), llvm::FixedVectorType::get(llvm_f32_type, 4));
-
-        for (auto& type : builtin.owned_types()) {
-            assert(type != nullptr && "type is null");
-            get_or_compile_type(ctx, *type);
-        }
+namespace {
+
+void compile_builtin_scope(Context& ctx, ast::BuiltinScope& builtin) {
+    auto* llvm_u8_type  = llvm::Type::getInt8Ty(ctx.llvm_context());
+    auto* llvm_i16_type = llvm::Type::getInt16Ty(ctx.llvm_context());
+    auto* llvm_i32_type = llvm::Type::getInt32Ty(ctx.llvm_context());
+    auto* llvm_f32_type = llvm::Type::getFloatTy(ctx.llvm_context());
+    auto* llvm_f64_type = llvm::Type::getDoubleTy(ctx.llvm_context());
+
+    ctx.set_llvm_type(builtin.bool_type(), llvm::Type::getInt1Ty(ctx.llvm_context()));
+    ctx.set_llvm_type(builtin.u8_type(), llvm_u8_type);
+    ctx.set_llvm_type(builtin.i16_type(), llvm_i16_type);
+    ctx.set_llvm_type(builtin.i32_type(), llvm_i32_type);
+    ctx.set_llvm_type(builtin.i64_type(), llvm::Type::getInt64Ty(ctx.llvm_context()));
+    ctx.set_llvm_type(builtin.f32_type(), llvm_f32_type);
+    ctx.set_llvm_type(builtin.f64_type(), llvm_f64_type);
+
+    // Every SIMD type fills a single 128-bit vector (a wasm v128).
+    ctx.set_llvm_type(builtin.f32x4_type(), llvm::FixedVectorType::get(llvm_f32_type, 4));
+    ctx.set_llvm_type(builtin.f64x2_type(), llvm::FixedVectorType::get(llvm_f64_type, 2));
+    ctx.set_llvm_type(builtin.i16x8_type(), llvm::FixedVectorType::get(llvm_i16_type, 8));
+    ctx.set_llvm_type(builtin.i32x4_type(), llvm::FixedVectorType::get(llvm_i32_type, 4));
+    ctx.set_llvm_type(builtin.u32x4_type(), llvm::FixedVectorType::get(llvm_i32_type, 4));
+    ctx.set_llvm_type(builtin.u8x16_type(), llvm::FixedVectorType::get(llvm_u8_type, 16));
+
+    for (auto& type : builtin.owned_types()) {
+        assert(type != nullptr && "type is null");
+        get_or_compile_type(ctx, *type);
+    }
 
-        for (auto& external_function : builtin.external_functions()) {
-            auto* llvm_function_type =
-                reinterpret_cast<llvm::FunctionType*>(ctx.llvm_type(external_function->type()));
+    for (auto& external_function : builtin.external_functions()) {
+        auto* llvm_function_type =
+            reinterpret_cast<llvm::FunctionType*>(ctx.llvm_type(external_function->type()));
 
-            auto* llvm_function =
-                llvm::Function::Create(llvm_function_type, llvm::Function::ExternalLinkage,
-                                       external_function->name(), ctx.llvm_module());
+        auto* llvm_function =
+            llvm::Function::Create(llvm_function_type, llvm::Function::ExternalLinkage,
+                                   external_function->name(), ctx.llvm_module());
 
-            llvm_function->addFnAttr(llvm::Attribute::get(ctx.llvm_context(), "wasm-import-module",
-                                                          external_function->wasm_namespace()));
-            llvm_function->addFnAttr(llvm::Attribute::get(ctx.llvm_context(), "wasm-import-name",
-                                                          external_function->wasm_function_name()));
+        llvm_function->addFnAttr(llvm::Attribute::get(ctx.llvm_context(), "wasm-import-module",
+                                                      external_function->wasm_namespace()));
+        llvm_function->addFnAttr(llvm::Attribute::get(ctx.llvm_context(), "wasm-import-name",
+                                                      external_function->wasm_function_name()));
 
-            ctx.set_llvm_value(external_function.get(), llvm_function);
-        }
+        ctx.set_llvm_value(external_function.get(), llvm_function);
     }
+}
+
+void compile_module_declarations(Context& ctx, ast::Module& module) {
+    // Handle all module scoped types and functions.
+    for (auto& type : module.scope().owned_types()) {
+        get_or_compile_type(ctx, *type);
+    }
+
+    // This includes any functions imported from other modules, which will already have been
+    // declared when their own module was compiled.
+    ctx.add_overloaded_functions(find_overloaded_functions(module.scope()));
+    module.scope().for_each_function([&ctx](ast::FunctionVariable& function_variable) {
+        // Builtin functions generate their code wherever they are called.
+        if (function_variable.is_builtin()) {
+            return;
+        }
 
-    {
-        // Handle all module scoped types and functions.
-        for (auto& type : module.scope().owned_types()) {
-            get_or_compile_type(ctx, *type);
+        // Interface methods are called through a vtbl, which only needs their type.
+        if (auto* callee_type = function_variable.function_type()->callee_type();
+            callee_type != nullptr && callee_type->kind() == serial::TypeKind::Interface &&
+            static_cast<ast::InterfaceType*>(callee_type)->find_method(function_variable)) {
+            get_or_compile_type(ctx, *function_variable.function_type());
+            return;
         }
 
-        module.scope().for_each_function([&ctx](ast::FunctionVariable& function_variable) {
-            compile_function_declaration(ctx, function_variable);
-        });
+        compile_function_declaration(ctx, function_variable);
+    });
+
+    for (const auto& expression : module.expressions()) {
+        if (expression->kind() != serial::ExpressionKind::Implementation) {
+            continue;
+        }
+
+        const auto& implementation =
+            static_cast<const ast::InterfaceImplementationExpression&>(*expression);
+        ctx.add_implementation(implementation);
+
+        // Calls may be devirtualized to any of the vtbl's entries (some of which are adapters that
+        // the vtbl creates), so make it even if no function body that is generated does.
+        if (ctx.options().whole_program_devirtualization()) {
+            get_or_create_vtbl(ctx, implementation);
+        }
     }
+}
 
+void compile_module_expressions(Context& ctx, ast::Module& module) {
     for (const auto& expression : module.expressions()) {
         switch (expression->kind()) {
             case serial::ExpressionKind::Type:
@@ -70,6 +115,11 @@ void compile_module(Context& ctx, ast::Module& module) {
                 compile_let(ctx, static_cast<ast::LetExpression&>(*expression));
                 break;
 
+            case serial::ExpressionKind::Implementation:
+                compile_interface_implementation(
+                    ctx, static_cast<ast::InterfaceImplementationExpression&>(*expression));
+                break;
+
             default:
                 util::panic("failed to compile top-level expression: unknown expression kind: ",
                             static_cast<int>(expression->kind()), "; this is an internal error");
@@ -77,4 +127,52 @@ void compile_module(Context& ctx, ast::Module& module) {
     }
 }
 
+// Record the target CPU and features on every function, so that they are kept when the module is
+// passed along as bitcode and compiled later on, for example by the linker.
+void add_target_attributes(Context& ctx) {
+    const auto& llvm_target_machine = ctx.llvm_target_machine();
+    const auto  cpu                 = llvm_target_machine.getTargetCPU();
+    const auto  features            = llvm_target_machine.getTargetFeatureString();
+
+    for (auto& llvm_function : ctx.llvm_module()) {
+        if (llvm_function.isDeclaration()) {
+            continue;
+        }
+        if (!cpu.empty()) {
+            llvm_function.addFnAttr("target-cpu", cpu);
+        }
+        if (!features.empty()) {
+            llvm_function.addFnAttr("target-features", features);
+        }
+    }
+}
+
+}  // namespace
+
+void compile_module(Context& ctx, ast::Module& module) {
+    compile_builtin_scope(ctx, *module.scope().builtin());
+    compile_module_declarations(ctx, module);
+    compile_module_expressions(ctx, module);
+    add_target_attributes(ctx);
+}
+
+void compile_modules(Context& ctx, std::span<const absl::Nonnull<ast::Module*>> modules) {
+    if (modules.empty()) {
+        return;
+    }
+
+    // All of the modules must share the same builtin scope.
+    compile_builtin_scope(ctx, *modules.front()->scope().builtin());
+
+    // Declare everything up front, so that the order that the function bodies are compiled in
+    // does not matter.
+    for (auto* module : modules) {
+        compile_module_declarations(ctx, *module);
+    }
+    for (auto* module : modules) {
+        compile_module_expressions(ctx, *module);
+    }
+    add_target_attributes(ctx);
+}
+
 }  // namespace rain::lang::code
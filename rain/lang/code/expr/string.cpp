@@ -12,9 +12,7 @@ llvm::Value* compile_string(Context& ctx, ast::StringExpression& string) {
 
     auto* llvm_string =
         llvm::ConstantDataArray::getString(ctx.llvm_context(), string.value(), false);
-    auto* llvm_string_global =
-        new llvm::GlobalVariable(ctx.llvm_module(), llvm_string->getType(), true,
-                                 llvm::GlobalValue::InternalLinkage, llvm_string, "const.string");
+    auto* llvm_string_global = ctx.get_or_create_constant_global(llvm_string, "const.string");
 
     auto* llvm_begin_ptr = llvm::ConstantExpr::getGetElementPtr(
         llvm_ir.getInt8Ty(), llvm_string_global, llvm_ir.getInt32(0));
@@ -11,6 +11,8 @@ llvm::Value* compile_while(Context& ctx, ast::WhileExpression& while_) {
     llvm::Function* const   llvm_function = llvm_ir.GetInsertBlock()->getParent();
     llvm::BasicBlock* const llvm_loop_block =
         llvm::BasicBlock::Create(llvm_ctx, "loop", llvm_function);
+    llvm::BasicBlock* const llvm_latch_block =
+        llvm::BasicBlock::Create(llvm_ctx, "whilecond", llvm_function);
     llvm::BasicBlock* const llvm_else_block =
         llvm::BasicBlock::Create(llvm_ctx, "else", llvm_function);
     llvm::BasicBlock* const llvm_merge_block =
@@ -18,38 +20,63 @@ llvm::Value* compile_while(Context& ctx, ast::WhileExpression& while_) {
 
     llvm_ir.CreateCondBr(llvm_condition, llvm_loop_block, llvm_else_block);
 
+    // The end of the body and every `continue` go through the same block to check the condition
+    // again, so that the loop has a single latch (as LLVM's loop passes expect).
     llvm_ir.SetInsertPoint(llvm_loop_block);
+    ctx.push_loop(LoopBlocks{.continue_block = llvm_latch_block, .break_block = llvm_merge_block});
     llvm::Value* llvm_loop_result = compile_block(ctx, while_.loop());
-    if (!ctx.returned()) {
-        llvm::Value* llvm_loop_again_condition = compile_any_expression(ctx, while_.condition());
-        llvm_ir.CreateCondBr(llvm_loop_again_condition, llvm_loop_block, llvm_merge_block);
-    }
+    ctx.pop_loop();
     const bool loop_returned = ctx.returned();
+    if (!loop_returned) {
+        llvm_ir.CreateBr(llvm_latch_block);
+    }
     ctx.set_returned(false);
 
+    // The condition may be split over several blocks (with `&&` or `||`), so the block that leaves
+    // the loop is the one that the condition ends in.
+    llvm_ir.SetInsertPoint(llvm_latch_block);
+    llvm::Value* llvm_loop_again_condition = compile_any_expression(ctx, while_.condition());
+    llvm_ir.CreateCondBr(llvm_loop_again_condition, llvm_loop_block, llvm_merge_block);
+    auto* llvm_found_latch_block = llvm_ir.GetInsertBlock();
+
     llvm_ir.SetInsertPoint(llvm_else_block);
 
     llvm::Value* llvm_else_result = nullptr;
     if (while_.has_else()) {
         llvm_else_result = compile_block(ctx, while_.else_());
     }
-    if (!ctx.returned()) {
+    const bool else_returned = ctx.returned();
+    if (!else_returned) {
         llvm_ir.CreateBr(llvm_merge_block);
     }
+    auto* llvm_found_else_block = llvm_ir.GetInsertBlock();
 
-    ctx.set_returned(loop_returned && ctx.returned());
+    // The latch always leaves the loop when the condition no longer holds, so the merge block is
+    // always reachable.
+    ctx.set_returned(false);
 
     llvm_ir.SetInsertPoint(llvm_merge_block);
 
-    if (while_.has_else() && !ctx.returned()) {
-        llvm::Type* const llvm_type   = llvm_else_result->getType();
-        llvm::PHINode*    llvm_result = llvm_ir.CreatePHI(llvm_type, 2);
-        llvm_result->addIncoming(llvm_loop_result, llvm_loop_block);
-        llvm_result->addIncoming(llvm_else_result, llvm_else_block);
-        return llvm_result;
-    } else {
+    if (while_.type() == nullptr) {
         return nullptr;
     }
+
+    // Validation only gives a while-else a value if its loop has no `break` or `continue`, so the
+    // merge block is only reached through the latch (right after the end of the body) and through
+    // the end of the else block. When the body always returns, the latch is never reached.
+    if (loop_returned && else_returned) {
+        return nullptr;
+    }
+
+    llvm::Value* const llvm_any_result = loop_returned ? llvm_else_result : llvm_loop_result;
+    llvm::Type* const  llvm_type       = llvm_any_result->getType();
+    llvm::PHINode*     llvm_result     = llvm_ir.CreatePHI(llvm_type, 2);
+    llvm_result->addIncoming(loop_returned ? llvm::PoisonValue::get(llvm_type) : llvm_loop_result,
+                             llvm_found_latch_block);
+    if (!else_returned) {
+        llvm_result->addIncoming(llvm_else_result, llvm_found_else_block);
+    }
+    return llvm_result;
 }
 
 }  // namespace rain::lang::code
@@ -0,0 +1,503 @@
+#include "rain/lang/code/incremental.hpp"
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Linker/Linker.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include "rain/lang/ast/expr/array_literal.hpp"
+#include "rain/lang/ast/expr/binary_operator.hpp"
+#include "rain/lang/ast/expr/block.hpp"
+#include "rain/lang/ast/expr/call.hpp"
+#include "rain/lang/ast/expr/cast.hpp"
+#include "rain/lang/ast/expr/compile_time.hpp"
+#include "rain/lang/ast/expr/export.hpp"
+#include "rain/lang/ast/expr/for.hpp"
+#include "rain/lang/ast/expr/if.hpp"
+#include "rain/lang/ast/expr/let.hpp"
+#include "rain/lang/ast/expr/loop.hpp"
+#include "rain/lang/ast/expr/member.hpp"
+#include "rain/lang/ast/expr/parenthesis.hpp"
+#include "rain/lang/ast/expr/slice_literal.hpp"
+#include "rain/lang/ast/expr/struct_literal.hpp"
+#include "rain/lang/ast/expr/unary_operator.hpp"
+#include "rain/lang/ast/expr/while.hpp"
+#include "rain/lang/err/simple.hpp"
+#include "rain/lang/lex/lazy.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+/**
+ * Append the text of every token in the location, separated by a NUL character.
+ *
+ * Hashing tokens rather than the raw source text means that whitespace and comment changes do
+ * not invalidate a function.
+ */
+void append_tokens(std::string& out, const lex::Location& location) {
+    auto lexer = lex::LazyLexer::using_source(location.text(), location.file_name);
+    for (auto token = lexer.next(); token.kind != lex::TokenKind::EndOfFile; token = lexer.next()) {
+        out.append(token.text());
+        out.push_back('\0');
+    }
+}
+
+struct Visitor {
+    FunctionGraph::Node& node;
+    bool&                has_compile_time;
+
+    void visit(const ast::Expression& expression) {
+        switch (expression.kind()) {
+            case serial::ExpressionKind::Call: {
+                const auto& call = static_cast<const ast::CallExpression&>(expression);
+                if (call.function() != nullptr) {
+                    node.callees.insert(FunctionGraph::key(*call.function()));
+                }
+                visit(call.callee());
+                for (const auto& argument : call.arguments()) {
+                    visit(*argument);
+                }
+                break;
+            }
+
+            case serial::ExpressionKind::StructLiteral:
+                for (const auto& field :
+                     static_cast<const ast::StructLiteralExpression&>(expression).fields()) {
+                    visit(*field.value);
+                }
+                break;
+
+            case serial::ExpressionKind::ArrayLiteral:
+                for (const auto& element :
+                     static_cast<const ast::ArrayLiteralExpression&>(expression).elements()) {
+                    visit(*element);
+                }
+                break;
+
+            case serial::ExpressionKind::SliceLiteral:
+                for (const auto& element :
+                     static_cast<const ast::SliceLiteralExpression&>(expression).elements()) {
+                    visit(*element);
+                }
+                break;
+
+            case serial::ExpressionKind::CompileTime:
+                has_compile_time = true;
+                visit(static_cast<const ast::CompileTimeExpression&>(expression).expression());
+                break;
+
+            case serial::ExpressionKind::Member:
+                visit(static_cast<const ast::MemberExpression&>(expression).lhs());
+                break;
+
+            case serial::ExpressionKind::UnaryOperator:
+                visit(static_cast<const ast::UnaryOperatorExpression&>(expression).expression());
+                break;
+
+            case serial::ExpressionKind::BinaryOperator: {
+                const auto& binop = static_cast<const ast::BinaryOperatorExpression&>(expression);
+                visit(binop.lhs());
+                visit(binop.rhs());
+                break;
+            }
+
+            case serial::ExpressionKind::Parenthesis:
+                visit(static_cast<const ast::ParenthesisExpression&>(expression).expression());
+                break;
+
+            case serial::ExpressionKind::Cast:
+                // The vtbls of interface values are only generated as part of the functions that
+                // make them.
+                if (const auto* type = expression.type();
+                    type != nullptr && type->kind() == serial::TypeKind::Interface) {
+                    node.reusable = false;
+                }
+                visit(static_cast<const ast::CastExpression&>(expression).expression());
+                break;
+
+            case serial::ExpressionKind::Block:
+                for (const auto& inner :
+                     static_cast<const ast::BlockExpression&>(expression).expressions()) {
+                    visit(*inner);
+                }
+                break;
+
+            case serial::ExpressionKind::If: {
+                const auto& if_ = static_cast<const ast::IfExpression&>(expression);
+                visit(if_.condition());
+                visit(if_.then());
+                if (if_.has_else()) {
+                    visit(if_.else_());
+                }
+                break;
+            }
+
+            case serial::ExpressionKind::While: {
+                const auto& while_ = static_cast<const ast::WhileExpression&>(expression);
+                visit(while_.condition());
+                visit(while_.loop());
+                if (while_.has_else()) {
+                    visit(while_.else_());
+                }
+                break;
+            }
+
+            case serial::ExpressionKind::For: {
+                const auto& for_ = static_cast<const ast::ForExpression&>(expression);
+                visit(for_.start());
+                if (for_.is_range()) {
+                    visit(for_.end());
+                }
+                visit(for_.loop());
+                break;
+            }
+
+            case serial::ExpressionKind::Loop:
+                visit(static_cast<const ast::LoopExpression&>(expression).loop());
+                break;
+
+            case serial::ExpressionKind::Let:
+                visit(static_cast<const ast::LetExpression&>(expression).value());
+                break;
+
+            case serial::ExpressionKind::Function:
+            case serial::ExpressionKind::Method:
+                // Nested functions are only generated as part of their parent function.
+                node.reusable = false;
+                visit(*static_cast<const ast::FunctionExpression&>(expression).block());
+                break;
+
+            default:
+                break;
+        }
+    }
+};
+
+absl::Nullable<const ast::FunctionExpression*> top_level_function(
+    const ast::Expression& expression) {
+    switch (expression.kind()) {
+        case serial::ExpressionKind::Function:
+        case serial::ExpressionKind::Method:
+            return static_cast<const ast::FunctionExpression*>(&expression);
+
+        case serial::ExpressionKind::Export:
+            return top_level_function(
+                static_cast<const ast::ExportExpression&>(expression).expression());
+
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace
+
+std::string FunctionGraph::key(const ast::FunctionVariable& function) {
+    // The display name of the function type includes the callee type for methods, and the
+    // argument types to distinguish between overloads.
+    return absl::StrCat(function.name(), ":", function.function_type()->display_name());
+}
+
+std::string target_fingerprint(const Options&             options,
+                               const llvm::TargetMachine& llvm_target_machine) {
+    std::string fingerprint = absl::StrCat(
+        llvm_target_machine.getTargetTriple().str(), ";", llvm_target_machine.getTargetCPU().str(),
+        ";", llvm_target_machine.getTargetFeatureString().str(), ";");
+    if (const auto features = options.target_features(); features.has_value()) {
+        for (const auto& feature : *features) {
+            absl::StrAppend(&fingerprint, feature, ",");
+        }
+    }
+    absl::StrAppend(&fingerprint, ";shared_memory=", options.shared_memory() ? 1 : 0,
+                    ";tail_calls=", options.tail_calls() ? 1 : 0, ";whole_program_devirtualization=",
+                    options.whole_program_devirtualization() ? 1 : 0);
+    return fingerprint;
+}
+
+absl::flat_hash_set<const ast::FunctionVariable*> find_overloaded_functions(
+    const ast::Scope& scope) {
+    using Key = std::pair<std::string_view, const ast::Type*>;
+    const auto key = [](const ast::FunctionVariable& function_variable) {
+        return Key(function_variable.name(), function_variable.function_type()->callee_type());
+    };
+
+    absl::flat_hash_map<Key, int> counts;
+    scope.for_each_function(
+        [&](const ast::FunctionVariable& function_variable) { ++counts[key(function_variable)]; });
+
+    absl::flat_hash_set<const ast::FunctionVariable*> overloaded;
+    scope.for_each_function([&](const ast::FunctionVariable& function_variable) {
+        if (counts[key(function_variable)] > 1) {
+            overloaded.insert(&function_variable);
+        }
+    });
+    return overloaded;
+}
+
+std::string function_symbol_name(const std::string_view   name,
+                                 const ast::FunctionType& function_type,
+                                 const bool               overloaded) {
+    std::string symbol;
+    if (function_type.callee_type() != nullptr) {
+        symbol = absl::StrCat(function_type.callee_type()->display_name(), ".", name);
+    } else {
+        symbol = std::string(name);
+    }
+
+    // Overloads are only told apart by their argument types. Spelling those out keeps the symbol
+    // of each overload the same no matter what order they are declared in, which cached function
+    // bodies rely on to link against each other.
+    if (overloaded) {
+        symbol.push_back('(');
+        for (size_t i = 0; i < function_type.argument_types().size(); ++i) {
+            if (i > 0) {
+                symbol.append(", ");
+            }
+            symbol.append(function_type.argument_types()[i]->display_name());
+        }
+        symbol.push_back(')');
+    }
+    return symbol;
+}
+
+FunctionGraph FunctionGraph::build(const ast::Module& module, const std::string_view fingerprint) {
+    FunctionGraph graph;
+
+    // Everything that is not a function (types, globals, externs, and so on) is shared by all
+    // functions in the module, as any of it may affect the code generated for them. So are the
+    // target and options.
+    std::string declarations(fingerprint);
+    declarations.push_back('\0');
+    for (const auto& expression : module.expressions()) {
+        if (top_level_function(*expression) != nullptr) {
+            continue;
+        }
+
+        append_tokens(declarations, expression->location());
+
+        // Global initializers may also contain compile-time expressions.
+        Node    unused;
+        Visitor visitor{.node = unused, .has_compile_time = graph._has_compile_time};
+        visitor.visit(*expression);
+    }
+
+    // Cached bitcode refers to other functions by their symbol names, which change when a function
+    // gains or loses an overload (even though its key does not).
+    absl::flat_hash_map<std::string, std::string> symbols;
+    const auto overloaded = find_overloaded_functions(module.scope());
+    module.scope().for_each_function([&](const ast::FunctionVariable& function_variable) {
+        symbols.emplace(key(function_variable),
+                        function_symbol_name(function_variable.name(),
+                                             *function_variable.function_type(),
+                                             overloaded.contains(&function_variable)));
+    });
+    const auto append_symbol = [&symbols](std::string& out, const std::string_view function_key) {
+        if (const auto it = symbols.find(function_key); it != symbols.end()) {
+            out.append(it->second);
+        }
+        out.push_back('\0');
+    };
+
+    for (const auto& expression : module.expressions()) {
+        const auto* function = top_level_function(*expression);
+        if (function == nullptr || function->variable() == nullptr) {
+            continue;
+        }
+
+        auto& node = graph._nodes[key(*function->variable())];
+
+        Visitor visitor{.node = node, .has_compile_time = graph._has_compile_time};
+        visitor.visit(*function->block());
+
+        std::string contents = declarations;
+        if (expression->kind() == serial::ExpressionKind::Export) {
+            contents.append("export");
+            contents.push_back('\0');
+        }
+        append_tokens(contents, function->location());
+        append_symbol(contents, key(*function->variable()));
+
+        // The callee keys contain the resolved signatures, and their symbols are what the cached
+        // code links against, which is all that the generated code of the caller depends on. Sort
+        // them so that the hash does not depend on the iteration order of the set.
+        std::vector<std::string_view> callees(node.callees.begin(), node.callees.end());
+        std::sort(callees.begin(), callees.end());
+        for (const auto callee : callees) {
+            contents.append(callee);
+            contents.push_back('\0');
+            append_symbol(contents, callee);
+        }
+
+        node.hash = crypto::sha256::hash(reinterpret_cast<const uint8_t*>(contents.data()),
+                                         static_cast<uint32_t>(contents.size()));
+    }
+
+    return graph;
+}
+
+absl::Nullable<const FunctionGraph::Node*> FunctionGraph::find(std::string_view key) const {
+    if (const auto it = _nodes.find(key); it != _nodes.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+absl::flat_hash_set<std::string> FunctionGraph::callers(std::string_view key) const {
+    absl::flat_hash_set<std::string> result;
+    for (const auto& [caller, node] : _nodes) {
+        if (node.callees.contains(key)) {
+            result.insert(caller);
+        }
+    }
+    return result;
+}
+
+absl::flat_hash_set<std::string> FunctionGraph::invalidated(const FunctionGraph& previous) const {
+    absl::flat_hash_set<std::string> result;
+    for (const auto& [key, node] : _nodes) {
+        if (_has_compile_time || !node.reusable) {
+            result.insert(key);
+            continue;
+        }
+
+        const auto* previous_node = previous.find(key);
+        if (previous_node == nullptr || previous_node->hash != node.hash) {
+            result.insert(key);
+        }
+    }
+    return result;
+}
+
+absl::flat_hash_set<std::string> FunctionCache::begin(FunctionGraph graph) {
+    _reused.clear();
+    _generated.clear();
+
+    auto invalidated = graph.invalidated(_graph);
+    _graph           = std::move(graph);
+    return invalidated;
+}
+
+bool FunctionCache::try_reuse(const ast::FunctionExpression& function,
+                              llvm::Function&                llvm_function) {
+    if (function.variable() == nullptr) {
+        return false;
+    }
+
+    auto        key  = FunctionGraph::key(*function.variable());
+    const auto* node = _graph.find(key);
+    if (node == nullptr || !node->reusable || _graph.has_compile_time()) {
+        return false;
+    }
+
+    if (const auto it = _entries.find(key); it != _entries.end() && it->second.hash == node->hash) {
+        _reused.emplace_back(&llvm_function, &it->second);
+        return true;
+    }
+
+    _generated.emplace_back(&llvm_function, std::move(key));
+    return false;
+}
+
+util::Result<void> FunctionCache::finish(llvm::Module& llvm_module) {
+    // Store the newly generated functions first, while the module only contains freshly generated
+    // code. Each function is extracted into its own module, with everything else it references
+    // turned into declarations (except for local constants, such as string literals, which are
+    // copied along with it).
+    absl::flat_hash_map<std::string, Entry> generated_entries;
+    for (auto& [llvm_function, key] : _generated) {
+        llvm::ValueToValueMapTy value_map;
+        auto extracted = llvm::CloneModule(llvm_module, value_map, [&](const llvm::GlobalValue* gv) {
+            if (gv == llvm_function) {
+                return true;
+            }
+            if (const auto* global = llvm::dyn_cast<llvm::GlobalVariable>(gv); global != nullptr) {
+                return global->isConstant() && global->hasLocalLinkage();
+            }
+            return false;
+        });
+
+        auto* extracted_function = llvm::cast<llvm::Function>(value_map[llvm_function]);
+        extracted_function->setLinkage(llvm::GlobalValue::ExternalLinkage);
+
+        std::string              bitcode;
+        llvm::raw_string_ostream os(bitcode);
+        llvm::WriteBitcodeToFile(*extracted, os);
+        os.flush();
+
+        generated_entries.emplace(
+            key, Entry{.hash = _graph.find(key)->hash, .bitcode = std::move(bitcode)});
+    }
+
+    if (!_reused.empty()) {
+        // Declarations in the cached modules resolve against the definitions in this module by
+        // name, which requires them to be visible to the linker. Restore the original linkage
+        // once the cached bodies have been linked in.
+        std::vector<std::pair<std::string, llvm::GlobalValue::LinkageTypes>> local_linkage;
+        for (auto& gv : llvm_module.global_values()) {
+            if (!gv.hasLocalLinkage()) {
+                continue;
+            }
+            if (auto* global = llvm::dyn_cast<llvm::GlobalVariable>(&gv);
+                global != nullptr && global->isConstant()) {
+                continue;
+            }
+            local_linkage.emplace_back(gv.getName().str(), gv.getLinkage());
+            gv.setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+        for (auto& [llvm_function, entry] : _reused) {
+            local_linkage.emplace_back(llvm_function->getName().str(), llvm_function->getLinkage());
+            llvm_function->setLinkage(llvm::GlobalValue::ExternalLinkage);
+        }
+
+        for (auto& [llvm_function, entry] : _reused) {
+            auto cached = llvm::parseBitcodeFile(
+                llvm::MemoryBufferRef(entry->bitcode, llvm_function->getName()),
+                llvm_module.getContext());
+            if (!cached) {
+                return ERR_PTR(err::SimpleError,
+                               absl::StrCat("failed to load cached function \"",
+                                            llvm_function->getName().str(),
+                                            "\": ", llvm::toString(cached.takeError())));
+            }
+
+            if (llvm::Linker::linkModules(llvm_module, std::move(*cached))) {
+                return ERR_PTR(err::SimpleError,
+                               absl::StrCat("failed to link cached function \"",
+                                            llvm_function->getName().str(), "\""));
+            }
+        }
+
+        for (const auto& [name, linkage] : local_linkage) {
+            if (auto* gv = llvm_module.getNamedValue(name); gv != nullptr) {
+                gv->setLinkage(linkage);
+            }
+        }
+    }
+
+    // Keep only the entries that are still part of the module, so that the cache does not grow
+    // with every function that was ever compiled.
+    absl::erase_if(_entries, [this](const auto& entry) {
+        const auto* node = _graph.find(entry.first);
+        return node == nullptr || node->hash != entry.second.hash;
+    });
+    for (auto& [key, entry] : generated_entries) {
+        _entries.insert_or_assign(key, std::move(entry));
+    }
+
+    _reused.clear();
+    _generated.clear();
+    return {};
+}
+
+void FunctionCache::clear() {
+    _entries.clear();
+    _graph = FunctionGraph();
+    _reused.clear();
+    _generated.clear();
+}
+
+}  // namespace rain::lang::code
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Target/TargetMachine.h"
+#include "rain/crypto/sha256.hpp"
+#include "rain/lang/ast/expr/function.hpp"
+#include "rain/lang/ast/module.hpp"
+#include "rain/lang/options.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::code {
+
+using FunctionHash = crypto::sha256::Digest;
+
+/**
+ * Return a string that identifies everything besides the source that the generated code depends
+ * on: the target (its triple, CPU, and features), and the options that change code generation.
+ * Generated code is only reused between compiles with the same fingerprint.
+ */
+[[nodiscard]] std::string target_fingerprint(const Options&             options,
+                                             const llvm::TargetMachine& llvm_target_machine);
+
+/** Return the functions in the scope that share their name (and callee type) with another. */
+[[nodiscard]] absl::flat_hash_set<const ast::FunctionVariable*> find_overloaded_functions(
+    const ast::Scope& scope);
+
+/**
+ * Return the LLVM symbol name of a function. Unlike the names LLVM makes up to keep symbols
+ * unique, this does not depend on the order that the functions are declared in.
+ */
+[[nodiscard]] std::string function_symbol_name(std::string_view         name,
+                                               const ast::FunctionType& function_type,
+                                               bool                     overloaded);
+
+/**
+ * The call graph of the top-level functions defined in a module.
+ *
+ * Each function is identified by a key that is stable across compiles (its symbol name plus its
+ * resolved signature), and is given a content hash covering the tokens of its body, the resolved
+ * signatures of everything it calls, and the declarations (types, globals, externs) it could
+ * depend on. Two functions with the same key and hash generate identical LLVM IR.
+ */
+class FunctionGraph {
+  public:
+    struct Node {
+        FunctionHash hash = {};
+
+        /** The keys of the functions (including builtins) called from this function's body. */
+        absl::flat_hash_set<std::string> callees;
+
+        /**
+         * Whether the generated code for this function can be reused on its own.
+         *
+         * Functions that contain nested function definitions are not, as the nested functions are
+         * only generated as part of their parent.
+         */
+        bool reusable = true;
+    };
+
+  private:
+    absl::flat_hash_map<std::string, Node> _nodes;
+
+    /**
+     * Compile-time expressions run through the interpreter while the module is still being
+     * generated, and may call any function in the module, so the bodies of all functions must be
+     * available at that time.
+     */
+    bool _has_compile_time = false;
+
+  public:
+    /**
+     * Build the graph of the module, where `fingerprint` (see `target_fingerprint`) is part of the
+     * hash of every function.
+     */
+    static FunctionGraph build(const ast::Module& module, std::string_view fingerprint);
+
+    /** Return the key used to identify the function across compiles. */
+    static std::string key(const ast::FunctionVariable& function);
+
+    [[nodiscard]] constexpr const auto& nodes() const noexcept { return _nodes; }
+    [[nodiscard]] constexpr bool        has_compile_time() const noexcept {
+        return _has_compile_time;
+    }
+
+    [[nodiscard]] absl::Nullable<const Node*> find(std::string_view key) const;
+
+    /** Return the keys of all the functions that directly call the given function. */
+    [[nodiscard]] absl::flat_hash_set<std::string> callers(std::string_view key) const;
+
+    /**
+     * Return the keys of all the functions in this graph whose generated code cannot be taken from
+     * a compile of the `previous` graph.
+     */
+    [[nodiscard]] absl::flat_hash_set<std::string> invalidated(
+        const FunctionGraph& previous) const;
+};
+
+/**
+ * Holds the generated (unoptimized) LLVM IR of each function from previous compiles, so that
+ * functions that have not been invalidated do not need to be generated again.
+ *
+ * Usage, for each compile:
+ *  1. `begin` with the graph of the module about to be compiled;
+ *  2. `compile_function` asks `try_reuse` before generating each function body;
+ *  3. `finish` splices the reused function bodies into the module and stores the newly generated
+ *     ones for the next compile.
+ */
+class FunctionCache {
+    struct Entry {
+        FunctionHash hash;
+        std::string  bitcode;
+    };
+
+    absl::flat_hash_map<std::string, Entry> _entries;
+
+    FunctionGraph _graph;
+
+    std::vector<std::pair<absl::Nonnull<llvm::Function*>, absl::Nonnull<const Entry*>>> _reused;
+    std::vector<std::pair<absl::Nonnull<llvm::Function*>, std::string>>                 _generated;
+
+  public:
+    FunctionCache()  = default;
+    ~FunctionCache() = default;
+
+    FunctionCache(const FunctionCache&)            = delete;
+    FunctionCache& operator=(const FunctionCache&) = delete;
+
+    [[nodiscard]] constexpr const FunctionGraph& graph() const noexcept { return _graph; }
+    [[nodiscard]] /*constexpr*/ size_t           size() const noexcept { return _entries.size(); }
+
+    /**
+     * Start a new compile of the module described by `graph`, and return the set of functions that
+     * will have to be generated again.
+     */
+    absl::flat_hash_set<std::string> begin(FunctionGraph graph);
+
+    /**
+     * Return true if the body of `function` can be taken from a previous compile, in which case
+     * `llvm_function` must be left as a declaration until `finish` is called.
+     */
+    bool try_reuse(const ast::FunctionExpression& function, llvm::Function& llvm_function);
+
+    /** Splice the reused function bodies into `llvm_module`, and store the generated ones. */
+    util::Result<void> finish(llvm::Module& llvm_module);
+
+    void clear();
+};
+
+}  // namespace rain::lang::code
@@ -0,0 +1,170 @@
+#include "rain/lang/code/interface.hpp"
+
+#include "absl/strings/str_cat.h"
+#include "llvm/Analysis/Loads.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/IRBuilder.h"
+#include "rain/lang/code/abi.hpp"
+#include "rain/lang/code/context.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+/** Return the direct type of a vtbl entry, given the direct type of the method. */
+llvm::FunctionType* get_vtbl_entry_type(Context& ctx, llvm::FunctionType* llvm_method_type) {
+    llvm::SmallVector<llvm::Type*, 4> llvm_param_types(llvm_method_type->param_begin(),
+                                                       llvm_method_type->param_end());
+    llvm_param_types[0] = llvm::PointerType::get(ctx.llvm_context(), /*address space*/ 0);
+    return llvm::FunctionType::get(llvm_method_type->getReturnType(), llvm_param_types,
+                                   /*is_var_arg*/ false);
+}
+
+/** Define a vtbl entry that calls a method, which takes the implementing value itself. */
+llvm::Function* create_vtbl_adapter(Context& ctx, llvm::FunctionType* llvm_method_type,
+                                    llvm::Function& llvm_method, std::string_view interface_name) {
+    auto*           llvm_entry_type = get_vtbl_entry_type(ctx, llvm_method_type);
+    llvm::Function* llvm_adapter    = create_abi_function(
+        ctx, llvm_entry_type, llvm::Function::InternalLinkage,
+        absl::StrCat(std::string_view(llvm_method.getName()), ".", interface_name));
+
+    auto&                                 llvm_ir = ctx.llvm_builder();
+    llvm::IRBuilderBase::InsertPointGuard insert_point_guard(llvm_ir);
+    llvm_ir.SetInsertPoint(llvm::BasicBlock::Create(ctx.llvm_context(), "entry", llvm_adapter));
+
+    auto llvm_arguments = get_abi_arguments(ctx, llvm_entry_type, *llvm_adapter);
+    llvm_arguments[0]   = llvm_ir.CreateLoad(llvm_method_type->getParamType(0), llvm_arguments[0]);
+    llvm::Value* llvm_result = create_abi_call(ctx, llvm_method_type, &llvm_method, llvm_arguments);
+    create_abi_return(ctx, llvm_entry_type, *llvm_adapter, llvm_result);
+
+    ctx.release_stack_slots(llvm_adapter);
+    return llvm_adapter;
+}
+
+/**
+ * Return the value of a field of an interface value, if it is known where the value is used: when
+ * it was made earlier in the same block, and nothing may have changed it since it was stored (such
+ * as into a `let`, or a stack slot to pass it by reference).
+ */
+llvm::Value* find_known_field(llvm::Value* llvm_value, unsigned index) {
+    while (auto* llvm_load = llvm::dyn_cast<llvm::LoadInst>(llvm_value)) {
+        llvm::BasicBlock::iterator llvm_scan_from = llvm_load->getIterator();
+        llvm_value =
+            llvm::FindAvailableLoadedValue(llvm_load, llvm_load->getParent(), llvm_scan_from);
+        if (llvm_value == nullptr) {
+            return nullptr;
+        }
+    }
+    return llvm::FindInsertedValue(llvm_value, index);
+}
+
+}  // namespace
+
+llvm::StructType* get_vtbl_type(Context& ctx, const ast::InterfaceType& interface_type) {
+    auto* llvm_ptr_type = llvm::PointerType::get(ctx.llvm_context(), /*address space*/ 0);
+
+    const llvm::SmallVector<llvm::Type*, 4> llvm_entry_types(interface_type.methods().size(),
+                                                             llvm_ptr_type);
+    return llvm::StructType::get(ctx.llvm_context(), llvm_entry_types, /*is_packed*/ false);
+}
+
+llvm::GlobalVariable* get_or_create_vtbl(
+    Context& ctx, const ast::InterfaceImplementationExpression& implementation) {
+    const auto* implementer_type = implementation.implementer_type();
+    const auto& interface_type =
+        static_cast<const ast::InterfaceType&>(*implementation.interface_type());
+    if (auto* llvm_vtbl = ctx.llvm_vtbl(implementer_type, &interface_type); llvm_vtbl != nullptr) {
+        return llvm_vtbl;
+    }
+
+    llvm::SmallVector<llvm::Constant*, 4> llvm_entries;
+    llvm_entries.reserve(interface_type.methods().size());
+    for (int i = 0; i < interface_type.methods().size(); ++i) {
+        const auto* method      = implementation.vtbl_methods()[i];
+        auto*       llvm_method = static_cast<llvm::Function*>(ctx.llvm_value(method));
+        assert(llvm_method != nullptr && "interface method implementation was not declared");
+
+        // Methods that take self by value are the only ones whose first argument is not already a
+        // pointer to the implementing value.
+        const auto& argument_types =
+            interface_type.methods()[i]->variable()->function_type()->argument_types();
+        if (!argument_types.empty() && argument_types[0] == &interface_type) {
+            auto* llvm_method_type =
+                static_cast<llvm::FunctionType*>(ctx.llvm_type(method->function_type()));
+            llvm_method =
+                create_vtbl_adapter(ctx, llvm_method_type, *llvm_method, interface_type.name());
+        }
+        llvm_entries.push_back(llvm_method);
+    }
+
+    auto* llvm_vtbl = new llvm::GlobalVariable(
+        ctx.llvm_module(), get_vtbl_type(ctx, interface_type), /*is_constant*/ true,
+        llvm::GlobalValue::InternalLinkage,
+        llvm::ConstantStruct::get(get_vtbl_type(ctx, interface_type), llvm_entries),
+        absl::StrCat(implementer_type->display_name(), ".", interface_type.name(), ".vtbl"));
+    llvm_vtbl->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+
+    ctx.set_llvm_vtbl(implementer_type, &interface_type, llvm_vtbl);
+    return llvm_vtbl;
+}
+
+llvm::Value* create_interface_value(Context&                                      ctx,
+                                    const ast::InterfaceImplementationExpression& implementation,
+                                    llvm::Value*                                  llvm_data) {
+    auto& llvm_ir             = ctx.llvm_builder();
+    auto* llvm_interface_type = ctx.llvm_type(implementation.interface_type());
+    assert(llvm_interface_type != nullptr && "llvm interface type is null");
+
+    auto* llvm_value =
+        llvm_ir.CreateInsertValue(llvm::UndefValue::get(llvm_interface_type), llvm_data, 0);
+    return llvm_ir.CreateInsertValue(llvm_value, get_or_create_vtbl(ctx, implementation), 1);
+}
+
+llvm::Value* create_interface_call(Context& ctx, const ast::InterfaceType& interface_type,
+                                   int method_index, llvm::ArrayRef<llvm::Value*> arguments) {
+    auto& llvm_ir = ctx.llvm_builder();
+
+    const auto* method_type = interface_type.methods()[method_index]->variable()->function_type();
+    auto* llvm_method_type  = static_cast<llvm::FunctionType*>(ctx.llvm_type(method_type));
+    assert(llvm_method_type != nullptr && "llvm interface method type is null");
+    auto* llvm_entry_type = get_vtbl_entry_type(ctx, llvm_method_type);
+
+    llvm::Value* llvm_self = arguments[0];
+    if (llvm_self->getType()->isPointerTy()) {
+        // The method takes a reference to the interface value.
+        llvm_self = llvm_ir.CreateLoad(ctx.llvm_type(&interface_type), llvm_self);
+    }
+
+    llvm::SmallVector<llvm::Value*, 4> llvm_arguments(arguments.begin(), arguments.end());
+    llvm_arguments[0] = find_known_field(llvm_self, 0);
+    if (llvm_arguments[0] == nullptr) {
+        llvm_arguments[0] = llvm_ir.CreateExtractValue(llvm_self, 0);
+    }
+
+    // Devirtualize the call if the vtbl is known, or if it can only be the vtbl of the one type in
+    // the whole program that implements the interface.
+    auto* llvm_known_vtbl =
+        llvm::dyn_cast_or_null<llvm::GlobalVariable>(find_known_field(llvm_self, 1));
+    if (const auto* implementation = ctx.sole_implementation(&interface_type);
+        llvm_known_vtbl == nullptr && implementation != nullptr &&
+        ctx.options().whole_program_devirtualization()) {
+        llvm_known_vtbl = get_or_create_vtbl(ctx, *implementation);
+    }
+    if (llvm_known_vtbl != nullptr && llvm_known_vtbl->isConstant() &&
+        llvm_known_vtbl->hasDefinitiveInitializer()) {
+        auto* llvm_method = llvm::cast<llvm::Function>(
+            llvm_known_vtbl->getInitializer()->getAggregateElement(method_index));
+        return create_abi_call(ctx, llvm_entry_type, llvm_method, llvm_arguments);
+    }
+
+    auto* llvm_vtbl       = llvm_ir.CreateExtractValue(llvm_self, 1);
+    auto* llvm_method_ptr = llvm_ir.CreateLoad(
+        llvm::PointerType::get(ctx.llvm_context(), /*address space*/ 0),
+        llvm_ir.CreateStructGEP(get_vtbl_type(ctx, interface_type), llvm_vtbl, method_index));
+    return create_abi_call(
+        ctx, llvm_entry_type,
+        llvm::FunctionCallee(get_abi_function_type(ctx, llvm_entry_type), llvm_method_ptr),
+        llvm_arguments);
+}
+
+}  // namespace rain::lang::code
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Type.h"
+#include "llvm/IR/Value.h"
+#include "rain/lang/ast/expr/interface_implementation.hpp"
+#include "rain/lang/ast/type/interface.hpp"
+
+namespace rain::lang::code {
+
+class Context;
+
+// Code generation for interfaces. An interface value is a `{ data, vtbl }` pointer pair: a pointer
+// to the value that implements the interface, and the vtbl of its type's implementation.
+//
+// A vtbl is a constant table with a pointer to the function that implements each of the
+// interface's methods, in the order they are declared. Each of them takes the same arguments
+// (following the same calling convention) as the interface method, except that the self argument
+// is the data pointer. Methods that take the implementing value itself (rather than a reference to
+// it) are called through an adapter that loads it.
+
+/** Return the type of the vtbl of the interface. */
+llvm::StructType* get_vtbl_type(Context& ctx, const ast::InterfaceType& interface_type);
+
+/**
+ * Return the vtbl of a type's implementation of an interface, which is created the first time that
+ * it is used, and shared by all of the interface values made from that type in the module.
+ */
+llvm::GlobalVariable* get_or_create_vtbl(
+    Context& ctx, const ast::InterfaceImplementationExpression& implementation);
+
+/** Make an interface value from a pointer to a value of a type that implements it. */
+llvm::Value* create_interface_value(Context&                                      ctx,
+                                    const ast::InterfaceImplementationExpression& implementation,
+                                    llvm::Value*                                  llvm_data);
+
+/**
+ * Call one of the methods of an interface, where the first argument is the interface value (or a
+ * reference to one), and return its direct result.
+ *
+ * If the vtbl of the value is known where it is called (such as when it was made by a cast in the
+ * same block), the implementation is called directly, so that it can be inlined. Otherwise its
+ * function is loaded from the vtbl.
+ */
+llvm::Value* create_interface_call(Context& ctx, const ast::InterfaceType& interface_type,
+                                   int method_index, llvm::ArrayRef<llvm::Value*> arguments);
+
+}  // namespace rain::lang::code
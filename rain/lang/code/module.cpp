@@ -7,12 +7,14 @@
 #include "llvm/Passes/PassBuilder.h"
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Scalar.h"
 #include "llvm/Transforms/Scalar/GVN.h"
 #include "llvm/Transforms/Scalar/Reassociate.h"
 #include "llvm/Transforms/Scalar/SimplifyCFG.h"
+#include "rain/lang/err/simple.hpp"
 // #include "llvm/Transforms/Vectorize/LoadStoreVectorizer.h"
 // #include "llvm/Transforms/Vectorize/LoopVectorize.h"
 // #include "llvm/Transforms/Vectorize/SLPVectorizer.h"
@@ -40,20 +42,41 @@ std::unique_ptr<llvm::TargetMachine> clone_target_machine(
 }  // namespace
 
 Module::Module(Options& options)
-    : _llvm_ctx(std::make_unique<llvm::LLVMContext>()),
-      _llvm_target_machine(options.create_target_machine()) {
+    : Module(options, std::make_shared<llvm::LLVMContext>(), options.create_target_machine()) {}
+
+Module::Module(Options& options, std::shared_ptr<llvm::LLVMContext> llvm_ctx,
+               std::shared_ptr<llvm::TargetMachine> llvm_target_machine)
+    : _llvm_ctx(std::move(llvm_ctx)),
+      _llvm_owned_module(std::make_unique<llvm::Module>("rain", *_llvm_ctx)),
+      _llvm_module(_llvm_owned_module.get()),
+      _llvm_target_machine(std::move(llvm_target_machine)),
+      _options(&options) {
+    assert(_llvm_ctx != nullptr && "missing llvm context");
     assert(_llvm_target_machine != nullptr && "failed to create target machine");
 
-    auto llvm_module = std::make_unique<llvm::Module>("rain", *_llvm_ctx);
-    llvm_module->setDataLayout(_llvm_target_machine->createDataLayout());
-    llvm_module->setTargetTriple(_llvm_target_machine->getTargetTriple().str());
+    _llvm_module->setDataLayout(_llvm_target_machine->createDataLayout());
+    _llvm_module->setTargetTriple(_llvm_target_machine->getTargetTriple().str());
+}
+
+Module::Module(std::unique_ptr<Options> options) : Module(*options) {
+    _owned_options = std::move(options);
+}
 
-    _llvm_module = llvm_module.get();
-    _llvm_engine =
-        options.create_engine(std::move(llvm_module), clone_target_machine(*_llvm_target_machine));
+llvm::ExecutionEngine& Module::llvm_engine() {
+    if (_llvm_engine == nullptr) {
+        assert(_llvm_owned_module != nullptr && "module ownership was already given away");
+        _llvm_engine = _options->create_engine(std::move(_llvm_owned_module),
+                                               clone_target_machine(*_llvm_target_machine));
+        assert(_llvm_engine != nullptr && "failed to create execution engine");
+    }
+    return *_llvm_engine;
 }
 
-void Module::optimize() {
+void Module::optimize(const llvm::OptimizationLevel level) {
+    if (level == llvm::OptimizationLevel::O0) {
+        return;
+    }
+
     // Create new pass and analysis managers.
     auto lam  = llvm::LoopAnalysisManager();
     auto fam  = llvm::FunctionAnalysisManager();
@@ -86,8 +109,7 @@ void Module::optimize() {
     pb.registerLoopAnalyses(lam);
     pb.crossRegisterProxies(lam, fam, cgam, mam);
 
-    llvm::ModulePassManager mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::Os,
-                                                                   /*LTOPreLink*/ true);
+    llvm::ModulePassManager mpm = pb.buildPerModuleDefaultPipeline(level, /*LTOPreLink*/ true);
     // llvm::ModulePassManager mpm = pb.buildModuleInlinerPipeline(
     //     llvm::OptimizationLevel::Os, llvm::ThinOrFullLTOPhase::ThinLTOPreLink);
     mpm.addPass(llvm::createModuleToFunctionPassAdaptor(std::move(fpm)));
@@ -101,21 +123,33 @@ util::Result<std::string> Module::emit_ir() const {
     return os.str();
 }
 
+util::Result<std::string> Module::emit_bitcode(BitcodeCompression compression) const {
+    return code::emit_bitcode(*_llvm_module, compression);
+}
+
 util::Result<std::unique_ptr<llvm::MemoryBuffer>> Module::emit_obj() const {
-    llvm::SmallString<0>      code;
-    llvm::raw_svector_ostream ostream(code);
+    llvm::SmallVector<char, 0> code;
+    llvm::raw_svector_ostream  ostream(code);
+
+    auto result = emit_obj(ostream);
+    FORWARD_ERROR(result);
+
+    // Based on the documentation for llvm::raw_svector_ostream, the underlying SmallVector is
+    // always up to date, so there is no need to call flush() before taking it over.
+    return std::make_unique<llvm::SmallVectorMemoryBuffer>(std::move(code),
+                                                           /*RequiresNullTerminator=*/false);
+}
+
+util::Result<void> Module::emit_obj(llvm::raw_pwrite_stream& ostream) const {
     llvm::legacy::PassManager pass_manager;
 
     auto target_machine = _llvm_target_machine.get();
     if (target_machine->addPassesToEmitFile(pass_manager, ostream, nullptr,
                                             llvm::CodeGenFileType::CGFT_ObjectFile)) {
-        std::abort();
+        return ERR_PTR(err::SimpleError, "the target machine cannot emit object files");
     }
     pass_manager.run(*_llvm_module);
-
-    // Based on the documentation for llvm::raw_svector_ostream, the underlying SmallString is
-    // always up to date, so there is no need to call flush() before returning the string.
-    return llvm::MemoryBuffer::getMemBufferCopy(code.str());
+    return {};
 }
 
 }  // namespace rain::lang::code
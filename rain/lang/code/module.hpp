@@ -6,20 +6,37 @@
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Passes/OptimizationLevel.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
+#include "rain/lang/code/bitcode.hpp"
 #include "rain/lang/options.hpp"
 #include "rain/util/result.hpp"
 
 namespace rain::lang::code {
 
 class Module {
-    std::unique_ptr<llvm::LLVMContext>     _llvm_ctx;
+    // The context and target machine may be shared between modules (see `rain::Session`).
+    std::shared_ptr<llvm::LLVMContext> _llvm_ctx;
+
+    // The module is owned here until the execution engine is created, at which point the engine
+    // takes ownership of it. Most modules never need the engine, as it is only used to run
+    // compile-time expressions.
+    std::unique_ptr<llvm::Module>          _llvm_owned_module;
     absl::Nonnull<llvm::Module*>           _llvm_module;
-    std::unique_ptr<llvm::TargetMachine>   _llvm_target_machine;
+    std::shared_ptr<llvm::TargetMachine>   _llvm_target_machine;
     std::unique_ptr<llvm::ExecutionEngine> _llvm_engine;
 
+    // The options are only owned here when the caller did not provide any (see `rain::compile`),
+    // as they have to outlive the module for the engine to be created.
+    std::unique_ptr<Options> _owned_options;
+    absl::Nonnull<Options*>  _options;
+
   public:
     Module(Options& options);
+    explicit Module(std::unique_ptr<Options> options);
+    Module(Options& options, std::shared_ptr<llvm::LLVMContext> llvm_ctx,
+           std::shared_ptr<llvm::TargetMachine> llvm_target_machine);
 
     Module(const Module&)            = delete;
     Module& operator=(const Module&) = delete;
@@ -37,12 +54,15 @@ class Module {
         return *_llvm_module;
     }
     [[nodiscard]] /*constexpr*/ llvm::Module& llvm_module() noexcept { return *_llvm_module; }
-    [[nodiscard]] /*constexpr*/ const llvm::ExecutionEngine& llvm_engine() const noexcept {
-        return *_llvm_engine;
+    [[nodiscard]] /*constexpr*/ const llvm::DataLayout& llvm_data_layout() const noexcept {
+        return _llvm_module->getDataLayout();
     }
-    [[nodiscard]] /*constexpr*/ llvm::ExecutionEngine& llvm_engine() noexcept {
-        return *_llvm_engine;
+    [[nodiscard]] /*constexpr*/ bool has_llvm_engine() const noexcept {
+        return _llvm_engine != nullptr;
     }
+
+    /** Return the execution engine, creating it the first time it is needed. */
+    [[nodiscard]] llvm::ExecutionEngine& llvm_engine();
     [[nodiscard]] /*constexpr*/ const llvm::TargetMachine& llvm_target_machine() const noexcept {
         return *_llvm_target_machine;
     }
@@ -50,10 +70,24 @@ class Module {
         return *_llvm_target_machine;
     }
 
-    void optimize();
+    /**
+     * Optimize the module at the given level. `O0` leaves the module as it is, the same as not
+     * calling this at all.
+     */
+    void optimize(llvm::OptimizationLevel level = llvm::OptimizationLevel::Os);
 
     [[nodiscard]] util::Result<std::string>                         emit_ir() const;
+
+    /**
+     * Emit the module as LLVM bitcode, which is a fraction of the size of the textual IR, and much
+     * faster to load again (see `rain::link`).
+     */
+    [[nodiscard]] util::Result<std::string> emit_bitcode(
+        BitcodeCompression compression = BitcodeCompression::None) const;
     [[nodiscard]] util::Result<std::unique_ptr<llvm::MemoryBuffer>> emit_obj() const;
+
+    /** Emit the object file directly into `ostream`, instead of into a new buffer. */
+    [[nodiscard]] util::Result<void> emit_obj(llvm::raw_pwrite_stream& ostream) const;
 };
 
 }  // namespace rain::lang::code
@@ -0,0 +1,289 @@
+#include "rain/lang/code/slice.hpp"
+
+#include <functional>
+
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/Intrinsics.h"
+#include "rain/lang/code/context.hpp"
+
+namespace rain::lang::code {
+
+namespace {
+
+/** Compare (or search) this many bytes at a time, the size of a single SIMD vector. */
+constexpr uint64_t VECTOR_BYTES = 16;
+
+struct SliceBounds {
+    llvm::Value* begin;
+    llvm::Value* end;
+
+    /** The number of elements, as a pointer-sized integer. */
+    llvm::Value* length;
+};
+
+SliceBounds get_slice_bounds(Context& ctx, llvm::Type* llvm_element_type, llvm::Value* llvm_slice) {
+    auto&       llvm_ir           = ctx.llvm_builder();
+    const auto& llvm_data_layout  = ctx.llvm_data_layout();
+    auto*       llvm_int_ptr_type = llvm_data_layout.getIntPtrType(ctx.llvm_context());
+
+    auto* llvm_begin = llvm_ir.CreateExtractValue(llvm_slice, 0);
+    auto* llvm_end   = llvm_ir.CreateExtractValue(llvm_slice, 1);
+    auto* llvm_bytes = llvm_ir.CreateSub(llvm_ir.CreatePtrToInt(llvm_end, llvm_int_ptr_type),
+                                         llvm_ir.CreatePtrToInt(llvm_begin, llvm_int_ptr_type));
+    auto* llvm_length = llvm_ir.CreateExactUDiv(
+        llvm_bytes,
+        llvm::ConstantInt::get(llvm_int_ptr_type,
+                               llvm_data_layout.getTypeAllocSize(llvm_element_type)));
+
+    return SliceBounds{.begin = llvm_begin, .end = llvm_end, .length = llvm_length};
+}
+
+/** The number of elements compared at a time, or 1 if the elements can't be put in a vector. */
+unsigned get_vector_lanes(Context& ctx, llvm::Type* llvm_element_type) {
+    if (!llvm_element_type->isFloatingPointTy() &&
+        !(llvm_element_type->isIntegerTy() && !llvm_element_type->isIntegerTy(1))) {
+        return 1;
+    }
+    const uint64_t size = ctx.llvm_data_layout().getTypeAllocSize(llvm_element_type);
+    return size < VECTOR_BYTES ? static_cast<unsigned>(VECTOR_BYTES / size) : 1;
+}
+
+/** Compare two values (either single elements or vectors of them) for equality. */
+llvm::Value* create_equal(Context& ctx, llvm::Value* llvm_lhs, llvm::Value* llvm_rhs) {
+    auto& llvm_ir = ctx.llvm_builder();
+    return llvm_lhs->getType()->isFPOrFPVectorTy() ? llvm_ir.CreateFCmpOEQ(llvm_lhs, llvm_rhs)
+                                                   : llvm_ir.CreateICmpEQ(llvm_lhs, llvm_rhs);
+}
+
+/**
+ * Return the index of the first element (below `llvm_length`) that matches, or `llvm_length` if
+ * none do.
+ *
+ * `matches(index, lanes)` loads `lanes` elements starting at the index, and returns whether each
+ * of them matches (an i1, or a vector of them). The elements are checked a whole vector at a time
+ * while there are enough of them left, and then one at a time.
+ */
+llvm::Value* create_find_first(
+    Context& ctx, unsigned lanes, llvm::Value* llvm_length,
+    const std::function<llvm::Value*(llvm::Value* llvm_index, unsigned lanes)>& matches) {
+    auto& llvm_ctx = ctx.llvm_context();
+    auto& llvm_ir  = ctx.llvm_builder();
+
+    llvm::Function* const llvm_function = llvm_ir.GetInsertBlock()->getParent();
+    llvm::Type* const     llvm_int_type = llvm_length->getType();
+    llvm::Value* const    llvm_zero     = llvm::ConstantInt::get(llvm_int_type, 0);
+
+    // The result is added to the function once all of the loops have been.
+    llvm::BasicBlock* const llvm_done_block = llvm::BasicBlock::Create(llvm_ctx, "find.done");
+    llvm::PHINode* const    llvm_result     = llvm::PHINode::Create(llvm_int_type, 4);
+
+    // The elements after the last whole vector.
+    llvm::Value* llvm_tail_start = llvm_zero;
+    if (lanes > 1) {
+        llvm::BasicBlock* const llvm_preheader_block = llvm_ir.GetInsertBlock();
+        llvm::BasicBlock* const llvm_loop_block =
+            llvm::BasicBlock::Create(llvm_ctx, "find.vector", llvm_function);
+        llvm::BasicBlock* const llvm_latch_block =
+            llvm::BasicBlock::Create(llvm_ctx, "find.vector.next", llvm_function);
+        llvm::BasicBlock* const llvm_found_block =
+            llvm::BasicBlock::Create(llvm_ctx, "find.vector.found", llvm_function);
+        llvm::BasicBlock* const llvm_tail_block =
+            llvm::BasicBlock::Create(llvm_ctx, "find.tail", llvm_function);
+
+        auto* llvm_lanes = llvm::ConstantInt::get(llvm_int_type, lanes);
+        llvm_tail_start  = llvm_ir.CreateAnd(llvm_length, llvm_ir.CreateNeg(llvm_lanes));
+        llvm_ir.CreateCondBr(llvm_ir.CreateICmpNE(llvm_tail_start, llvm_zero), llvm_loop_block,
+                             llvm_tail_block);
+
+        llvm_ir.SetInsertPoint(llvm_loop_block);
+        llvm::PHINode* llvm_index = llvm_ir.CreatePHI(llvm_int_type, 2, "find.vector.index");
+        llvm_index->addIncoming(llvm_zero, llvm_preheader_block);
+        llvm::Value* llvm_matches = matches(llvm_index, lanes);
+        llvm_ir.CreateCondBr(llvm_ir.CreateOrReduce(llvm_matches), llvm_found_block,
+                             llvm_latch_block);
+
+        llvm_ir.SetInsertPoint(llvm_latch_block);
+        auto* llvm_next = llvm_ir.CreateNUWAdd(llvm_index, llvm_lanes, "find.vector.next");
+        llvm_index->addIncoming(llvm_next, llvm_latch_block);
+        llvm_ir.CreateCondBr(llvm_ir.CreateICmpULT(llvm_next, llvm_tail_start), llvm_loop_block,
+                             llvm_tail_block);
+
+        // The first matching lane is the lowest set bit of the mask.
+        llvm_ir.SetInsertPoint(llvm_found_block);
+        auto* llvm_mask  = llvm_ir.CreateBitCast(llvm_matches, llvm_ir.getIntNTy(lanes));
+        auto* llvm_lane  = llvm_ir.CreateBinaryIntrinsic(llvm::Intrinsic::cttz, llvm_mask,
+                                                         llvm_ir.getTrue());
+        auto* llvm_found = llvm_ir.CreateNUWAdd(llvm_index,
+                                                llvm_ir.CreateZExt(llvm_lane, llvm_int_type));
+        llvm_result->addIncoming(llvm_found, llvm_found_block);
+        llvm_ir.CreateBr(llvm_done_block);
+
+        llvm_ir.SetInsertPoint(llvm_tail_block);
+    }
+
+    llvm::BasicBlock* const llvm_preheader_block = llvm_ir.GetInsertBlock();
+    llvm::BasicBlock* const llvm_loop_block =
+        llvm::BasicBlock::Create(llvm_ctx, "find.scalar", llvm_function);
+    llvm::BasicBlock* const llvm_latch_block =
+        llvm::BasicBlock::Create(llvm_ctx, "find.scalar.next", llvm_function);
+
+    llvm_result->addIncoming(llvm_length, llvm_preheader_block);
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpULT(llvm_tail_start, llvm_length), llvm_loop_block,
+                         llvm_done_block);
+
+    llvm_ir.SetInsertPoint(llvm_loop_block);
+    llvm::PHINode* llvm_index = llvm_ir.CreatePHI(llvm_int_type, 2, "find.scalar.index");
+    llvm_index->addIncoming(llvm_tail_start, llvm_preheader_block);
+    llvm_result->addIncoming(llvm_index, llvm_loop_block);
+    llvm_ir.CreateCondBr(matches(llvm_index, 1), llvm_done_block, llvm_latch_block);
+
+    llvm_ir.SetInsertPoint(llvm_latch_block);
+    auto* llvm_next = llvm_ir.CreateNUWAdd(llvm_index, llvm::ConstantInt::get(llvm_int_type, 1),
+                                           "find.scalar.next");
+    llvm_index->addIncoming(llvm_next, llvm_latch_block);
+    llvm_result->addIncoming(llvm_length, llvm_latch_block);
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpULT(llvm_next, llvm_length), llvm_loop_block,
+                         llvm_done_block);
+
+    llvm_done_block->insertInto(llvm_function);
+    llvm_ir.SetInsertPoint(llvm_done_block);
+    return llvm_ir.Insert(llvm_result, "find.index");
+}
+
+/** Load `lanes` elements (as a single value, or a vector of them) starting at the index. */
+llvm::Value* create_load_elements(Context& ctx, llvm::Type* llvm_element_type,
+                                  llvm::Value* llvm_begin, llvm::Value* llvm_index,
+                                  unsigned lanes) {
+    auto& llvm_ir        = ctx.llvm_builder();
+    auto  llvm_alignment = ctx.llvm_data_layout().getABITypeAlign(llvm_element_type);
+
+    auto* llvm_ptr  = llvm_ir.CreateInBoundsGEP(llvm_element_type, llvm_begin, {llvm_index});
+    auto* llvm_type = lanes > 1 ? llvm::FixedVectorType::get(llvm_element_type, lanes)
+                                : llvm_element_type;
+    return llvm_ir.CreateAlignedLoad(llvm_type, llvm_ptr, llvm_alignment);
+}
+
+}  // namespace
+
+llvm::Value* create_slice_copy(Context& ctx, llvm::Type* llvm_element_type,
+                               llvm::Value* llvm_destination, llvm::Value* llvm_source) {
+    auto&       llvm_ir          = ctx.llvm_builder();
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+
+    const auto destination = get_slice_bounds(ctx, llvm_element_type, llvm_destination);
+    const auto source      = get_slice_bounds(ctx, llvm_element_type, llvm_source);
+
+    auto* llvm_count =
+        llvm_ir.CreateBinaryIntrinsic(llvm::Intrinsic::umin, destination.length, source.length);
+    auto* llvm_bytes = llvm_ir.CreateNUWMul(
+        llvm_count, llvm::ConstantInt::get(llvm_count->getType(),
+                                           llvm_data_layout.getTypeAllocSize(llvm_element_type)));
+
+    const auto llvm_alignment = llvm_data_layout.getABITypeAlign(llvm_element_type);
+    llvm_ir.CreateMemMove(destination.begin, llvm_alignment, source.begin, llvm_alignment,
+                          llvm_bytes);
+
+    return llvm_ir.CreateTrunc(llvm_count, llvm_ir.getInt32Ty());
+}
+
+void create_slice_fill(Context& ctx, llvm::Type* llvm_element_type, llvm::Value* llvm_slice,
+                       llvm::Value* llvm_value) {
+    auto&       llvm_ctx         = ctx.llvm_context();
+    auto&       llvm_ir          = ctx.llvm_builder();
+    const auto& llvm_data_layout = ctx.llvm_data_layout();
+
+    const auto slice = get_slice_bounds(ctx, llvm_element_type, llvm_slice);
+
+    if (llvm_element_type->isIntegerTy(8)) {
+        llvm_ir.CreateMemSet(slice.begin, llvm_value, slice.length, llvm::MaybeAlign(1));
+        return;
+    }
+
+    llvm::Function* const   llvm_function        = llvm_ir.GetInsertBlock()->getParent();
+    llvm::BasicBlock* const llvm_preheader_block = llvm_ir.GetInsertBlock();
+    llvm::BasicBlock* const llvm_loop_block =
+        llvm::BasicBlock::Create(llvm_ctx, "fill", llvm_function);
+    llvm::BasicBlock* const llvm_done_block =
+        llvm::BasicBlock::Create(llvm_ctx, "fill.done", llvm_function);
+
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpNE(slice.begin, slice.end), llvm_loop_block,
+                         llvm_done_block);
+
+    llvm_ir.SetInsertPoint(llvm_loop_block);
+    llvm::PHINode* llvm_ptr = llvm_ir.CreatePHI(slice.begin->getType(), 2, "fill.ptr");
+    llvm_ptr->addIncoming(slice.begin, llvm_preheader_block);
+    llvm_ir.CreateAlignedStore(llvm_value, llvm_ptr,
+                               llvm_data_layout.getABITypeAlign(llvm_element_type));
+    auto* llvm_next =
+        llvm_ir.CreateConstInBoundsGEP1_32(llvm_element_type, llvm_ptr, 1, "fill.next");
+    llvm_ptr->addIncoming(llvm_next, llvm_loop_block);
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpNE(llvm_next, slice.end), llvm_loop_block,
+                         llvm_done_block);
+
+    llvm_ir.SetInsertPoint(llvm_done_block);
+}
+
+llvm::Value* create_slice_equals(Context& ctx, llvm::Type* llvm_element_type, llvm::Value* llvm_lhs,
+                                 llvm::Value* llvm_rhs) {
+    auto& llvm_ctx = ctx.llvm_context();
+    auto& llvm_ir  = ctx.llvm_builder();
+
+    const auto lhs = get_slice_bounds(ctx, llvm_element_type, llvm_lhs);
+    const auto rhs = get_slice_bounds(ctx, llvm_element_type, llvm_rhs);
+
+    llvm::Function* const   llvm_function    = llvm_ir.GetInsertBlock()->getParent();
+    llvm::BasicBlock* const llvm_entry_block = llvm_ir.GetInsertBlock();
+    llvm::BasicBlock* const llvm_compare_block =
+        llvm::BasicBlock::Create(llvm_ctx, "equals.compare", llvm_function);
+    llvm::BasicBlock* const llvm_done_block = llvm::BasicBlock::Create(llvm_ctx, "equals.done");
+
+    llvm_ir.CreateCondBr(llvm_ir.CreateICmpEQ(lhs.length, rhs.length), llvm_compare_block,
+                         llvm_done_block);
+
+    // Search for the first pair of elements that are not equal.
+    llvm_ir.SetInsertPoint(llvm_compare_block);
+    auto* llvm_mismatch = create_find_first(
+        ctx, get_vector_lanes(ctx, llvm_element_type), lhs.length,
+        [&](llvm::Value* llvm_index, unsigned count) {
+            auto* llvm_lhs_elements =
+                create_load_elements(ctx, llvm_element_type, lhs.begin, llvm_index, count);
+            auto* llvm_rhs_elements =
+                create_load_elements(ctx, llvm_element_type, rhs.begin, llvm_index, count);
+            return llvm_ir.CreateNot(create_equal(ctx, llvm_lhs_elements, llvm_rhs_elements));
+        });
+    auto* llvm_all_equal = llvm_ir.CreateICmpEQ(llvm_mismatch, lhs.length);
+    llvm::BasicBlock* const llvm_compare_end_block = llvm_ir.GetInsertBlock();
+    llvm_ir.CreateBr(llvm_done_block);
+
+    llvm_done_block->insertInto(llvm_function);
+    llvm_ir.SetInsertPoint(llvm_done_block);
+    llvm::PHINode* llvm_result = llvm_ir.CreatePHI(llvm_ir.getInt1Ty(), 2, "equals");
+    llvm_result->addIncoming(llvm_ir.getFalse(), llvm_entry_block);
+    llvm_result->addIncoming(llvm_all_equal, llvm_compare_end_block);
+    return llvm_result;
+}
+
+llvm::Value* create_slice_index_of(Context& ctx, llvm::Type* llvm_element_type,
+                                   llvm::Value* llvm_slice, llvm::Value* llvm_value) {
+    auto& llvm_ir = ctx.llvm_builder();
+
+    const auto     slice = get_slice_bounds(ctx, llvm_element_type, llvm_slice);
+    const unsigned lanes = get_vector_lanes(ctx, llvm_element_type);
+
+    // Splat the value once, outside of the loop.
+    llvm::Value* llvm_splat =
+        lanes > 1 ? llvm_ir.CreateVectorSplat(lanes, llvm_value) : nullptr;
+
+    auto* llvm_index = create_find_first(
+        ctx, lanes, slice.length, [&](llvm::Value* llvm_index, unsigned count) {
+            auto* llvm_elements =
+                create_load_elements(ctx, llvm_element_type, slice.begin, llvm_index, count);
+            return create_equal(ctx, llvm_elements, count > 1 ? llvm_splat : llvm_value);
+        });
+
+    auto* llvm_found = llvm_ir.CreateICmpULT(llvm_index, slice.length);
+    return llvm_ir.CreateSelect(llvm_found, llvm_ir.CreateTrunc(llvm_index, llvm_ir.getInt32Ty()),
+                                llvm_ir.getInt32(-1));
+}
+
+}  // namespace rain::lang::code
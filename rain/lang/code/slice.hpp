@@ -0,0 +1,40 @@
+#pragma once
+
+#include "llvm/IR/Type.h"
+#include "llvm/IR/Value.h"
+
+namespace rain::lang::code {
+
+class Context;
+
+// Code generation for the builtin slice methods. Slices are `{ begin, end }` pointer pairs.
+
+/**
+ * Copy as many elements as both slices have from `llvm_source` into `llvm_destination` (with
+ * `llvm.memmove`, as the slices may overlap), and return the number of elements copied as an i32.
+ */
+llvm::Value* create_slice_copy(Context& ctx, llvm::Type* llvm_element_type,
+                               llvm::Value* llvm_destination, llvm::Value* llvm_source);
+
+/**
+ * Set every element of the slice to the value. Byte slices are filled with `llvm.memset`; other
+ * slices with a simple store loop, which LLVM turns into a memset or vectorizes.
+ */
+void create_slice_fill(Context& ctx, llvm::Type* llvm_element_type, llvm::Value* llvm_slice,
+                       llvm::Value* llvm_value);
+
+/**
+ * Return whether both slices have the same length and equal elements (as i1). The element type
+ * must be an integer or floating point type.
+ */
+llvm::Value* create_slice_equals(Context& ctx, llvm::Type* llvm_element_type, llvm::Value* llvm_lhs,
+                                 llvm::Value* llvm_rhs);
+
+/**
+ * Return the index of the first element that is equal to the value, or -1 if there are none (as
+ * an i32). The element type must be an integer or floating point type.
+ */
+llvm::Value* create_slice_index_of(Context& ctx, llvm::Type* llvm_element_type,
+                                   llvm::Value* llvm_slice, llvm::Value* llvm_value);
+
+}  // namespace rain::lang::code
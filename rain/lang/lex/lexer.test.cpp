@@ -41,3 +41,61 @@ fn main() {
     EXPECT_EQ(lexer.next().kind, lex::TokenKind::RCurlyBracket);
     EXPECT_EQ(lexer.next().kind, lex::TokenKind::EndOfFile);
 }
+
+TEST(Lexer, import) {
+    using namespace rain;
+    using namespace rain::lang;
+
+    const std::string_view code = R"(import { Vec4 } from "./vec4")";
+
+    auto lexer = lex::LazyLexer::using_source(code);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Import);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::LCurlyBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Identifier);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::RCurlyBracket);
+    {
+        // `from` is only meaningful within an import, so it is not reserved as a keyword.
+        const auto token = lexer.next();
+        EXPECT_EQ(token.kind, lex::TokenKind::Identifier);
+        EXPECT_EQ(token.text(), "from");
+    }
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::String);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::EndOfFile);
+}
+
+TEST(Lexer, for_range) {
+    using namespace rain;
+    using namespace rain::lang;
+
+    const std::string_view code = R"(for i in 0..n.length() { loop { break continue } })";
+
+    auto lexer = lex::LazyLexer::using_source(code);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::For);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Identifier);
+    {
+        // Like `from`, `in` is only meaningful in one place, so it is not reserved as a keyword.
+        const auto token = lexer.next();
+        EXPECT_EQ(token.kind, lex::TokenKind::Identifier);
+        EXPECT_EQ(token.text(), "in");
+    }
+    {
+        // The integer ends at the range operator, rather than being read as a float.
+        const auto token = lexer.next();
+        EXPECT_EQ(token.kind, lex::TokenKind::Integer);
+        EXPECT_EQ(token.text(), "0");
+    }
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::PeriodPeriod);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Identifier);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Period);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Identifier);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::LRoundBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::RRoundBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::LCurlyBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Loop);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::LCurlyBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Break);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::Continue);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::RCurlyBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::RCurlyBracket);
+    EXPECT_EQ(lexer.next().kind, lex::TokenKind::EndOfFile);
+}
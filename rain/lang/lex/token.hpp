@@ -30,6 +30,7 @@ enum TokenKind : uint32_t {
     For,
     If,
     Impl,
+    Import,
     Interface,
     Let,
     Loop,
@@ -43,6 +44,7 @@ enum TokenKind : uint32_t {
     // Operators
     Hash,
     Period,
+    PeriodPeriod,
     Comma,
     Colon,
     Semicolon,
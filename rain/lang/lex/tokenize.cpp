@@ -61,7 +61,7 @@ namespace rain::lang::lex {
 }
 
 [[nodiscard]] TokenKind find_keyword(std::string_view word) {
-    constexpr std::array<std::tuple<std::string_view, TokenKind>, 19> KEYWORDS{
+    constexpr std::array<std::tuple<std::string_view, TokenKind>, 22> KEYWORDS{
         // clang-format off
         // <keep_sorted>
         std::tuple{"as", TokenKind::As},
@@ -73,10 +73,13 @@ namespace rain::lang::lex {
         std::tuple{"extern", TokenKind::Extern},
         std::tuple{"false", TokenKind::False},
         std::tuple{"fn", TokenKind::Fn},
+        std::tuple{"for", TokenKind::For},
         std::tuple{"if", TokenKind::If},
         std::tuple{"impl", TokenKind::Impl},
+        std::tuple{"import", TokenKind::Import},
         std::tuple{"interface", TokenKind::Interface},
         std::tuple{"let", TokenKind::Let},
+        std::tuple{"loop", TokenKind::Loop},
         std::tuple{"null", TokenKind::Null},
         std::tuple{"return", TokenKind::Return},
         std::tuple{"self", TokenKind::Self},
@@ -140,6 +143,15 @@ namespace rain::lang::lex {
     }
 
     switch (op) {
+        case TokenKind::Period:
+            switch (state.it[1]) {
+                case '.':
+                    return TokenKind::PeriodPeriod;
+                default:
+                    break;
+            }
+            break;
+
         case TokenKind::Minus:
             switch (state.it[1]) {
                 case '>':
@@ -226,6 +238,7 @@ namespace rain::lang::lex {
         lengths[TokenKind::LCurlyBracket]  = 1;
         lengths[TokenKind::RCurlyBracket]  = 1;
 
+        lengths[TokenKind::PeriodPeriod]   = 2;
         lengths[TokenKind::RArrow]         = 2;
         lengths[TokenKind::LessLess]       = 2;
         lengths[TokenKind::GreaterGreater] = 2;
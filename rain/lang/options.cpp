@@ -1,13 +1,30 @@
 #include "rain/lang/options.hpp"
 
+#include "rain/lang/err/simple.hpp"
+
 namespace rain::lang {
 
+util::Result<void> Options::validate_extern_keys(const std::span<const std::string> keys) const {
+    if (keys[0] != "js") {
+        return ERR_PTR(err::SimpleError, "'js' is (currently) the only valid extern key");
+    }
+
+    if (keys.size() != 3) {
+        return ERR_PTR(err::SimpleError,
+                       "extern 'js' functions must have 3 keys: 'js', the namespace, and the "
+                       "function name");
+    }
+
+    return {};
+}
+
 bool Options::extern_is_compile_time_runnable(const std::span<const std::string> keys) {
     return false;
 }
 
-void Options::compile_extern_compile_time_runnable(code::Context&                     ctx,
-                                                   llvm::Function*                    llvm_function,
-                                                   const std::span<const std::string> keys) {}
+util::Result<void> Options::compile_extern_compile_time_runnable(
+    code::Context& ctx, llvm::Function* llvm_function, const std::span<const std::string> keys) {
+    return {};
+}
 
 }  // namespace rain::lang
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <optional>
 #include <span>
 #include <string>
 
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/IR/Function.h"
+#include "rain/util/result.hpp"
 
 namespace rain::lang {
 
@@ -20,20 +22,54 @@ class Options {
 
     [[nodiscard]] virtual bool             optimize() const noexcept { return true; }
     [[nodiscard]] virtual uint32_t         stack_size() const noexcept { return 0; }
+    [[nodiscard]] virtual uint32_t         max_memory() const noexcept { return 0; }
+    [[nodiscard]] virtual bool             shared_memory() const noexcept { return false; }
     [[nodiscard]] virtual std::string_view memory_export_name() const noexcept {
         return std::string_view();
     }
 
+    /**
+     * Whether calls in tail position may reuse the frame of the caller (for example as a wasm
+     * `return_call`), so that recursion through them runs in constant stack space.
+     */
+    [[nodiscard]] virtual bool tail_calls() const noexcept { return false; }
+
+    /**
+     * Whether the modules being compiled are the whole program, so that a call through an interface
+     * that only one `impl` in the program implements may call that implementation directly.
+     */
+    [[nodiscard]] virtual bool whole_program_devirtualization() const noexcept { return false; }
+
+    /**
+     * The target features that the output may use, which the linker checks the inputs against; or
+     * nullopt to let the linker infer them from the inputs.
+     */
+    [[nodiscard]] virtual std::optional<std::span<const std::string>> target_features()
+        const noexcept {
+        return std::nullopt;
+    }
+
     [[nodiscard]] virtual std::unique_ptr<llvm::TargetMachine>   create_target_machine() = 0;
     [[nodiscard]] virtual std::unique_ptr<llvm::ExecutionEngine> create_engine(
         std::unique_ptr<llvm::Module>        llvm_module,
         std::unique_ptr<llvm::TargetMachine> llvm_target_machine) = 0;
 
+    /**
+     * Check that the keys of an extern expression name a function that the target can import. By
+     * default, only `"js"` functions (with a namespace and function name) can be imported.
+     */
+    [[nodiscard]] virtual util::Result<void> validate_extern_keys(
+        const std::span<const std::string> keys) const;
+
     [[nodiscard]] virtual bool extern_is_compile_time_runnable(
         const std::span<const std::string> keys);
-    virtual void compile_extern_compile_time_runnable(code::Context&  ctx,
-                                                      llvm::Function* llvm_function,
-                                                      const std::span<const std::string> keys);
+
+    /**
+     * Bind the declaration of an extern function to the function that the target imports, failing
+     * if its signature cannot be imported.
+     */
+    [[nodiscard]] virtual util::Result<void> compile_extern_compile_time_runnable(
+        code::Context& ctx, llvm::Function* llvm_function, const std::span<const std::string> keys);
 };
 
 }  // namespace rain::lang
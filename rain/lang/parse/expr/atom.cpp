@@ -2,16 +2,20 @@
 #include "rain/lang/ast/expr/binary_operator.hpp"
 #include "rain/lang/ast/expr/block.hpp"
 #include "rain/lang/ast/expr/boolean.hpp"
+#include "rain/lang/ast/expr/break.hpp"
 #include "rain/lang/ast/expr/call.hpp"
 #include "rain/lang/ast/expr/compile_time.hpp"
+#include "rain/lang/ast/expr/continue.hpp"
 #include "rain/lang/ast/expr/expression.hpp"
 #include "rain/lang/ast/expr/extern.hpp"
 #include "rain/lang/ast/expr/float.hpp"
+#include "rain/lang/ast/expr/for.hpp"
 #include "rain/lang/ast/expr/function.hpp"
 #include "rain/lang/ast/expr/identifier.hpp"
 #include "rain/lang/ast/expr/if.hpp"
 #include "rain/lang/ast/expr/integer.hpp"
 #include "rain/lang/ast/expr/let.hpp"
+#include "rain/lang/ast/expr/loop.hpp"
 #include "rain/lang/ast/expr/member.hpp"
 #include "rain/lang/ast/expr/null.hpp"
 #include "rain/lang/ast/expr/parenthesis.hpp"
@@ -61,6 +65,10 @@ util::Result<std::unique_ptr<ast::FunctionExpression>>    parse_function(
 util::Result<std::unique_ptr<ast::IfExpression>>     parse_if(lex::Lexer& lexer, ast::Scope& scope);
 util::Result<std::unique_ptr<ast::WhileExpression>>  parse_while(lex::Lexer& lexer,
                                                                  ast::Scope& scope);
+util::Result<std::unique_ptr<ast::ForExpression>>    parse_for(lex::Lexer& lexer,
+                                                               ast::Scope& scope);
+util::Result<std::unique_ptr<ast::LoopExpression>>   parse_loop(lex::Lexer& lexer,
+                                                                ast::Scope& scope);
 util::Result<std::unique_ptr<ast::ExternExpression>> parse_extern(lex::Lexer& lexer,
                                                                   ast::Scope& scope);
 
@@ -117,6 +125,22 @@ util::Result<std::unique_ptr<ast::Expression>> parse_standalone_atom(lex::Lexer&
         case lex::TokenKind::While:
             return parse_while(lexer, scope);
 
+        case lex::TokenKind::For:
+            return parse_for(lexer, scope);
+
+        case lex::TokenKind::Loop:
+            return parse_loop(lexer, scope);
+
+        case lex::TokenKind::Break: {
+            lexer.next();  // Consume the `break` token
+            return std::make_unique<ast::BreakExpression>(token.location);
+        }
+
+        case lex::TokenKind::Continue: {
+            lexer.next();  // Consume the `continue` token
+            return std::make_unique<ast::ContinueExpression>(token.location);
+        }
+
         case lex::TokenKind::Fn:
             return parse_function(lexer, scope, true, true, nullptr);
 
@@ -0,0 +1,63 @@
+#include "rain/lang/ast/expr/for.hpp"
+
+#include <memory>
+
+#include "rain/lang/ast/expr/block.hpp"
+#include "rain/lang/ast/scope/scope.hpp"
+#include "rain/lang/err/syntax.hpp"
+#include "rain/lang/lex/lexer.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::parse {
+
+util::Result<std::unique_ptr<ast::Expression>>      parse_any_expression(lex::Lexer& lexer,
+                                                                         ast::Scope& scope);
+util::Result<std::unique_ptr<ast::BlockExpression>> parse_block(lex::Lexer& lexer,
+                                                                ast::Scope& scope);
+
+util::Result<std::unique_ptr<ast::ForExpression>> parse_for(lex::Lexer& lexer, ast::Scope& scope) {
+    const auto for_token = lexer.next();
+    IF_DEBUG {
+        if (for_token.kind != lex::TokenKind::For) {
+            return ERR_PTR(err::SyntaxError, for_token.location,
+                           "expected 'for'; this is an internal error");
+        }
+    }
+
+    const auto name_token = lexer.next();
+    if (name_token.kind != lex::TokenKind::Identifier) {
+        return ERR_PTR(err::SyntaxError, name_token.location,
+                       "expected variable name after 'for'");
+    }
+
+    // `in` is only meaningful here, so it is not reserved as a keyword.
+    if (const auto in_token = lexer.next();
+        in_token.kind != lex::TokenKind::Identifier || in_token.text() != "in") {
+        return ERR_PTR(err::SyntaxError, in_token.location,
+                       "expected 'in' after for loop variable name");
+    }
+
+    auto start = parse_any_expression(lexer, scope);
+    FORWARD_ERROR(start);
+
+    std::unique_ptr<ast::Expression> end;
+    if (lexer.peek().kind == lex::TokenKind::PeriodPeriod) {
+        lexer.next();  // Consume the `..` token
+
+        auto end_result = parse_any_expression(lexer, scope);
+        FORWARD_ERROR(end_result);
+        end = std::move(end_result).value();
+    }
+
+    if (auto token = lexer.peek(); token.kind != lex::TokenKind::LCurlyBracket) {
+        return ERR_PTR(err::SyntaxError, token.location, "expected '{' after for loop range");
+    }
+    auto loop = parse_block(lexer, scope);
+    FORWARD_ERROR(loop);
+
+    return std::make_unique<ast::ForExpression>(name_token.text(), std::move(start).value(),
+                                                std::move(end), std::move(loop).value(),
+                                                for_token.location, name_token.location);
+}
+
+}  // namespace rain::lang::parse
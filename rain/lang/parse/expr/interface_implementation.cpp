@@ -51,17 +51,21 @@ parse_interface_implementation(lex::Lexer& lexer, ast::Scope& scope) {
         return ERR_PTR(err::SyntaxError, lbracket_token.location, "expected '{' before impl body");
     }
 
+    // The methods are methods of the implementing type; the interface only decides which of them
+    // are called through its vtbl.
+    auto* implementer_type = *implementer_type_result;
+
     std::vector<std::unique_ptr<ast::FunctionExpression>> functions;
     auto                                                  result = parse_many(
         lexer, lex::TokenKind::RCurlyBracket, [&](lex::Lexer& lexer) -> util::Result<void> {
-            auto function_result =
-                parse_function(lexer, scope, false, true, std::move(interface_type_result).value());
+            auto function_result = parse_function(lexer, scope, false, true, implementer_type);
             FORWARD_ERROR(function_result);
             functions.emplace_back(std::move(function_result).value());
             return {};
         });
+    FORWARD_ERROR(result);
 
-    const auto rbracket_token = lexer.next();
+    const auto rbracket_token = lexer.next();  // Consume the '}'
 
     return std::make_unique<ast::InterfaceImplementationExpression>(
         std::move(implementer_type_result).value(), std::move(interface_type_result).value(),
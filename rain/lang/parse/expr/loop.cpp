@@ -0,0 +1,35 @@
+#include "rain/lang/ast/expr/loop.hpp"
+
+#include <memory>
+
+#include "rain/lang/ast/expr/block.hpp"
+#include "rain/lang/ast/scope/scope.hpp"
+#include "rain/lang/err/syntax.hpp"
+#include "rain/lang/lex/lexer.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::parse {
+
+util::Result<std::unique_ptr<ast::BlockExpression>> parse_block(lex::Lexer& lexer,
+                                                                ast::Scope& scope);
+
+util::Result<std::unique_ptr<ast::LoopExpression>> parse_loop(lex::Lexer& lexer,
+                                                              ast::Scope& scope) {
+    const auto loop_token = lexer.next();
+    IF_DEBUG {
+        if (loop_token.kind != lex::TokenKind::Loop) {
+            return ERR_PTR(err::SyntaxError, loop_token.location,
+                           "expected 'loop'; this is an internal error");
+        }
+    }
+
+    if (auto token = lexer.peek(); token.kind != lex::TokenKind::LCurlyBracket) {
+        return ERR_PTR(err::SyntaxError, token.location, "expected '{' after loop");
+    }
+    auto loop = parse_block(lexer, scope);
+    FORWARD_ERROR(loop);
+
+    return std::make_unique<ast::LoopExpression>(std::move(loop).value(), loop_token.location);
+}
+
+}  // namespace rain::lang::parse
@@ -8,6 +8,7 @@
 #include "rain/lang/ast/type/interface.hpp"
 #include "rain/lang/ast/type/struct.hpp"
 #include "rain/lang/err/syntax.hpp"
+#include "rain/lang/lex/string_value.hpp"
 #include "rain/lang/parse/util/list.hpp"
 
 namespace rain::lang::parse {
@@ -29,6 +30,64 @@ util::Result<absl::Nonnull<ast::InterfaceType*>> parse_interface_type(lex::Lexer
 
 namespace {
 
+util::Result<ast::Import> parse_import(lex::Lexer& lexer) {
+    const auto import_token = lexer.next();
+    IF_DEBUG {
+        if (import_token.kind != lex::TokenKind::Import) {
+            return ERR_PTR(err::SyntaxError, import_token.location,
+                           "expected keyword 'import'; this is an internal error");
+        }
+    }
+
+    if (const auto lbrace_token = lexer.next();
+        lbrace_token.kind != lex::TokenKind::LCurlyBracket) {
+        return ERR_PTR(err::SyntaxError, lbrace_token.location,
+                       "expected '{' before the list of imported names");
+    }
+
+    ast::Import import;
+    auto        names_result = parse_list(
+        lexer, lex::TokenKind::Comma, lex::TokenKind::RCurlyBracket,
+        [&](lex::Lexer& lexer) -> util::Result<void> {
+            const auto name_token = lexer.next();
+            if (name_token.kind != lex::TokenKind::Identifier) {
+                return ERR_PTR(err::SyntaxError, name_token.location, "expected imported name");
+            }
+
+            import.names.push_back(
+                ast::Import::Name{.name = name_token.text(), .location = name_token.location});
+            return {};
+        },
+        [](lex::Lexer& lexer, lex::Token token) -> util::Result<void> {
+            return ERR_PTR(err::SyntaxError, token.location,
+                           "expected ',' or '}' after imported name");
+        });
+    FORWARD_ERROR(names_result);
+
+    lexer.next();  // Consume the '}' token
+
+    if (const auto from_token = lexer.next();
+        from_token.kind != lex::TokenKind::Identifier || from_token.text() != "from") {
+        return ERR_PTR(err::SyntaxError, from_token.location,
+                       "expected 'from' after the list of imported names");
+    }
+
+    const auto path_token = lexer.next();
+    if (path_token.kind != lex::TokenKind::String) {
+        return ERR_PTR(err::SyntaxError, path_token.location,
+                       "expected string literal for the import path");
+    }
+    import.path          = lex::string_value(path_token.text());
+    import.path_location = path_token.location;
+
+    // The trailing semicolon is optional.
+    if (lexer.peek().kind == lex::TokenKind::Semicolon) {
+        lexer.next();
+    }
+
+    return import;
+}
+
 util::Result<std::unique_ptr<ast::Expression>> parse_top_level_expression(lex::Lexer& lexer,
                                                                           ast::Scope& scope) {
     auto token = lexer.peek();
@@ -85,6 +144,13 @@ util::Result<std::unique_ptr<ast::Module>> parse_module(lex::Lexer&        lexer
 
     auto result =
         parse_many(lexer, lex::TokenKind::EndOfFile, [&](lex::Lexer& lexer) -> util::Result<void> {
+            if (lexer.peek().kind == lex::TokenKind::Import) {
+                auto result = parse_import(lexer);
+                FORWARD_ERROR(result);
+                module->add_import(std::move(result).value());
+                return {};
+            }
+
             auto result = parse_top_level_expression(lexer, scope);
             FORWARD_ERROR(result);
             module->add_expression(std::move(result).value());
@@ -30,6 +30,10 @@ enum class ExpressionKind {
     Block,
     If,
     While,
+    For,
+    Loop,
+    Break,
+    Continue,
     Return,
 
     // Declarations
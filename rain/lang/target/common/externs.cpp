@@ -0,0 +1,119 @@
+#include "rain/lang/target/common/externs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+#include <tuple>
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ExecutionEngine/GenericValue.h"
+#include "rain/util/colors.hpp"
+#include "rain/util/console.hpp"
+
+namespace rain::lang {
+
+namespace {
+
+#define ASSERT_ARGUMENT_COUNT(name, expected_argument_count, got_argument_count)               \
+    if (llvm_arguments.size() != expected_argument_count) {                                    \
+        rain::util::panic(ANSI_RED, "bad builtin function call: \"", name, "\": ", ANSI_RESET, \
+                          "expected ", expected_argument_count, " argument",                   \
+                          (expected_argument_count == 1 ? "" : "s"), ", got ",                 \
+                          got_argument_count);                                                 \
+    }
+
+llvm::GenericValue lle_X_atan2(llvm::FunctionType*                llvm_function_type,
+                               llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
+    ASSERT_ARGUMENT_COUNT("atan2", 2, llvm_arguments.size());
+
+    llvm::GenericValue result;
+    result.FloatVal = std::atan2(llvm_arguments[0].FloatVal, llvm_arguments[1].FloatVal);
+    return result;
+}
+
+llvm::GenericValue lle_X_cos(llvm::FunctionType*                llvm_function_type,
+                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
+    ASSERT_ARGUMENT_COUNT("cos", 1, llvm_arguments.size());
+
+    llvm::GenericValue result;
+    result.FloatVal = std::cos(llvm_arguments[0].FloatVal);
+    return result;
+}
+
+llvm::GenericValue lle_X_sin(llvm::FunctionType*                llvm_function_type,
+                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
+    ASSERT_ARGUMENT_COUNT("sin", 1, llvm_arguments.size());
+
+    llvm::GenericValue result;
+    result.FloatVal = std::sin(llvm_arguments[0].FloatVal);
+    return result;
+}
+
+llvm::GenericValue lle_X_sqrt(llvm::FunctionType*                llvm_function_type,
+                              llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
+    ASSERT_ARGUMENT_COUNT("sqrt", 1, llvm_arguments.size());
+
+    llvm::GenericValue result;
+    result.FloatVal = std::sqrt(llvm_arguments[0].FloatVal);
+    return result;
+}
+
+llvm::GenericValue lle_X_tan(llvm::FunctionType*                llvm_function_type,
+                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
+    ASSERT_ARGUMENT_COUNT("tan", 1, llvm_arguments.size());
+
+    llvm::GenericValue result;
+    result.FloatVal = std::tan(llvm_arguments[0].FloatVal);
+    return result;
+}
+
+#undef ASSERT_ARGUMENT_COUNT
+
+using ExternFunction  = std::tuple<const std::string_view, const llvm::ExFunc>;
+using ExternNamespace = std::tuple<const std::string_view, std::span<const ExternFunction>>;
+
+static constexpr const std::array<ExternFunction, 5> MATH_FUNCTIONS{
+    // clang-format off
+    // <keep_sorted>
+    ExternFunction{"atan2", lle_X_atan2},
+    ExternFunction{"cos", lle_X_cos},
+    ExternFunction{"sin", lle_X_sin},
+    ExternFunction{"sqrt", lle_X_sqrt},
+    ExternFunction{"tan", lle_X_tan},
+    // </keep_sorted>
+    // clang-format on
+};
+
+static constexpr const std::array<ExternNamespace, 1> EXTERN_NAMESPACES{
+    // clang-format off
+    // <keep_sorted>
+    ExternNamespace{"math", MATH_FUNCTIONS},
+    // </keep_sorted>
+    // clang-format on
+};
+
+}  // namespace
+
+llvm::ExFunc find_extern_function(const std::string_view namespace_name,
+                                  const std::string_view function_name) {
+    const auto found_namespace =
+        std::lower_bound(EXTERN_NAMESPACES.begin(), EXTERN_NAMESPACES.end(), namespace_name,
+                         [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < rhs; });
+    if (found_namespace == EXTERN_NAMESPACES.end() ||
+        std::get<0>(*found_namespace) != namespace_name) {
+        return nullptr;
+    }
+
+    const auto& [namespace_name_, functions] = *found_namespace;
+    const auto found_function =
+        std::lower_bound(functions.begin(), functions.end(), function_name,
+                         [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < rhs; });
+    if (found_function == functions.end() || std::get<0>(*found_function) != function_name) {
+        return nullptr;
+    }
+
+    return std::get<1>(*found_function);
+}
+
+}  // namespace rain::lang
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string_view>
+
+#include "rain/lang/target/common/interpreter.hpp"
+
+namespace rain::lang {
+
+/**
+ * Return the interpreter implementation of the host function `namespace_name.function_name` (for
+ * example `math.sin`), or null if there is none.
+ *
+ * These are the extern functions that can be called from compile-time expressions, regardless of
+ * the target being compiled for.
+ */
+llvm::ExFunc find_extern_function(const std::string_view namespace_name,
+                                  const std::string_view function_name);
+
+}  // namespace rain::lang
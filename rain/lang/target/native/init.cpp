@@ -0,0 +1,29 @@
+#include "rain/lang/target/native/init.hpp"
+
+#include "llvm/ExecutionEngine/Interpreter.h"
+#include "llvm/Support/TargetSelect.h"
+
+namespace rain::lang::native {
+
+void initialize_llvm() {
+    static bool initialized = false;
+    if (!initialized) {
+        initialized = true;
+
+        LLVMInitializeX86TargetInfo();
+        LLVMInitializeX86Target();
+        LLVMInitializeX86TargetMC();
+        LLVMInitializeX86AsmPrinter();
+        LLVMInitializeX86AsmParser();
+
+        LLVMInitializeAArch64TargetInfo();
+        LLVMInitializeAArch64Target();
+        LLVMInitializeAArch64TargetMC();
+        LLVMInitializeAArch64AsmPrinter();
+        LLVMInitializeAArch64AsmParser();
+
+        LLVMLinkInInterpreter();
+    }
+}
+
+}  // namespace rain::lang::native
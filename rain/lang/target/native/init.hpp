@@ -0,0 +1,7 @@
+#pragma once
+
+namespace rain::lang::native {
+
+void initialize_llvm();
+
+}  // namespace rain::lang::native
@@ -0,0 +1,158 @@
+#include "rain/lang/target/native/jit.hpp"
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/Function.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "rain/lang/code/bitcode.hpp"
+
+namespace rain::lang::native {
+
+namespace {
+
+util::Result<void> to_result(llvm::Error error) {
+    if (error) {
+        return ERR_PTR(err::SimpleError, llvm::toString(std::move(error)));
+    }
+    return {};
+}
+
+ValueKind value_kind_of(const llvm::Type* llvm_type) {
+    switch (llvm_type->getTypeID()) {
+        case llvm::Type::VoidTyID:
+            return ValueKind::Void;
+        case llvm::Type::FloatTyID:
+            return ValueKind::F32;
+        case llvm::Type::DoubleTyID:
+            return ValueKind::F64;
+        case llvm::Type::PointerTyID:
+            return ValueKind::Pointer;
+        case llvm::Type::IntegerTyID:
+            switch (llvm_type->getIntegerBitWidth()) {
+                case 1:
+                    return ValueKind::Bool;
+                case 32:
+                    return ValueKind::I32;
+                case 64:
+                    return ValueKind::I64;
+                default:
+                    return ValueKind::Unsupported;
+            }
+        default:
+            // Structs and vectors are passed differently depending on the platform's ABI, so they
+            // cannot be called through a plain C++ function pointer.
+            return ValueKind::Unsupported;
+    }
+}
+
+Signature signature_of_function(const llvm::Function& llvm_function) {
+    const auto* llvm_function_type = llvm_function.getFunctionType();
+
+    Signature signature{value_kind_of(llvm_function_type->getReturnType()), {}};
+    signature.params.reserve(llvm_function_type->getNumParams());
+    for (const auto* llvm_param_type : llvm_function_type->params()) {
+        signature.params.push_back(value_kind_of(llvm_param_type));
+    }
+    return signature;
+}
+
+}  // namespace
+
+Jit::Jit(std::unique_ptr<llvm::orc::LLJIT> llvm_jit) : _llvm_jit(std::move(llvm_jit)) {}
+
+Jit::~Jit() = default;
+
+util::Result<Jit> Jit::create() {
+    auto llvm_jit_result = llvm::orc::LLJITBuilder().create();
+    if (!llvm_jit_result) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("failed to create JIT: ",
+                                                      llvm::toString(llvm_jit_result.takeError())));
+    }
+    auto llvm_jit = std::move(llvm_jit_result.get());
+
+    // Anything that is not defined by the modules or the host functions is looked up in the
+    // running process.
+    auto generator_result = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        llvm_jit->getDataLayout().getGlobalPrefix());
+    if (!generator_result) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("failed to create JIT: ",
+                                    llvm::toString(generator_result.takeError())));
+    }
+    llvm_jit->getMainJITDylib().addGenerator(std::move(generator_result.get()));
+
+    return Jit(std::move(llvm_jit));
+}
+
+util::Result<void> Jit::define_host_function(const std::string_view name, void* address) {
+    llvm::orc::SymbolMap symbols;
+    symbols[_llvm_jit->mangleAndIntern(name)] = llvm::orc::ExecutorSymbolDef(
+        llvm::orc::ExecutorAddr::fromPtr(address),
+        llvm::JITSymbolFlags::Exported | llvm::JITSymbolFlags::Callable);
+
+    return to_result(_llvm_jit->getMainJITDylib().define(llvm::orc::absoluteSymbols(symbols)));
+}
+
+util::Result<void> Jit::add_module(code::Module module) {
+    const llvm::Triple module_triple(module.llvm_module().getTargetTriple());
+    if (module_triple.getArch() != _llvm_jit->getTargetTriple().getArch()) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("cannot run a module compiled for ", module_triple.str(),
+                                    " on ", _llvm_jit->getTargetTriple().str()));
+    }
+
+    // The JIT compiles on its own context, which the module's context (possibly shared with other
+    // modules, see `rain::Session`) cannot be handed over as. Bitcode is a cheap way to move the
+    // module across.
+    std::string              bitcode;
+    llvm::raw_string_ostream bitcode_ostream(bitcode);
+    code::write_bitcode(module.llvm_module(), bitcode_ostream);
+    bitcode_ostream.flush();
+
+    auto llvm_ctx           = std::make_unique<llvm::LLVMContext>();
+    auto llvm_module_result = llvm::parseBitcodeFile(
+        llvm::MemoryBufferRef(bitcode, module.llvm_module().getModuleIdentifier()), *llvm_ctx);
+    if (!llvm_module_result) {
+        return ERR_PTR(err::SimpleError, llvm::toString(llvm_module_result.takeError()));
+    }
+    auto llvm_module = std::move(llvm_module_result.get());
+
+    // Record the signatures of the exported functions before the JIT takes the module, as it may
+    // be compiled (and freed) on another thread.
+    absl::flat_hash_map<std::string, Signature> signatures;
+    for (const auto& llvm_function : *llvm_module) {
+        if (llvm_function.isDeclaration() || !llvm_function.hasExternalLinkage()) {
+            continue;
+        }
+        signatures.emplace(llvm_function.getName().str(), signature_of_function(llvm_function));
+    }
+
+    auto result = to_result(_llvm_jit->addIRModule(
+        llvm::orc::ThreadSafeModule(std::move(llvm_module), std::move(llvm_ctx))));
+    FORWARD_ERROR(result);
+
+    for (auto& [name, function_signature] : signatures) {
+        _signatures.insert_or_assign(name, std::move(function_signature));
+    }
+    return {};
+}
+
+const Signature* Jit::signature(const std::string_view name) const {
+    if (const auto it = _signatures.find(name); it != _signatures.end()) {
+        return &it->second;
+    }
+    return nullptr;
+}
+
+util::Result<void*> Jit::lookup_address(const std::string_view name) {
+    auto address_result = _llvm_jit->lookup(name);
+    if (!address_result) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("failed to look up \"", name, "\": ",
+                                                      llvm::toString(address_result.takeError())));
+    }
+    return address_result->toPtr<void*>();
+}
+
+}  // namespace rain::lang::native
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "rain/lang/code/module.hpp"
+#include "rain/lang/err/simple.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::native {
+
+/** The kinds of values that can be passed to (and returned from) a JIT compiled function. */
+enum class ValueKind : uint8_t {
+    Unsupported,
+    Void,
+    Bool,
+    I32,
+    I64,
+    F32,
+    F64,
+    Pointer,
+};
+
+struct Signature {
+    ValueKind              result = ValueKind::Void;
+    std::vector<ValueKind> params;
+
+    [[nodiscard]] bool operator==(const Signature& other) const = default;
+};
+
+// clang-format off
+// <keep_sorted>
+template <typename T> constexpr ValueKind value_kind     = ValueKind::Unsupported;
+template <typename T> constexpr ValueKind value_kind<T*> = ValueKind::Pointer;
+template <> constexpr ValueKind value_kind<bool>         = ValueKind::Bool;
+template <> constexpr ValueKind value_kind<double>       = ValueKind::F64;
+template <> constexpr ValueKind value_kind<float>        = ValueKind::F32;
+template <> constexpr ValueKind value_kind<int32_t>      = ValueKind::I32;
+template <> constexpr ValueKind value_kind<int64_t>      = ValueKind::I64;
+template <> constexpr ValueKind value_kind<uint32_t>     = ValueKind::I32;
+template <> constexpr ValueKind value_kind<uint64_t>     = ValueKind::I64;
+template <> constexpr ValueKind value_kind<void>         = ValueKind::Void;
+// </keep_sorted>
+// clang-format on
+
+template <typename Fn>
+struct signature_of;
+
+template <typename R, typename... Args>
+struct signature_of<R(Args...)> {
+    static Signature get() { return Signature{value_kind<R>, {value_kind<Args>...}}; }
+};
+
+/**
+ * Compiles modules for the host with LLVM's ORC JIT, so that their exported functions can be
+ * called directly from C++.
+ *
+ * Modules must be compiled with `native::Options` targeting the host (the default). An `extern`
+ * function is resolved by the last of its keys: first against the host functions defined with
+ * `define_host_function`, and then against the symbols of the running process (so that, for
+ * example, `extern ("js", "math", "sin")` calls `sin` from libm).
+ *
+ * The addresses of compiled functions remain valid for as long as the JIT is alive.
+ */
+class Jit {
+    std::unique_ptr<llvm::orc::LLJIT> _llvm_jit;
+
+    /** The signatures of the functions exported by the modules that have been added so far. */
+    absl::flat_hash_map<std::string, Signature> _signatures;
+
+    explicit Jit(std::unique_ptr<llvm::orc::LLJIT> llvm_jit);
+
+  public:
+    /** Create a JIT for the host; `native::initialize_llvm` must have been called first. */
+    static util::Result<Jit> create();
+
+    Jit(const Jit&)            = delete;
+    Jit& operator=(const Jit&) = delete;
+
+    Jit(Jit&&)            = default;
+    Jit& operator=(Jit&&) = default;
+
+    ~Jit();
+
+    [[nodiscard]] /*constexpr*/ const llvm::DataLayout& llvm_data_layout() const noexcept {
+        return _llvm_jit->getDataLayout();
+    }
+
+    /**
+     * Make `address` available to the JIT compiled code as the function `name` (the last key of
+     * the `extern` that declares it).
+     *
+     * Host functions must be defined before any function that calls them is looked up.
+     */
+    util::Result<void> define_host_function(std::string_view name, void* address);
+
+    template <typename Fn>
+    util::Result<void> define_host_function(std::string_view name, Fn* function) {
+        static_assert(std::is_function_v<Fn>, "host functions must be plain function pointers");
+        return define_host_function(name, reinterpret_cast<void*>(function));
+    }
+
+    /**
+     * Hand the module over to the JIT. Its functions are only compiled once they (or a function
+     * that calls them) are first looked up.
+     */
+    util::Result<void> add_module(code::Module module);
+
+    /** Return the signature of an exported function, or nullptr if there is none by that name. */
+    [[nodiscard]] const Signature* signature(std::string_view name) const;
+
+    /** Return the address of the exported function (or host function) with the given name. */
+    util::Result<void*> lookup_address(std::string_view name);
+
+    /**
+     * Return a pointer to the exported function with the given name, after checking that its
+     * signature matches `Fn`.
+     */
+    template <typename Fn>
+    util::Result<Fn*> lookup(std::string_view name) {
+        static_assert(std::is_function_v<Fn>, "expected a function type, like `int32_t(int32_t)`");
+
+        const auto* function_signature = signature(name);
+        if (function_signature == nullptr) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("no exported function named \"", name, "\""));
+        }
+        if (*function_signature != signature_of<Fn>::get()) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("exported function \"", name,
+                                        "\" does not have the requested signature"));
+        }
+
+        auto address_result = lookup_address(name);
+        FORWARD_ERROR(address_result);
+        return reinterpret_cast<Fn*>(std::move(address_result).value());
+    }
+
+    /** Call the exported function with the given name, checking its signature first. */
+    template <typename R, typename... Args>
+    util::Result<R> invoke(std::string_view name, Args... args) {
+        auto function_result = lookup<R(Args...)>(name);
+        FORWARD_ERROR(function_result);
+
+        if constexpr (std::is_void_v<R>) {
+            std::move(function_result).value()(args...);
+            return {};
+        } else {
+            return std::move(function_result).value()(args...);
+        }
+    }
+};
+
+}  // namespace rain::lang::native
@@ -0,0 +1,58 @@
+#include "rain/lang/target/native/linker.hpp"
+
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "lld/Common/CommonLinkerContext.h"
+#include "lld/Common/Driver.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+#include "rain/lang/err/simple.hpp"
+
+LLD_HAS_DRIVER(elf)
+
+namespace rain::lang::native {
+
+util::Result<void> write_object(code::Module& module, const std::string& output_path) {
+    std::error_code      error;
+    llvm::raw_fd_ostream ostream(output_path, error, llvm::sys::fs::OF_None);
+    if (error) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("failed to open ", output_path, ": ", error.message()));
+    }
+
+    return module.emit_obj(ostream);
+}
+
+util::Result<void> link_shared_library(std::span<const std::string> object_paths,
+                                       const std::string&           output_path) {
+    std::vector<const char*> args = {"ld.lld", "-shared", "-o", output_path.c_str()};
+    for (const auto& object_path : object_paths) {
+        args.push_back(object_path.c_str());
+    }
+
+    std::string              errors;
+    llvm::raw_string_ostream errors_ostream(errors);
+    const bool linked = lld::elf::link(args, llvm::nulls(), errors_ostream, /*exitEarly=*/false,
+                                       /*disableOutput=*/false);
+    lld::CommonLinkerContext::destroy();
+
+    if (!linked) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("failed to link ", output_path, ":\n", errors_ostream.str()));
+    }
+    return {};
+}
+
+util::Result<void> link_shared_library(code::Module& module, const std::string& output_path) {
+    const std::string object_path = absl::StrCat(output_path, ".o");
+
+    auto write_result = write_object(module, object_path);
+    FORWARD_ERROR(write_result);
+
+    auto link_result = link_shared_library(std::span{&object_path, 1}, output_path);
+    llvm::sys::fs::remove(object_path);
+    return link_result;
+}
+
+}  // namespace rain::lang::native
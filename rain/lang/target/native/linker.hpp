@@ -0,0 +1,27 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "rain/lang/code/module.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain::lang::native {
+
+/** Write the module as an object file for its (native) target to `output_path`. */
+util::Result<void> write_object(code::Module& module, const std::string& output_path);
+
+/**
+ * Link the given object files into a shared library at `output_path`, whose exported functions
+ * can then be loaded with `dlopen`/`dlsym`.
+ *
+ * This uses the ELF linker, so it is only supported for ELF targets.
+ */
+util::Result<void> link_shared_library(std::span<const std::string> object_paths,
+                                       const std::string&           output_path);
+
+/** Compile the module to an object file next to `output_path`, and link it into a library. */
+util::Result<void> link_shared_library(code::Module& module, const std::string& output_path);
+
+}  // namespace rain::lang::native
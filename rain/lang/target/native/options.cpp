@@ -0,0 +1,160 @@
+#include "rain/lang/target/native/options.hpp"
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "absl/strings/str_cat.h"
+#include "llvm/MC/TargetRegistry.h"
+#include "llvm/TargetParser/Host.h"
+#include "llvm/Target/TargetMachine.h"
+#include "rain/lang/code/context.hpp"
+#include "rain/lang/err/simple.hpp"
+#include "rain/lang/target/common/externs.hpp"
+#include "rain/lang/target/common/interpreter.hpp"
+#include "rain/util/colors.hpp"
+#include "rain/util/console.hpp"
+
+namespace rain::lang::native {
+
+namespace {
+
+std::string host_cpu_features() {
+    llvm::StringMap<bool> host_features;
+    if (!llvm::sys::getHostCPUFeatures(host_features)) {
+        return "";
+    }
+
+    std::string features;
+    for (const auto& feature : host_features) {
+        if (!features.empty()) {
+            features += ",";
+        }
+        features += (feature.getValue() ? "+" : "-");
+        features += feature.getKey();
+    }
+    return features;
+}
+
+/**
+ * The libm functions (and their number of arguments) that take and return doubles, each of which
+ * has a version for floats with an `f` suffix (for example `sinf`).
+ */
+constexpr std::array<std::pair<std::string_view, unsigned>, 25> LIBM_FUNCTIONS{{
+    {"acos", 1},  {"asin", 1},  {"atan", 1},  {"atan2", 2}, {"cbrt", 1},
+    {"ceil", 1},  {"cos", 1},   {"cosh", 1},  {"exp", 1},   {"exp2", 1},
+    {"fabs", 1},  {"floor", 1}, {"fmod", 2},  {"hypot", 2}, {"log", 1},
+    {"log10", 1}, {"log2", 1},  {"pow", 2},   {"round", 1}, {"sin", 1},
+    {"sinh", 1},  {"sqrt", 1},  {"tan", 1},   {"tanh", 1},  {"trunc", 1},
+}};
+
+/**
+ * Get the C symbol that implements an extern function named `name`. The libm functions are picked
+ * by the signature of the extern, since the symbol with the same name only takes doubles.
+ */
+util::Result<std::string> host_symbol(const std::string_view    name,
+                                      const llvm::FunctionType* llvm_function_type) {
+    const auto* it = std::find_if(LIBM_FUNCTIONS.begin(), LIBM_FUNCTIONS.end(),
+                                  [name](const auto& function) { return function.first == name; });
+    if (it == LIBM_FUNCTIONS.end()) {
+        return std::string(name);
+    }
+
+    llvm::Type* llvm_float_type = llvm_function_type->getReturnType();
+    bool        matches         = llvm_function_type->getNumParams() == it->second &&
+                   (llvm_float_type->isFloatTy() || llvm_float_type->isDoubleTy());
+    for (llvm::Type* llvm_param_type : llvm_function_type->params()) {
+        matches = matches && llvm_param_type == llvm_float_type;
+    }
+    if (!matches) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("extern \"", name, "\" must take ", it->second,
+                                    " argument(s) and return a value, all either f32 or f64"));
+    }
+
+    return llvm_float_type->isFloatTy() ? absl::StrCat(name, "f") : std::string(name);
+}
+
+}  // namespace
+
+Options::Options() : _target_triple(llvm::sys::getProcessTriple()) {}
+
+Options::~Options() {
+    for (const auto& function : _interpreter_functions) {
+        remove_interpreter_function(function);
+    }
+}
+
+std::unique_ptr<llvm::TargetMachine> Options::create_target_machine() {
+    std::string error;
+
+    std::string         target_triple = llvm::Triple::normalize(_target_triple);
+    const llvm::Target* target        = llvm::TargetRegistry::lookupTarget(target_triple, error);
+    if (target == nullptr) {
+        util::panic(ANSI_RED, "failed to lookup target: ", ANSI_RESET, error);
+    }
+
+    std::string cpu      = _cpu;
+    std::string features = _features;
+    if (cpu == "native") {
+        cpu = llvm::sys::getHostCPUName().str();
+        if (features.empty()) {
+            features = host_cpu_features();
+        }
+    }
+
+    // Position independent code, so that the objects can be linked into shared libraries.
+    return std::unique_ptr<llvm::TargetMachine>(target->createTargetMachine(
+        target_triple, cpu, features, llvm::TargetOptions(), llvm::Reloc::PIC_, std::nullopt,
+        llvm::CodeGenOpt::Default));
+}
+
+std::unique_ptr<llvm::ExecutionEngine> Options::create_engine(
+    std::unique_ptr<llvm::Module>        llvm_module,
+    std::unique_ptr<llvm::TargetMachine> llvm_target_machine) {
+    return create_interpreter(std::move(llvm_module), std::move(llvm_target_machine));
+}
+
+bool Options::extern_is_compile_time_runnable(const std::span<const std::string> keys) {
+    if (keys.size() < 2) {
+        return false;
+    }
+
+    return find_extern_function(keys[keys.size() - 2], keys[keys.size() - 1]) != nullptr;
+}
+
+util::Result<void> Options::validate_extern_keys(const std::span<const std::string> keys) const {
+    return {};
+}
+
+util::Result<void> Options::compile_extern_compile_time_runnable(
+    code::Context& ctx, llvm::Function* llvm_function, const std::span<const std::string> keys) {
+    // Natively, an extern is a call to the C symbol with the same name as the imported function
+    // (for example `extern "js" "math" "sin"` calls `sin`, or `sinf` for f32, from libm).
+    auto symbol_result = host_symbol(keys.back(), llvm_function->getFunctionType());
+    FORWARD_ERROR(symbol_result);
+    const std::string symbol = std::move(symbol_result).value();
+
+    // LLVM renames the function instead if another one already has the name.
+    llvm_function->setName(symbol);
+    if (llvm_function->getName() != symbol) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("cannot import extern \"", symbol,
+                                    "\", since another function in the module has that name"));
+    }
+
+    if (!extern_is_compile_time_runnable(keys)) {
+        return {};
+    }
+
+    llvm::ExFunc fn = find_extern_function(keys[keys.size() - 2], keys[keys.size() - 1]);
+    {
+        std::lock_guard lock(_interpreter_functions_mutex);
+        _interpreter_functions.emplace_back(symbol);
+        use_interpreter_function(symbol, fn);
+    }
+    return {};
+}
+
+}  // namespace rain::lang::native
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "llvm/IR/Function.h"
+#include "rain/lang/options.hpp"
+#include "rain/lang/target/native/init.hpp"
+
+namespace rain::lang::native {
+
+/**
+ * Compile for a native (x86-64 or AArch64) target, producing ELF objects that can be linked into
+ * shared libraries (see `native::link_shared_library`), instead of wasm.
+ *
+ * By default this targets the host that the compiler is running on.
+ */
+class Options : public ::rain::lang::Options {
+    std::string              _target_triple;
+    std::string              _cpu;
+    std::string              _features;
+    std::vector<std::string> _interpreter_functions;
+    bool                     _whole_program_devirtualization = false;
+
+    // Compiles may run in parallel (see `rain::compile_batch`), and each may register externs.
+    std::mutex _interpreter_functions_mutex;
+
+  public:
+    Options();
+    ~Options() override;
+
+    /** Set the target, for example "x86_64-unknown-linux-gnu" or "aarch64-unknown-linux-gnu". */
+    void set_target_triple(std::string target_triple) noexcept {
+        _target_triple = std::move(target_triple);
+    }
+
+    /** Set the CPU to tune for; "native" picks the host CPU and all of its features. */
+    void set_cpu(std::string cpu) noexcept { _cpu = std::move(cpu); }
+    void set_features(std::string features) noexcept { _features = std::move(features); }
+
+    /** See `::rain::lang::Options::whole_program_devirtualization`. */
+    void set_whole_program_devirtualization(const bool whole_program_devirtualization) noexcept {
+        _whole_program_devirtualization = whole_program_devirtualization;
+    }
+
+    [[nodiscard]] constexpr const std::string& target_triple() const noexcept {
+        return _target_triple;
+    }
+    [[nodiscard]] constexpr bool whole_program_devirtualization() const noexcept override {
+        return _whole_program_devirtualization;
+    }
+
+    [[nodiscard]] std::unique_ptr<llvm::TargetMachine>   create_target_machine() override;
+    [[nodiscard]] std::unique_ptr<llvm::ExecutionEngine> create_engine(
+        std::unique_ptr<llvm::Module>        llvm_module,
+        std::unique_ptr<llvm::TargetMachine> llvm_target_machine) override;
+
+    /** Natively, any keys are valid; the last one is the name of the C symbol to call. */
+    [[nodiscard]] util::Result<void> validate_extern_keys(
+        const std::span<const std::string> keys) const override;
+
+    [[nodiscard]] bool extern_is_compile_time_runnable(
+        const std::span<const std::string> keys) override;
+    [[nodiscard]] util::Result<void> compile_extern_compile_time_runnable(
+        code::Context& ctx, llvm::Function* llvm_function,
+        const std::span<const std::string> keys) override;
+};
+
+}  // namespace rain::lang::native
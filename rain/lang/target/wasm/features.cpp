@@ -0,0 +1,116 @@
+#include "rain/lang/target/wasm/features.hpp"
+
+#include <algorithm>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "rain/lang/err/simple.hpp"
+
+namespace rain::lang::wasm {
+
+namespace {
+
+struct Cpu {
+    std::string_view              name;
+    std::vector<std::string_view> features;
+};
+
+// These match the CPUs that the WebAssembly backend knows about.
+const std::array<Cpu, 3> CPUS = {{
+    {"bleeding-edge",
+     {"atomics", "bulk-memory", "mutable-globals", "nontrapping-fptoint", "sign-ext", "simd128",
+      "tail-call"}},
+    {"generic", {"mutable-globals", "sign-ext"}},
+    {"mvp", {}},
+}};
+
+struct Dependency {
+    std::string_view feature;
+    std::string_view requires_feature;
+};
+
+constexpr std::array<Dependency, 1> DEPENDENCIES = {{
+    {"relaxed-simd", "simd128"},
+}};
+
+bool contains(std::span<const std::string> features, std::string_view feature) {
+    return std::find(features.begin(), features.end(), feature) != features.end();
+}
+
+}  // namespace
+
+bool is_known_feature(const std::string_view feature) noexcept {
+    return std::binary_search(FEATURES.begin(), FEATURES.end(), feature);
+}
+
+util::Result<std::vector<std::string>> cpu_features(const std::string_view cpu) {
+    if (cpu.empty()) {
+        return std::vector<std::string>(DEFAULT_FEATURES.begin(), DEFAULT_FEATURES.end());
+    }
+
+    for (const auto& known_cpu : CPUS) {
+        if (known_cpu.name == cpu) {
+            return std::vector<std::string>(known_cpu.features.begin(), known_cpu.features.end());
+        }
+    }
+    return ERR_PTR(err::SimpleError, absl::StrCat("unknown wasm cpu \"", cpu,
+                                                  "\"; expected bleeding-edge, generic, or mvp"));
+}
+
+util::Result<void> apply_feature_string(std::vector<std::string>& features,
+                                        const std::string_view    feature_string) {
+    for (std::string_view feature : absl::StrSplit(feature_string, ',', absl::SkipWhitespace())) {
+        bool enable = true;
+        if (feature.starts_with('+')) {
+            feature.remove_prefix(1);
+        } else if (feature.starts_with('-')) {
+            enable = false;
+            feature.remove_prefix(1);
+        }
+
+        if (!is_known_feature(feature)) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("unknown wasm target feature \"", feature, "\""));
+        }
+
+        const auto it = std::find(features.begin(), features.end(), feature);
+        if (enable && it == features.end()) {
+            features.emplace_back(feature);
+        } else if (!enable && it != features.end()) {
+            features.erase(it);
+        }
+    }
+
+    std::sort(features.begin(), features.end());
+    return {};
+}
+
+util::Result<void> validate_features(const std::span<const std::string> features) {
+    for (const auto& feature : features) {
+        if (!is_known_feature(feature)) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("unknown wasm target feature \"", feature, "\""));
+        }
+    }
+
+    for (const auto& dependency : DEPENDENCIES) {
+        if (contains(features, dependency.feature) &&
+            !contains(features, dependency.requires_feature)) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("wasm target feature \"", dependency.feature,
+                                        "\" requires \"", dependency.requires_feature, "\""));
+        }
+    }
+    return {};
+}
+
+std::string feature_string(const std::span<const std::string> features) {
+    std::string result;
+    for (const auto feature : FEATURES) {
+        absl::StrAppend(&result, result.empty() ? "" : ",", contains(features, feature) ? "+" : "-",
+                        feature);
+    }
+    return result;
+}
+
+}  // namespace rain::lang::wasm
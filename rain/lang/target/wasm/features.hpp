@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "rain/util/result.hpp"
+
+namespace rain::lang::wasm {
+
+// clang-format off
+/** The target features understood by both the WebAssembly backend and the linker. */
+constexpr std::array<std::string_view, 13> FEATURES = {
+    // <keep_sorted>
+    "atomics",
+    "bulk-memory",
+    "exception-handling",
+    "extended-const",
+    "multimemory",
+    "multivalue",
+    "mutable-globals",
+    "nontrapping-fptoint",
+    "reference-types",
+    "relaxed-simd",
+    "sign-ext",
+    "simd128",
+    "tail-call",
+    // </keep_sorted>
+};
+
+/** The features that are enabled when no CPU is chosen; supported by every major browser. */
+constexpr std::array<std::string_view, 6> DEFAULT_FEATURES = {
+    // <keep_sorted>
+    "bulk-memory",
+    "multivalue",
+    "mutable-globals",
+    "nontrapping-fptoint",
+    "sign-ext",
+    "simd128",
+    // </keep_sorted>
+};
+
+/** The features that a module needs in order to share its memory between threads. */
+constexpr std::array<std::string_view, 2> SHARED_MEMORY_FEATURES = {
+    // <keep_sorted>
+    "atomics",
+    "bulk-memory",
+    // </keep_sorted>
+};
+// clang-format on
+
+[[nodiscard]] bool is_known_feature(std::string_view feature) noexcept;
+
+/**
+ * Return the features that the given CPU enables, or an error if the CPU is unknown. An empty CPU
+ * name selects `DEFAULT_FEATURES`.
+ */
+util::Result<std::vector<std::string>> cpu_features(std::string_view cpu);
+
+/**
+ * Apply an LLVM style feature string (for example "+tail-call,-simd128") to `features`. A feature
+ * without a prefix is enabled.
+ */
+util::Result<void> apply_feature_string(std::vector<std::string>& features,
+                                        std::string_view          feature_string);
+
+/** Check that every feature is known, and that the features they depend on are enabled too. */
+util::Result<void> validate_features(std::span<const std::string> features);
+
+/**
+ * Return the LLVM feature string that enables exactly the given features, disabling every other
+ * feature, so that the CPU does not implicitly enable any more of them.
+ */
+[[nodiscard]] std::string feature_string(std::span<const std::string> features);
+
+}  // namespace rain::lang::wasm
@@ -1,5 +1,7 @@
 #include "rain/lang/target/wasm/linker.hpp"
 
+#include <initializer_list>
+
 #include "lld/Common/CommonLinkerContext.h"
 #include "lld/Common/Memory.h"
 #include "lld/wasm/InputChunks.h"
@@ -7,6 +9,7 @@
 #include "lld/wasm/InputFiles.h"
 #include "lld/wasm/MarkLive.h"
 #include "lld/wasm/SymbolTable.h"
+#include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Target/TargetMachine.h"
 #include "rain/lang/err/simple.hpp"
 #include "rain/util/defer.hpp"
@@ -368,9 +371,10 @@ void splitSections() {
 
 }  // namespace
 
-std::unique_ptr<llvm::MemoryBuffer> writeResult();
+bool writeResult(llvm::function_ref<uint8_t*(size_t size)> allocate);
+bool writeResult(llvm::StringRef path);
 
-util::Result<std::unique_ptr<llvm::MemoryBuffer>> Linker::link() {
+util::Result<void> Linker::link_with(llvm::function_ref<bool()> write_result) {
     lld::CommonLinkerContext _ctx;
     auto                     _config = std::make_unique<lld::wasm::Configuration>();
     auto                     _symtab = std::make_unique<lld::wasm::SymbolTable>();
@@ -390,12 +394,23 @@ util::Result<std::unique_ptr<llvm::MemoryBuffer>> Linker::link() {
     if (!_memory_export_name.empty()) {
         lld::wasm::config->memoryExport = _memory_export_name;
     }
+    if (_features.has_value()) {
+        // Any input that uses a feature outside of this set fails the link (see `checkFeatures`).
+        lld::wasm::config->features = _features;
+    }
+    lld::wasm::config->maxMemory = _max_memory;
+    if (_shared_memory) {
+        // Every thread instantiates the module with the same memory, so it has to come from the
+        // host. The data segments become passive, and are initialized once by `__wasm_init_memory`.
+        lld::wasm::config->sharedMemory = true;
+        lld::wasm::config->memoryImport = {"env", "memory"};
+    }
 
     createSyntheticSymbols();
 
     {
-        for (auto& file : _files) {
-            lld::wasm::symtab->addFile(lld::wasm::createObjectFile(*file));
+        for (const auto& file : _files) {
+            lld::wasm::symtab->addFile(lld::wasm::createObjectFile(file));
         }
 
         for (auto& function_name : _force_export_symbols) {
@@ -431,13 +446,58 @@ util::Result<std::unique_ptr<llvm::MemoryBuffer>> Linker::link() {
     // Any remaining lazy symbols should be demoted to Undefined.
     demoteLazySymbols();
 
+    if (lld::wasm::config->sharedMemory) {
+        // Each thread needs a stack and thread-local storage of its own, which the host allocates
+        // and hands over through these after instantiating the module.
+        for (auto* sym : std::initializer_list<Symbol*>{WasmSym::stackPointer, WasmSym::initTLS,
+                                                        WasmSym::tlsSize, WasmSym::tlsAlign}) {
+            sym->forceExport = true;
+        }
+        // Written by `__wasm_init_tls`, which nothing else refers to.
+        WasmSym::tlsBase->markLive();
+    }
+
     // Do size optimizations: garbage collection.
     markLive();
 
     // Provide the indirect function table if needed.
     WasmSym::indirectFunctionTable = symtab->resolveIndirectFunctionTable(/*required =*/false);
 
-    return writeResult();
+    if (!write_result()) {
+        return ERR_PTR(err::SimpleError, "errors encountered while writing the linked output");
+    }
+    return {};
+}
+
+util::Result<std::unique_ptr<llvm::MemoryBuffer>> Linker::link() {
+    std::unique_ptr<llvm::WritableMemoryBuffer> out_buffer;
+
+    auto result = link([&out_buffer](size_t size) -> uint8_t* {
+        out_buffer = llvm::WritableMemoryBuffer::getNewUninitMemBuffer(size);
+        return out_buffer != nullptr ? reinterpret_cast<uint8_t*>(out_buffer->getBufferStart())
+                                     : nullptr;
+    });
+    FORWARD_ERROR(result);
+
+    return std::move(out_buffer);
+}
+
+util::Result<void> Linker::link(
+    llvm::function_ref<absl::Nullable<uint8_t*>(size_t size)> allocate) {
+    return link_with([allocate]() { return writeResult(allocate); });
+}
+
+util::Result<void> Linker::link_to_file(llvm::StringRef path) {
+    return link_with([path]() { return writeResult(path); });
+}
+
+util::Result<void> Linker::link(llvm::raw_pwrite_stream& ostream) {
+    auto result = link();
+    FORWARD_ERROR(result);
+
+    const auto buffer = std::move(result).value();
+    ostream.write(buffer->getBufferStart(), buffer->getBufferSize());
+    return {};
 }
 
 util::Result<void> Linker::add(llvm::Module&        llvm_module,
@@ -455,7 +515,10 @@ util::Result<void> Linker::add(llvm::Module&        llvm_module,
     // Based on the documentation for llvm::raw_svector_ostream, the underlying SmallString is
     // always up to date, so there is no need to call flush().
     // ostream.flush();
-    add(llvm::MemoryBuffer::getMemBufferCopy(code.str()));
+
+    // Hand the emitted object over to the linker without copying it.
+    add(std::make_unique<llvm::SmallVectorMemoryBuffer>(std::move(code),
+                                                        /*RequiresNullTerminator=*/false));
     return {};
 }
 
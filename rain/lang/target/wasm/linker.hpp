@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -10,7 +11,10 @@
 #include "lld/Common/Memory.h"
 #include "lld/wasm/InputChunks.h"
 #include "lld/wasm/InputElement.h"
+#include "absl/base/nullability.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
 #include "rain/util/result.hpp"
 
 namespace rain::lang::wasm {
@@ -23,27 +27,64 @@ namespace rain::lang::wasm {
  */
 class Linker {
     std::optional<uint32_t>  _stack_size;
+    uint32_t                 _max_memory    = 0;
+    bool                     _shared_memory = false;
     std::string_view         _memory_export_name;
     std::vector<std::string> _force_export_symbols;
 
-    std::vector<std::unique_ptr<llvm::MemoryBuffer>> _files;
+    // If set, the linker only allows these features, instead of inferring them from the inputs.
+    std::optional<std::vector<std::string>> _features;
+
+    std::vector<llvm::MemoryBufferRef>               _files;
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> _owned_files;
 
   public:
     void set_stack_size(const uint32_t stack_size) noexcept { _stack_size = stack_size; }
+    void set_max_memory(const uint32_t max_memory) noexcept { _max_memory = max_memory; }
+    void set_shared_memory(const bool shared_memory) noexcept { _shared_memory = shared_memory; }
     void set_memory_export_name(std::string_view memory_export_name) noexcept {
         _memory_export_name = memory_export_name;
     }
+    void set_features(std::span<const std::string> features) {
+        _features.emplace(features.begin(), features.end());
+    }
     void force_export_symbol(const char* function_name) noexcept {
         _force_export_symbols.emplace_back(function_name);
     }
 
     // `memory_buffer` must be bitcode or wasm.
     void add(std::unique_ptr<llvm::MemoryBuffer> memory_buffer) {
-        _files.emplace_back(std::move(memory_buffer));
+        _files.emplace_back(*memory_buffer);
+        _owned_files.emplace_back(std::move(memory_buffer));
     }
+
+    // Add a buffer without copying it. The memory must stay alive until after `link()` returns.
+    void add(llvm::MemoryBufferRef memory_buffer) { _files.emplace_back(memory_buffer); }
+
     util::Result<void> add(llvm::Module& llvm_module, llvm::TargetMachine& llvm_target_machine);
 
     [[nodiscard]] util::Result<std::unique_ptr<llvm::MemoryBuffer>> link();
+
+    /**
+     * Link, writing the wasm binary directly into the memory returned by `allocate`, which is
+     * called once with the exact size of the output (for example to place it in memory shared with
+     * the host). Returning null from `allocate` fails the link.
+     */
+    [[nodiscard]] util::Result<void> link(
+        llvm::function_ref<absl::Nullable<uint8_t*>(size_t size)> allocate);
+
+    /** Link, writing the wasm binary directly into the file at `path`. */
+    [[nodiscard]] util::Result<void> link_to_file(llvm::StringRef path);
+
+    /**
+     * Link, writing the wasm binary to `ostream`. The output has to be laid out in memory before it
+     * can be written to a stream, prefer one of the other overloads if the destination allows it.
+     */
+    [[nodiscard]] util::Result<void> link(llvm::raw_pwrite_stream& ostream);
+
+  private:
+    /** Link the files, and call `write_result` to write the output while the linker is set up. */
+    [[nodiscard]] util::Result<void> link_with(llvm::function_ref<bool()> write_result);
 };
 
 }  // namespace rain::lang::wasm
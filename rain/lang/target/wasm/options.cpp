@@ -1,127 +1,85 @@
 #include "rain/lang/target/wasm/options.hpp"
 
-#include <array>
-#include <cstdlib>
+#include <algorithm>
+#include <mutex>
 #include <span>
 #include <string_view>
-#include <tuple>
 
-#include "llvm/ADT/ArrayRef.h"
-#include "llvm/ExecutionEngine/GenericValue.h"
+#include "absl/strings/str_cat.h"
 #include "llvm/MC/TargetRegistry.h"
 #include "rain/lang/code/context.hpp"
+#include "rain/lang/err/simple.hpp"
+#include "rain/lang/target/common/externs.hpp"
 #include "rain/lang/target/common/interpreter.hpp"
 #include "rain/util/colors.hpp"
 #include "rain/util/console.hpp"
 
 namespace rain::lang::wasm {
 
-namespace {
-
-#define ASSERT_ARGUMENT_COUNT(name, expected_argument_count, got_argument_count)               \
-    if (llvm_arguments.size() != expected_argument_count) {                                    \
-        rain::util::panic(ANSI_RED, "bad builtin function call: \"", name, "\": ", ANSI_RESET, \
-                          "expected ", expected_argument_count, " argument",                   \
-                          (expected_argument_count == 1 ? "" : "s"), ", got ",                 \
-                          got_argument_count);                                                 \
+Options::~Options() {
+    for (const auto& function : _interpreter_functions) {
+        remove_interpreter_function(function);
     }
-
-llvm::GenericValue lle_X_atan2(llvm::FunctionType*                llvm_function_type,
-                               llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
-    ASSERT_ARGUMENT_COUNT("atan2", 2, llvm_arguments.size());
-
-    llvm::GenericValue result;
-    result.FloatVal = std::atan2(llvm_arguments[0].FloatVal, llvm_arguments[1].FloatVal);
-    return result;
 }
 
-llvm::GenericValue lle_X_cos(llvm::FunctionType*                llvm_function_type,
-                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
-    ASSERT_ARGUMENT_COUNT("cos", 1, llvm_arguments.size());
+void Options::set_shared_memory(const bool shared_memory) {
+    _shared_memory = shared_memory;
+    if (!shared_memory) {
+        return;
+    }
 
-    llvm::GenericValue result;
-    result.FloatVal = std::cos(llvm_arguments[0].FloatVal);
-    return result;
+    for (const auto feature : SHARED_MEMORY_FEATURES) {
+        if (!has_feature(feature)) {
+            _features.emplace_back(feature);
+        }
+    }
+    std::sort(_features.begin(), _features.end());
 }
 
-llvm::GenericValue lle_X_sin(llvm::FunctionType*                llvm_function_type,
-                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
-    ASSERT_ARGUMENT_COUNT("sin", 1, llvm_arguments.size());
+util::Result<void> Options::set_cpu(std::string cpu) {
+    auto features_result = cpu_features(cpu);
+    FORWARD_ERROR(features_result);
+
+    auto features     = std::move(features_result).value();
+    auto check_result = check_shared_memory(features);
+    FORWARD_ERROR(check_result);
 
-    llvm::GenericValue result;
-    result.FloatVal = std::sin(llvm_arguments[0].FloatVal);
-    return result;
+    _cpu      = std::move(cpu);
+    _features = std::move(features);
+    return {};
 }
 
-llvm::GenericValue lle_X_sqrt(llvm::FunctionType*                llvm_function_type,
-                              llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
-    ASSERT_ARGUMENT_COUNT("sqrt", 1, llvm_arguments.size());
+util::Result<void> Options::set_features(const std::string_view feature_string) {
+    auto features = _features;
+    auto result   = apply_feature_string(features, feature_string);
+    FORWARD_ERROR(result);
 
-    llvm::GenericValue result;
-    result.FloatVal = std::sqrt(llvm_arguments[0].FloatVal);
-    return result;
-}
+    auto validate_result = validate_features(features);
+    FORWARD_ERROR(validate_result);
 
-llvm::GenericValue lle_X_tan(llvm::FunctionType*                llvm_function_type,
-                             llvm::ArrayRef<llvm::GenericValue> llvm_arguments) {
-    ASSERT_ARGUMENT_COUNT("tan", 1, llvm_arguments.size());
+    auto check_result = check_shared_memory(features);
+    FORWARD_ERROR(check_result);
 
-    llvm::GenericValue result;
-    result.FloatVal = std::tan(llvm_arguments[0].FloatVal);
-    return result;
+    _features = std::move(features);
+    return {};
 }
 
-#undef ASSERT_ARGUMENT_COUNT
-
-using ExternFunction  = std::tuple<const std::string_view, const llvm::ExFunc>;
-using ExternNamespace = std::tuple<const std::string_view, std::span<const ExternFunction>>;
-
-static constexpr const std::array<ExternFunction, 5> MATH_FUNCTIONS{
-    // clang-format off
-    // <keep_sorted>
-    ExternFunction{"atan2", lle_X_atan2},
-    ExternFunction{"cos", lle_X_cos},
-    ExternFunction{"sin", lle_X_sin},
-    ExternFunction{"sqrt", lle_X_sqrt},
-    ExternFunction{"tan", lle_X_tan},
-    // </keep_sorted>
-    // clang-format on
-};
-
-static constexpr const std::array<ExternNamespace, 1> EXTERN_NAMESPACES{
-    // clang-format off
-    // <keep_sorted>
-    ExternNamespace{"math", MATH_FUNCTIONS},
-    // </keep_sorted>
-    // clang-format on
-};
-
-llvm::ExFunc find_extern_function(const std::string_view namespace_name,
-                                  const std::string_view function_name) {
-    const auto found_namespace =
-        std::lower_bound(EXTERN_NAMESPACES.begin(), EXTERN_NAMESPACES.end(), namespace_name,
-                         [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < rhs; });
-    if (found_namespace == EXTERN_NAMESPACES.end()) {
-        return nullptr;
+util::Result<void> Options::check_shared_memory(const std::span<const std::string> features) const {
+    if (!_shared_memory) {
+        return {};
     }
 
-    const auto& [namespace_name_, functions] = *found_namespace;
-    const auto found_function =
-        std::lower_bound(functions.begin(), functions.end(), function_name,
-                         [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < rhs; });
-    if (found_function == functions.end()) {
-        return nullptr;
+    for (const auto feature : SHARED_MEMORY_FEATURES) {
+        if (std::find(features.begin(), features.end(), feature) == features.end()) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("shared memory requires the \"", feature, "\" feature"));
+        }
     }
-
-    return std::get<1>(*found_function);
+    return {};
 }
 
-}  // namespace
-
-Options::~Options() {
-    for (const auto& function : _interpreter_functions) {
-        remove_interpreter_function(function);
-    }
+bool Options::has_feature(const std::string_view feature) const noexcept {
+    return std::find(_features.begin(), _features.end(), feature) != _features.end();
 }
 
 std::unique_ptr<llvm::TargetMachine> Options::create_target_machine() {
@@ -133,11 +91,9 @@ std::unique_ptr<llvm::TargetMachine> Options::create_target_machine() {
         util::panic(ANSI_RED, "failed to lookup target: ", ANSI_RESET, error);
     }
 
-    std::string cpu;
-    std::string features =
-        "+simd128,+sign-ext,+bulk-memory,+mutable-globals,+nontrapping-fptoint,+multivalue";
     return std::unique_ptr<llvm::TargetMachine>(
-        target->createTargetMachine(target_triple, cpu, features, llvm::TargetOptions(),
+        target->createTargetMachine(target_triple, _cpu, feature_string(_features),
+                                    llvm::TargetOptions(),
                                     std::nullopt, std::nullopt, llvm::CodeGenOpt::Default));
 }
 
@@ -155,18 +111,20 @@ bool Options::extern_is_compile_time_runnable(const std::span<const std::string>
     return find_extern_function(keys[1], keys[2]) != nullptr;
 }
 
-void Options::compile_extern_compile_time_runnable(code::Context&                     ctx,
-                                                   llvm::Function*                    llvm_function,
-                                                   const std::span<const std::string> keys) {
+util::Result<void> Options::compile_extern_compile_time_runnable(
+    code::Context& ctx, llvm::Function* llvm_function, const std::span<const std::string> keys) {
     const std::string& function_name = llvm_function->getName().str();
-    _interpreter_functions.emplace_back(function_name);
-
-    llvm::ExFunc fn = find_extern_function(keys[1], keys[2]);
-    use_interpreter_function(function_name, fn);
+    llvm::ExFunc       fn            = find_extern_function(keys[1], keys[2]);
+    {
+        std::lock_guard lock(_interpreter_functions_mutex);
+        _interpreter_functions.emplace_back(function_name);
+        use_interpreter_function(function_name, fn);
+    }
 
     llvm_function->addFnAttr(
         llvm::Attribute::get(ctx.llvm_context(), "wasm-import-module", keys[1]));
     llvm_function->addFnAttr(llvm::Attribute::get(ctx.llvm_context(), "wasm-import-name", keys[2]));
+    return {};
 }
 
 }  // namespace rain::lang::wasm
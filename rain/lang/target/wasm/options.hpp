@@ -1,21 +1,33 @@
 #pragma once
 
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "llvm/IR/Function.h"
 #include "rain/lang/options.hpp"
+#include "rain/lang/target/wasm/features.hpp"
 #include "rain/lang/target/wasm/init.hpp"
+#include "rain/util/result.hpp"
 
 namespace rain::lang::wasm {
 
 class Options : public ::rain::lang::Options {
-    uint32_t                 _stack_size = 0;
+    uint32_t                 _stack_size                     = 0;
+    uint32_t                 _max_memory                     = 0;
+    bool                     _shared_memory                  = false;
+    bool                     _whole_program_devirtualization = false;
     std::string              _memory_export_name;
+    std::string              _cpu;
+    std::vector<std::string> _features{DEFAULT_FEATURES.begin(), DEFAULT_FEATURES.end()};
     std::vector<std::string> _interpreter_functions;
 
+    // Compiles may run in parallel (see `rain::compile_batch`), and each may register externs.
+    std::mutex _interpreter_functions_mutex;
+
   public:
     ~Options() override;
 
@@ -24,11 +36,60 @@ class Options : public ::rain::lang::Options {
         _memory_export_name = std::move(memory_export_name);
     }
 
+    /** Set the most memory (in bytes, a multiple of 64KiB) that the module may grow to use. */
+    void set_max_memory(const uint32_t max_memory) noexcept { _max_memory = max_memory; }
+
+    /**
+     * Build a module whose memory can be shared between threads (web workers), which also enables
+     * the features that shared memory needs (see `SHARED_MEMORY_FEATURES`).
+     *
+     * The memory is then imported as "env" "memory", so that every thread can instantiate the
+     * module with the same memory, and is not allowed to grow past `max_memory` (or its initial
+     * size, if no maximum is set). Each thread has to point the exported `__stack_pointer` at a
+     * stack of its own, and call `__wasm_init_tls` with a block of `__tls_size` bytes (aligned to
+     * `__tls_align`) before calling anything else.
+     */
+    void set_shared_memory(bool shared_memory);
+
+    /**
+     * Set the CPU to compile for ("mvp", "generic", or "bleeding-edge"), which also resets the
+     * enabled features to the ones that the CPU supports. Shared memory must be disabled first to
+     * pick a CPU without the features it needs.
+     */
+    util::Result<void> set_cpu(std::string cpu);
+
+    /**
+     * Enable or disable features with an LLVM style feature string, for example
+     * "+tail-call,+relaxed-simd,-bulk-memory", on top of the currently enabled features. Nothing
+     * changes if the resulting set of features is not valid (or no longer allows shared memory).
+     */
+    util::Result<void> set_features(std::string_view feature_string);
+
+    /** See `::rain::lang::Options::whole_program_devirtualization`. */
+    void set_whole_program_devirtualization(const bool whole_program_devirtualization) noexcept {
+        _whole_program_devirtualization = whole_program_devirtualization;
+    }
+
+    [[nodiscard]] constexpr const std::string& cpu() const noexcept { return _cpu; }
+    [[nodiscard]] bool                         has_feature(std::string_view feature) const noexcept;
+
     [[nodiscard]] constexpr bool     optimize() const noexcept override { return true; }
     [[nodiscard]] constexpr uint32_t stack_size() const noexcept override { return _stack_size; }
+    [[nodiscard]] constexpr uint32_t max_memory() const noexcept override { return _max_memory; }
+    [[nodiscard]] constexpr bool     shared_memory() const noexcept override {
+        return _shared_memory;
+    }
     [[nodiscard]] constexpr std::string_view memory_export_name() const noexcept override {
         return _memory_export_name;
     }
+    [[nodiscard]] bool tail_calls() const noexcept override { return has_feature("tail-call"); }
+    [[nodiscard]] constexpr bool whole_program_devirtualization() const noexcept override {
+        return _whole_program_devirtualization;
+    }
+    [[nodiscard]] std::optional<std::span<const std::string>> target_features()
+        const noexcept override {
+        return _features;
+    }
 
     [[nodiscard]] std::unique_ptr<llvm::TargetMachine>   create_target_machine() override;
     [[nodiscard]] std::unique_ptr<llvm::ExecutionEngine> create_engine(
@@ -37,8 +98,14 @@ class Options : public ::rain::lang::Options {
 
     [[nodiscard]] bool extern_is_compile_time_runnable(
         const std::span<const std::string> keys) override;
-    void compile_extern_compile_time_runnable(code::Context& ctx, llvm::Function* llvm_function,
-                                              const std::span<const std::string> keys) override;
+    [[nodiscard]] util::Result<void> compile_extern_compile_time_runnable(
+        code::Context& ctx, llvm::Function* llvm_function,
+        const std::span<const std::string> keys) override;
+
+  private:
+    /** Check that `features` still allow the memory to be shared, if it is. */
+    [[nodiscard]] util::Result<void> check_shared_memory(
+        std::span<const std::string> features) const;
 };
 
 }  // namespace rain::lang::wasm
\ No newline at end of file
@@ -66,6 +66,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <cstdarg>
+#include <cstring>
 #include <map>
 #include <optional>
 
@@ -81,22 +82,26 @@ static constexpr int heapAlignment = 16;
 namespace {
 
 // <change>
-// A FileOutputBuffer which keeps data in memory and DOES NOT write to the final output file on commit().
+// A FileOutputBuffer which writes directly into memory owned by the caller, and DOES NOT write to
+// the final output file on commit().
 class InMemoryBuffer : public FileOutputBuffer {
 public:
-  InMemoryBuffer(llvm::MemoryBuffer* buffer) : FileOutputBuffer("-"), _buffer{buffer} {}
+  InMemoryBuffer(uint8_t* start, size_t size) : FileOutputBuffer("-"), _start{start}, _size{size} {}
 
-  uint8_t *getBufferStart() const override { return (uint8_t *)_buffer->getBufferStart(); }
+  uint8_t *getBufferStart() const override { return _start; }
 
-  uint8_t *getBufferEnd() const override { return (uint8_t *)_buffer->getBufferEnd(); }
+  uint8_t *getBufferEnd() const override { return _start + _size; }
 
-  size_t getBufferSize() const override { return _buffer->getBufferSize(); }
+  size_t getBufferSize() const override { return _size; }
 
   Error commit() override { return Error::success(); }
 
 private:
-    llvm::MemoryBuffer* _buffer;
+    uint8_t* _start;
+    size_t   _size;
 };
+
+using OpenOutput = llvm::function_ref<Expected<std::unique_ptr<FileOutputBuffer>>(size_t size)>;
 // </change>
 
 // The writer writes a SymbolTable result to a file.
@@ -104,13 +109,13 @@ class Writer {
 public:
 // <change>
 //   void run();
-  void run(std::unique_ptr<llvm::MemoryBuffer>& out_buffer);
+  void run(OpenOutput open_output);
 // </change>
 
 private:
 // <change>
 //   void openFile();
-  void openFile(std::unique_ptr<llvm::MemoryBuffer>& out_buffer);
+  void openFile(OpenOutput open_output);
 // </change>
 
   bool needsPassiveInitialization(const OutputSegment *segment);
@@ -1733,7 +1738,7 @@ void Writer::createSyntheticSectionsPostLayout() {
 
 // <change>
 // void Writer::run() {
-void Writer::run(std::unique_ptr<llvm::MemoryBuffer>& out_buffer) {
+void Writer::run(OpenOutput open_output) {
 // </change>
   // For PIC code the table base is assigned dynamically by the loader.
   // For non-PIC, we start at 1 so that accessing table index 0 always traps.
@@ -1881,7 +1886,7 @@ void Writer::run(std::unique_ptr<llvm::MemoryBuffer>& out_buffer) {
   log("-- openFile");
 // <change>
 //   openFile();
-  openFile(out_buffer);
+  openFile(open_output);
 // </change>
   if (errorCount())
     return;
@@ -1902,7 +1907,7 @@ void Writer::run(std::unique_ptr<llvm::MemoryBuffer>& out_buffer) {
 // Open a result file.
 // <change>
 // void Writer::openFile() {
-void Writer::openFile(std::unique_ptr<MemoryBuffer>& out_buffer) {
+void Writer::openFile(OpenOutput open_output) {
 // </change>
   log("writing: " + config->outputFile);
 
@@ -1917,8 +1922,11 @@ void Writer::openFile(std::unique_ptr<MemoryBuffer>& out_buffer) {
 //  else
 //    buffer = std::move(*bufferOrErr);
 
-  out_buffer = WritableMemoryBuffer::getNewMemBuffer(fileSize);
-  buffer = std::make_unique<InMemoryBuffer>(out_buffer.get());
+  Expected<std::unique_ptr<FileOutputBuffer>> bufferOrErr = open_output(fileSize);
+  if (!bufferOrErr)
+    error("failed to open output: " + toString(bufferOrErr.takeError()));
+  else
+    buffer = std::move(*bufferOrErr);
 // </change>
 }
 
@@ -1937,10 +1945,28 @@ void Writer::createHeader() {
 
 namespace rain::lang::wasm {
 
-std::unique_ptr<llvm::MemoryBuffer> writeResult() {
-    std::unique_ptr<llvm::MemoryBuffer> out_buffer;
-    lld::wasm::Writer().run(out_buffer);
-    return out_buffer;
+bool writeResult(llvm::function_ref<uint8_t*(size_t size)> allocate) {
+    lld::wasm::Writer().run(
+        [allocate](size_t size) -> Expected<std::unique_ptr<FileOutputBuffer>> {
+            uint8_t* start = allocate(size);
+            if (start == nullptr) {
+                return llvm::createStringError(llvm::inconvertibleErrorCode(),
+                                               "failed to allocate the output buffer");
+            }
+
+            // The writer expects the parts of the output that it does not write to be zeroed, as
+            // they would be in a newly created file.
+            std::memset(start, 0, size);
+            return std::make_unique<lld::wasm::InMemoryBuffer>(start, size);
+        });
+    return lld::errorCount() == 0;
+}
+
+bool writeResult(llvm::StringRef path) {
+    lld::wasm::Writer().run([path](size_t size) {
+        return FileOutputBuffer::create(path, size, FileOutputBuffer::F_executable);
+    });
+    return lld::errorCount() == 0;
 }
 
 } // namespace rain::lang::wasm
@@ -0,0 +1,38 @@
+#include "rain/batch.hpp"
+
+#include <optional>
+
+#include "rain/compile.hpp"
+
+namespace rain {
+
+std::vector<util::Result<lang::code::Module>> compile_batch(std::span<const Source> sources,
+                                                            lang::Options&          options,
+                                                            llvm::ThreadPool&       thread_pool) {
+    // Results are not default constructible, so each task fills in its own slot.
+    std::vector<std::optional<util::Result<lang::code::Module>>> slots(sources.size());
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        thread_pool.async([&sources, &options, &slots, i]() {
+            const auto& source = sources[i];
+
+            lang::code::Module code_module(options);
+            auto result = compile(source.code, options, code_module, nullptr, source.file_name);
+            if (!result.has_value()) {
+                slots[i].emplace(tl::unexpected(std::move(result).error()));
+                return;
+            }
+            slots[i].emplace(std::move(code_module));
+        });
+    }
+    thread_pool.wait();
+
+    std::vector<util::Result<lang::code::Module>> results;
+    results.reserve(sources.size());
+    for (auto& slot : slots) {
+        results.emplace_back(std::move(slot).value());
+    }
+    return results;
+}
+
+}  // namespace rain
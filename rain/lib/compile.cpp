@@ -1,5 +1,6 @@
 #include "rain/compile.hpp"
 
+#include <memory>
 #include <string_view>
 
 #include "rain/lang/ast/scope/builtin.hpp"
@@ -17,12 +18,38 @@ namespace rain {
 using namespace lang;
 
 util::Result<code::Module> compile(const std::string_view source) {
-    wasm::Options options;
-    return compile(source, options);
+    // The module keeps using the options after it is returned, so it has to own them.
+    auto         owned_options = std::make_unique<wasm::Options>();
+    auto&        options       = *owned_options;
+    code::Module code_module(std::move(owned_options));
+    auto         result = compile(source, options, code_module, nullptr);
+    FORWARD_ERROR(result);
+
+    return code_module;
 }
 
 util::Result<code::Module> compile(const std::string_view source, Options& options) {
-    auto               lexer      = lex::LazyLexer::using_source(source, "<unknown>");
+    code::Module code_module(options);
+    auto         result = compile(source, options, code_module, nullptr);
+    FORWARD_ERROR(result);
+
+    return code_module;
+}
+
+util::Result<code::Module> compile(const std::string_view source, Options& options,
+                                   code::FunctionCache& function_cache) {
+    code::Module code_module(options);
+    auto         result = compile(source, options, code_module, &function_cache);
+    FORWARD_ERROR(result);
+
+    return code_module;
+}
+
+util::Result<void> compile(const std::string_view source, Options& options,
+                           code::Module&                        code_module,
+                           absl::Nullable<code::FunctionCache*> function_cache,
+                           const std::string_view               file_name) {
+    auto               lexer      = lex::LazyLexer::using_source(source, file_name);
     lex::LazyListLexer list_lexer = lex::LazyListLexer::using_lexer(lexer);
 
     ast::BuiltinScope builtin;
@@ -33,11 +60,23 @@ util::Result<code::Module> compile(const std::string_view source, Options& optio
     auto validate_result = parse_module->validate(options);
     FORWARD_ERROR(validate_result);
 
-    code::Module  code_module(options);
+    if (function_cache != nullptr) {
+        function_cache->begin(code::FunctionGraph::build(
+            *parse_module, code::target_fingerprint(options, code_module.llvm_target_machine())));
+    }
+
     code::Context ctx(code_module, options);
+    ctx.set_function_cache(function_cache);
     code::compile_module(ctx, *parse_module);
+    auto compile_result = ctx.take_error();
+    FORWARD_ERROR(compile_result);
 
-    return code_module;
+    if (function_cache != nullptr) {
+        auto finish_result = function_cache->finish(code_module.llvm_module());
+        FORWARD_ERROR(finish_result);
+    }
+
+    return {};
 }
 
 }  // namespace rain
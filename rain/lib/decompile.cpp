@@ -1,7 +1,10 @@
 #include "rain/decompile.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "rain/lang/err/simple.hpp"
@@ -41,11 +44,46 @@ class WabtBuffer : public Buffer {
     }
 };
 
-}  // namespace
+/** A wabt stream that passes along the written text in chunks, instead of keeping all of it. */
+class SinkStream : public wabt::Stream {
+    const DecompileSink& _sink;
+    std::string          _chunk;
+    size_t               _chunk_size;
 
-util::Result<std::unique_ptr<Buffer>> decompile(const std::span<const uint8_t> wasm) {
-    wabt::Features features;
+  public:
+    SinkStream(const DecompileSink& sink, size_t chunk_size)
+        : _sink(sink), _chunk_size(chunk_size) {
+        _chunk.reserve(chunk_size);
+    }
+    ~SinkStream() override = default;
+
+    void flush_chunk() {
+        if (!_chunk.empty()) {
+            _sink(_chunk);
+            _chunk.clear();
+        }
+    }
+
+  protected:
+    wabt::Result WriteDataImpl(size_t /*offset*/, const void* data, size_t size) override {
+        _chunk.append(static_cast<const char*>(data), size);
+        if (_chunk.size() >= _chunk_size) {
+            flush_chunk();
+        }
+        return wabt::Result::Ok;
+    }
 
+    // The WAT writer only ever appends, so the text that was already passed to the sink never
+    // has to change.
+    wabt::Result MoveDataImpl(size_t /*dst_offset*/, size_t /*src_offset*/,
+                              size_t /*size*/) override {
+        return wabt::Result::Error;
+    }
+    wabt::Result TruncateImpl(size_t /*size*/) override { return wabt::Result::Error; }
+};
+
+util::Result<void> read_module(const std::span<const uint8_t> wasm,
+                               const wabt::Features& features, wabt::Module& wasm_module) {
     constexpr bool          read_debug_names             = true;
     constexpr bool          stop_on_first_error          = true;
     constexpr bool          fail_on_custom_section_error = true;
@@ -53,7 +91,6 @@ util::Result<std::unique_ptr<Buffer>> decompile(const std::span<const uint8_t> w
                                     fail_on_custom_section_error);
 
     wabt::Errors errors;
-    wabt::Module wasm_module;
     if (const auto result =
             wabt::ReadBinaryIr("<wasm>", reinterpret_cast<const uint8_t*>(wasm.data()),
                                wasm.size_bytes(), options, &errors, &wasm_module);
@@ -69,15 +106,77 @@ util::Result<std::unique_ptr<Buffer>> decompile(const std::span<const uint8_t> w
     }
 
     [[maybe_unused]] auto _result = wabt::ApplyNames(&wasm_module);
+    return {};
+}
+
+/** The decompiler should read anything the compiler may have been asked to produce. */
+wabt::Features all_features() {
+    wabt::Features features;
+    features.EnableAll();
+    return features;
+}
 
+wabt::WriteWatOptions wat_options(const wabt::Features& features) {
     wabt::WriteWatOptions wat_options(features);
     wat_options.fold_exprs    = false;
     wat_options.inline_import = false;
     wat_options.inline_export = false;
+    return wat_options;
+}
+
+}  // namespace
+
+util::Result<std::unique_ptr<Buffer>> decompile(const std::span<const uint8_t> wasm) {
+    const auto features = all_features();
+
+    wabt::Module wasm_module;
+    auto         read_result = read_module(wasm, features, wasm_module);
+    FORWARD_ERROR(read_result);
 
-    wabt::MemoryStream stream(std::make_unique<wabt::OutputBuffer>());
-    _result = wabt::WriteWat(&stream, &wasm_module, wat_options);
+    wabt::MemoryStream    stream(std::make_unique<wabt::OutputBuffer>());
+    [[maybe_unused]] auto _result = wabt::WriteWat(&stream, &wasm_module, wat_options(features));
     return std::make_unique<WabtBuffer>(std::move(stream.ReleaseOutputBuffer()->data));
 }
 
+util::Result<void> decompile(const std::span<const uint8_t> wasm, const DecompileSink& sink,
+                             const DecompileOptions& options) {
+    const auto features = all_features();
+
+    wabt::Module wasm_module;
+    auto         read_result = read_module(wasm, features, wasm_module);
+    FORWARD_ERROR(read_result);
+
+    if (!options.functions.empty()) {
+        const auto is_selected = [&options](std::string_view name) {
+            if (name.starts_with('$')) {
+                name.remove_prefix(1);
+            }
+            return std::any_of(options.functions.begin(), options.functions.end(),
+                               [name](std::string_view selected) {
+                                   if (selected.starts_with('$')) {
+                                       selected.remove_prefix(1);
+                                   }
+                                   return selected == name;
+                               });
+        };
+
+        // Writing the function bodies is where nearly all of the time goes, so the unselected
+        // functions are written as just their signatures.
+        for (auto* func : wasm_module.funcs) {
+            if (!is_selected(func->name)) {
+                func->exprs.clear();
+            }
+        }
+    }
+
+    SinkStream stream(sink, std::max<size_t>(options.chunk_size, 1));
+    if (const auto result = wabt::WriteWat(&stream, &wasm_module, wat_options(features));
+        !wabt::Succeeded(result)) {
+        return ERR_PTR(err::SimpleError, "failed to write WAT");
+    }
+    stream.flush_chunk();
+
+    return {};
+}
+
 }  // namespace rain
@@ -1,8 +1,15 @@
 #include "rain/link.hpp"
 
+#include <string>
+
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IRReader/IRReader.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/TargetParser/Triple.h"
+#include "rain/lang/code/bitcode.hpp"
 #include "rain/lang/err/simple.hpp"
 #include "rain/lang/target/wasm/linker.hpp"
 #include "rain/util/result.hpp"
@@ -28,32 +35,105 @@ class LlvmBuffer : public Buffer {
     }
 };
 
+void configure(lang::wasm::Linker& linker, lang::Options& options) {
+    linker.set_stack_size(options.stack_size());
+    linker.set_max_memory(options.max_memory());
+    linker.set_shared_memory(options.shared_memory());
+    linker.set_memory_export_name(options.memory_export_name());
+    if (const auto features = options.target_features(); features.has_value()) {
+        linker.set_features(*features);
+    }
+}
+
+util::Result<void> add_module(lang::wasm::Linker& linker, lang::code::Module& module,
+                              lang::Options& options) {
+    // TODO: Support more targets.
+    configure(linker, options);
+    return linker.add(module.llvm_module(), module.llvm_target_machine());
+}
+
 }  // namespace
 
 util::Result<std::unique_ptr<Buffer>> link(lang::code::Module& module, lang::Options& options) {
-    // TODO: Support more targets.
     lang::wasm::Linker linker;
-    linker.set_stack_size(options.stack_size());
-    linker.set_memory_export_name(options.memory_export_name());
-    linker.add(module.llvm_module(), module.llvm_target_machine());
+    auto               add_result = add_module(linker, module, options);
+    FORWARD_ERROR(add_result);
+
     auto result = linker.link();
     FORWARD_ERROR(result);
     return std::make_unique<LlvmBuffer>(std::move(result).value());
 }
 
-// util::Result<std::unique_ptr<Buffer>> link(const std::string_view llvm_ir, lang::Options&
-// options) {
-//     // NOTE: Make sure that the LLVMContext lives as long as the Module.
-//     std::shared_ptr<llvm::LLVMContext> llvm_ctx = std::make_shared<llvm::LLVMContext>();
+util::Result<void> link(lang::code::Module& module, lang::Options& options,
+                        llvm::function_ref<absl::Nullable<uint8_t*>(size_t size)> allocate) {
+    lang::wasm::Linker linker;
+    auto               add_result = add_module(linker, module, options);
+    FORWARD_ERROR(add_result);
+
+    return linker.link(allocate);
+}
 
-//     llvm::SMDiagnostic            llvm_err;
-//     auto                          llvm_buffer = llvm::MemoryBuffer::getMemBufferCopy(llvm_ir);
-//     std::unique_ptr<llvm::Module> llvm_module = llvm::parseIR(*llvm_buffer, llvm_err, *llvm_ctx);
-//     if (llvm_module == nullptr) {
-//         return ERR_PTR(lang::err::SimpleError, llvm_err.getMessage().str());
-//     }
+util::Result<void> link(lang::code::Module& module, lang::Options& options,
+                        llvm::raw_pwrite_stream& ostream) {
+    lang::wasm::Linker linker;
+    auto               add_result = add_module(linker, module, options);
+    FORWARD_ERROR(add_result);
 
-//     return link(*llvm_module, llvm_target_machine);
-// }
+    return linker.link(ostream);
+}
+
+util::Result<std::unique_ptr<Buffer>> link(const std::string_view llvm_ir, lang::Options& options) {
+    // Compressed bitcode must stay alive until the link is done, as the linker reads it in place.
+    std::string bitcode;
+    if (lang::code::is_compressed_bitcode(llvm_ir)) {
+        auto decompress_result = lang::code::decompress_bitcode(llvm_ir);
+        FORWARD_ERROR(decompress_result);
+        bitcode = std::move(decompress_result).value();
+    }
+
+    const std::string_view      input = bitcode.empty() ? llvm_ir : bitcode;
+    const llvm::MemoryBufferRef buffer(llvm::StringRef(input.data(), input.size()), "<llvm>");
+
+    lang::wasm::Linker linker;
+    configure(linker, options);
+
+    // NOTE: Make sure that the LLVMContext lives as long as the Module.
+    llvm::LLVMContext             llvm_ctx;
+    llvm::SMDiagnostic            llvm_err;
+    std::unique_ptr<llvm::Module> llvm_module;
+
+    if (llvm::isBitcode(reinterpret_cast<const uint8_t*>(buffer.getBufferStart()),
+                        reinterpret_cast<const uint8_t*>(buffer.getBufferEnd()))) {
+        // The linker reads bitcode itself, so there is no need to materialize any of the function
+        // bodies here; only the module header is read, to fail early with a useful error if the
+        // bitcode was built for the wrong target.
+        llvm_module = llvm::getLazyIRModule(
+            llvm::MemoryBuffer::getMemBuffer(buffer, /*RequiresNullTerminator=*/false), llvm_err,
+            llvm_ctx);
+        if (llvm_module == nullptr) {
+            return ERR_PTR(lang::err::SimpleError, llvm_err.getMessage().str());
+        }
+        if (const llvm::Triple triple(llvm_module->getTargetTriple()); !triple.isWasm()) {
+            return ERR_PTR(lang::err::SimpleError,
+                           "bitcode was compiled for target '" + triple.str() +
+                               "', expected a wasm target");
+        }
+
+        linker.add(buffer);
+    } else {
+        llvm_module = llvm::parseIR(buffer, llvm_err, llvm_ctx);
+        if (llvm_module == nullptr) {
+            return ERR_PTR(lang::err::SimpleError, llvm_err.getMessage().str());
+        }
+
+        auto llvm_target_machine = options.create_target_machine();
+        auto add_result          = linker.add(*llvm_module, *llvm_target_machine);
+        FORWARD_ERROR(add_result);
+    }
+
+    auto result = linker.link();
+    FORWARD_ERROR(result);
+    return std::make_unique<LlvmBuffer>(std::move(result).value());
+}
 
 }  // namespace rain
@@ -0,0 +1,356 @@
+#include "rain/load.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_split.h"
+#include "rain/lang/code/context.hpp"
+#include "rain/lang/code/expr/all.hpp"
+#include "rain/lang/err/simple.hpp"
+#include "rain/lang/err/syntax.hpp"
+#include "rain/lang/lex/lazy.hpp"
+#include "rain/lang/parse/module.hpp"
+
+namespace rain {
+
+using namespace lang;
+
+namespace {
+
+template <typename Fn>
+void for_each_parallel(absl::Nullable<llvm::ThreadPool*> thread_pool, size_t count, Fn&& fn) {
+    if (thread_pool == nullptr) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        thread_pool->async([&fn, i]() { fn(i); });
+    }
+    thread_pool->wait();
+}
+
+util::Result<void> parse_file(ModuleGraph::File& file, ast::BuiltinScope& builtin) {
+    file.module.reset();
+    file.imports.clear();
+    file.validated_at = 0;
+
+    auto lexer        = lex::LazyLexer::using_source(file.source, file.path);
+    auto parse_result = parse::parse_module(lexer, builtin);
+    FORWARD_ERROR(parse_result);
+    file.module = std::move(parse_result).value();
+
+    file.imports.reserve(file.module->imports().size());
+    for (const auto& import : file.module->imports()) {
+        file.imports.push_back(ModuleGraph::resolve_path(file.path, import.path));
+    }
+    return {};
+}
+
+/**
+ * Read the file, and return whether it has to be parsed again, because its contents have changed
+ * since it was last parsed.
+ */
+util::Result<bool> read_file(ModuleGraph::File& file, const FileReader& reader) {
+    auto read_result = reader(file.path);
+    FORWARD_ERROR(read_result);
+    auto source = std::move(read_result).value();
+
+    const auto hash =
+        crypto::sha256::hash(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+    if (file.module != nullptr && hash == file.hash) {
+        return false;
+    }
+
+    // The module refers to the old source, so it must be dropped before the source is replaced.
+    file.module.reset();
+    file.source = std::move(source);
+    file.hash   = hash;
+    return true;
+}
+
+}  // namespace
+
+ModuleGraph::ModuleGraph(FileReader read_file) : _read_file(std::move(read_file)) {}
+
+absl::Nullable<const ModuleGraph::File*> ModuleGraph::find(const std::string_view path) const {
+    if (const auto it = _files.find(path); it != _files.end()) {
+        return it->second.get();
+    }
+    return nullptr;
+}
+
+util::Result<void> ModuleGraph::load(const std::string_view root_path, Options& options,
+                                     absl::Nullable<llvm::ThreadPool*> thread_pool) {
+    _order.clear();
+
+    // Discover all of the reachable files, one level of imports at a time, reading and parsing
+    // each level in parallel.
+    std::vector<absl::Nonnull<File*>>               reachable;
+    absl::flat_hash_map<std::string, lex::Location> imported_from;
+    absl::flat_hash_set<std::string>                seen;
+    std::vector<std::string>                        level = {resolve_path("", root_path)};
+    seen.insert(level.front());
+
+    while (!level.empty()) {
+        std::vector<absl::Nonnull<File*>> files;
+        files.reserve(level.size());
+        for (auto& path : level) {
+            auto& file = _files[path];
+            if (file == nullptr) {
+                file       = std::make_unique<File>();
+                file->path = path;
+            }
+            files.push_back(file.get());
+        }
+
+        std::vector<util::Result<void>> results(files.size());
+        for_each_parallel(thread_pool, files.size(), [&](size_t i) {
+            results[i] = [&]() -> util::Result<void> {
+                auto read_result = read_file(*files[i], _read_file);
+                FORWARD_ERROR(read_result);
+                if (!*read_result) {
+                    return {};
+                }
+                return parse_file(*files[i], _builtin);
+            }();
+        });
+
+        // Report the first error in the order the files were imported, regardless of which thread
+        // finished first.
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (!results[i].has_value()) {
+                if (const auto it = imported_from.find(files[i]->path);
+                    it != imported_from.end()) {
+                    return ERR_PTR(err::SyntaxError, it->second,
+                                   absl::StrCat("failed to import \"", files[i]->path,
+                                                "\": ", results[i].error()->message()));
+                }
+                return tl::unexpected(std::move(results[i]).error());
+            }
+        }
+
+        std::vector<std::string> next_level;
+        for (auto* file : files) {
+            reachable.push_back(file);
+
+            const auto& imports = file->module->imports();
+            for (size_t i = 0; i < imports.size(); ++i) {
+                if (seen.insert(file->imports[i]).second) {
+                    imported_from.emplace(file->imports[i], imports[i].path_location);
+                    next_level.push_back(file->imports[i]);
+                }
+            }
+        }
+        level = std::move(next_level);
+    }
+
+    // Order the files so that every file comes after the files it imports.
+    {
+        enum class Mark { None, Visiting, Done };
+        absl::flat_hash_map<const File*, Mark> marks;
+
+        std::function<util::Result<void>(File&)> visit = [&](File& file) -> util::Result<void> {
+            marks[&file] = Mark::Visiting;
+
+            const auto& imports = file.module->imports();
+            for (size_t i = 0; i < imports.size(); ++i) {
+                auto& dependency = *_files.find(file.imports[i])->second;
+                switch (marks[&dependency]) {
+                    case Mark::None: {
+                        auto result = visit(dependency);
+                        FORWARD_ERROR(result);
+                        break;
+                    }
+                    case Mark::Visiting:
+                        return ERR_PTR(err::SyntaxError, imports[i].path_location,
+                                       absl::StrCat("import cycle: \"", dependency.path,
+                                                    "\" (directly or indirectly) imports \"",
+                                                    file.path, "\""));
+                    case Mark::Done:
+                        break;
+                }
+            }
+
+            marks[&file] = Mark::Done;
+            _order.push_back(&file);
+            return {};
+        };
+
+        auto result = visit(*reachable.front());
+        if (!result.has_value()) {
+            _order.clear();
+            return tl::unexpected(std::move(result).error());
+        }
+    }
+
+    // A file must be validated again if it has not been validated since it was last parsed, or if
+    // any of the files it imports has been (or is about to be) validated again since it was; the
+    // old module refers to types and functions in the old modules it imported.
+    absl::flat_hash_set<const File*> stale;
+    for (auto* file : _order) {
+        bool is_stale = file->validated_at == 0;
+        for (const auto& import_path : file->imports) {
+            const auto& dependency = *_files.find(import_path)->second;
+            is_stale               = is_stale || stale.contains(&dependency) ||
+                       dependency.validated_at > file->validated_at;
+        }
+        if (is_stale) {
+            stale.insert(file);
+        }
+    }
+
+    // Modules cannot be validated twice, so any stale module that was validated before has to be
+    // parsed again first.
+    {
+        std::vector<absl::Nonnull<File*>> reparse;
+        for (auto* file : _order) {
+            if (stale.contains(file) && file->validated_at != 0) {
+                reparse.push_back(file);
+            }
+        }
+
+        std::vector<util::Result<void>> results(reparse.size());
+        for_each_parallel(thread_pool, reparse.size(),
+                          [&](size_t i) { results[i] = parse_file(*reparse[i], _builtin); });
+        for (auto& result : results) {
+            FORWARD_ERROR(result);
+        }
+    }
+
+    // Group the stale files by their depth in the graph (how long the longest chain of imports
+    // below them is), so that every file is validated after the files it imports, and the files
+    // within a group (which cannot import each other) are validated in parallel.
+    std::vector<std::vector<absl::Nonnull<File*>>> depths;
+    {
+        absl::flat_hash_map<const File*, size_t> depth_of;
+        for (auto* file : _order) {
+            size_t depth = 0;
+            for (const auto& import_path : file->imports) {
+                depth = std::max(depth, depth_of[_files.find(import_path)->second.get()] + 1);
+            }
+            depth_of[file] = depth;
+
+            if (stale.contains(file)) {
+                if (depths.size() <= depth) {
+                    depths.resize(depth + 1);
+                }
+                depths[depth].push_back(file);
+            }
+        }
+    }
+
+    for (const auto& files : depths) {
+        std::vector<util::Result<void>> results(files.size());
+        for_each_parallel(thread_pool, files.size(), [&](size_t i) {
+            auto* file = files[i];
+            results[i] = [&]() -> util::Result<void> {
+                const auto& imports = file->module->imports();
+                for (size_t j = 0; j < imports.size(); ++j) {
+                    const auto& dependency = *_files.find(file->imports[j])->second;
+                    for (const auto& name : imports[j].names) {
+                        auto result = file->module->scope().import_name(
+                            dependency.module->scope(), name.name, name.location);
+                        FORWARD_ERROR(result);
+                    }
+                }
+
+                return file->module->validate(options);
+            }();
+        });
+
+        // The files are numbered in dependency order, the same as if they were validated one at a
+        // time, and the first error is reported in that order too.
+        util::Result<void> first_error;
+        for (size_t i = 0; i < files.size(); ++i) {
+            if (results[i].has_value()) {
+                files[i]->validated_at = ++_validation_count;
+                continue;
+            }
+
+            // A partially validated module cannot be used again; the file will be parsed again on
+            // the next load.
+            files[i]->module.reset();
+            files[i]->validated_at = 0;
+            if (first_error.has_value()) {
+                first_error = std::move(results[i]);
+            }
+        }
+        FORWARD_ERROR(first_error);
+    }
+
+    return {};
+}
+
+util::Result<void> ModuleGraph::compile(Options& options, code::Module& code_module) {
+    if (_order.empty()) {
+        return ERR_PTR(err::SimpleError, "no files have been loaded");
+    }
+
+    std::vector<absl::Nonnull<ast::Module*>> modules;
+    modules.reserve(_order.size());
+    for (auto* file : _order) {
+        if (file->module == nullptr || file->validated_at == 0) {
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("file \"", file->path, "\" has not been validated"));
+        }
+        modules.push_back(file->module.get());
+    }
+
+    code::Context ctx(code_module, options);
+    code::compile_modules(ctx, modules);
+    return ctx.take_error();
+}
+
+util::Result<code::Module> ModuleGraph::compile(Options& options) {
+    code::Module code_module(options);
+    auto         result = compile(options, code_module);
+    FORWARD_ERROR(result);
+
+    return code_module;
+}
+
+void ModuleGraph::clear() {
+    _order.clear();
+    _files.clear();
+}
+
+std::string ModuleGraph::resolve_path(const std::string_view from_path,
+                                      const std::string_view import_path) {
+    std::vector<std::string_view> parts;
+    const auto                    append = [&parts](const std::string_view path) {
+        for (const std::string_view part : absl::StrSplit(path, '/')) {
+            if (part.empty() || part == ".") {
+                continue;
+            }
+            if (part == ".." && !parts.empty() && parts.back() != "..") {
+                parts.pop_back();
+                continue;
+            }
+            parts.push_back(part);
+        }
+    };
+
+    bool absolute = import_path.starts_with('/');
+    if (!absolute) {
+        // Start from the directory containing the importing file.
+        absolute = from_path.starts_with('/');
+        if (const auto slash = from_path.rfind('/'); slash != std::string_view::npos) {
+            append(from_path.substr(0, slash));
+        }
+    }
+    append(import_path);
+
+    std::string path = absl::StrCat(absolute ? "/" : "", absl::StrJoin(parts, "/"));
+    if (!path.ends_with(".rain")) {
+        path += ".rain";
+    }
+    return path;
+}
+
+}  // namespace rain
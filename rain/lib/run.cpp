@@ -0,0 +1,200 @@
+#include "rain/run.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "wabt/binary-reader.h"
+#include "wabt/error-formatter.h"
+#include "wabt/feature.h"
+#include "wabt/interp/binary-reader-interp.h"
+#include "wabt/interp/interp.h"
+#include "wabt/stream.h"
+
+namespace rain {
+
+using namespace lang;
+
+namespace {
+
+/** Counts the lines written to it; the interpreter traces each instruction on its own line. */
+class LineCountingStream : public wabt::Stream {
+    uint64_t _lines = 0;
+
+  public:
+    LineCountingStream()           = default;
+    ~LineCountingStream() override = default;
+
+    [[nodiscard]] constexpr uint64_t lines() const noexcept { return _lines; }
+
+  protected:
+    wabt::Result WriteDataImpl(size_t /*offset*/, const void* data, size_t size) override {
+        const auto* chars = static_cast<const char*>(data);
+        _lines += std::count(chars, chars + size, '\n');
+        return wabt::Result::Ok;
+    }
+    wabt::Result MoveDataImpl(size_t /*dst_offset*/, size_t /*src_offset*/,
+                              size_t /*size*/) override {
+        return wabt::Result::Ok;
+    }
+    wabt::Result TruncateImpl(size_t /*size*/) override { return wabt::Result::Ok; }
+};
+
+util::Result<wabt::interp::Value> to_interp_value(const WasmValue& value, const wabt::Type type) {
+    switch (type) {
+        case wabt::Type::I32:
+            if (std::holds_alternative<int32_t>(value)) {
+                return wabt::interp::Value::Make(static_cast<wabt::s32>(std::get<int32_t>(value)));
+            }
+            break;
+        case wabt::Type::I64:
+            if (std::holds_alternative<int64_t>(value)) {
+                return wabt::interp::Value::Make(static_cast<wabt::s64>(std::get<int64_t>(value)));
+            }
+            break;
+        case wabt::Type::F32:
+            if (std::holds_alternative<float>(value)) {
+                return wabt::interp::Value::Make(std::get<float>(value));
+            }
+            break;
+        case wabt::Type::F64:
+            if (std::holds_alternative<double>(value)) {
+                return wabt::interp::Value::Make(std::get<double>(value));
+            }
+            break;
+        default:
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("unsupported parameter type ", type.GetName()));
+    }
+    return ERR_PTR(err::SimpleError,
+                   absl::StrCat("argument does not match parameter type ", type.GetName()));
+}
+
+util::Result<WasmValue> from_interp_value(const wabt::interp::Value& value,
+                                          const wabt::Type           type) {
+    switch (type) {
+        case wabt::Type::I32:
+            return static_cast<int32_t>(value.Get<wabt::s32>());
+        case wabt::Type::I64:
+            return static_cast<int64_t>(value.Get<wabt::s64>());
+        case wabt::Type::F32:
+            return value.Get<wabt::f32>();
+        case wabt::Type::F64:
+            return value.Get<wabt::f64>();
+        default:
+            return ERR_PTR(err::SimpleError,
+                           absl::StrCat("unsupported result type ", type.GetName()));
+    }
+}
+
+}  // namespace
+
+struct WasmInstance::State {
+    wabt::interp::Store         store;
+    wabt::interp::Module::Ptr   module;
+    wabt::interp::Instance::Ptr instance;
+
+    explicit State(const wabt::Features& features) : store(features) {}
+};
+
+WasmInstance::WasmInstance(std::unique_ptr<State> state) : _state(std::move(state)) {}
+
+WasmInstance::WasmInstance(WasmInstance&&) noexcept            = default;
+WasmInstance& WasmInstance::operator=(WasmInstance&&) noexcept = default;
+WasmInstance::~WasmInstance()                                  = default;
+
+util::Result<WasmInstance> WasmInstance::instantiate(const std::span<const uint8_t> wasm) {
+    // The interpreter should run anything the compiler may have been asked to produce.
+    wabt::Features features;
+    features.EnableAll();
+
+    constexpr bool          read_debug_names             = true;
+    constexpr bool          stop_on_first_error          = true;
+    constexpr bool          fail_on_custom_section_error = true;
+    wabt::ReadBinaryOptions options(features, nullptr, read_debug_names, stop_on_first_error,
+                                    fail_on_custom_section_error);
+
+    wabt::Errors             errors;
+    wabt::interp::ModuleDesc module_desc;
+    if (const auto result = wabt::interp::ReadBinaryInterp("<wasm>", wasm.data(), wasm.size(),
+                                                           options, &errors, &module_desc);
+        !wabt::Succeeded(result)) {
+        wabt::Color color(nullptr);
+        return ERR_PTR(err::SimpleError,
+                       FormatErrorsToString(errors, wabt::Location::Type::Binary, nullptr, color));
+    }
+
+    if (!module_desc.imports.empty()) {
+        const auto& import = module_desc.imports.front().type;
+        return ERR_PTR(err::SimpleError, absl::StrCat("cannot instantiate a module with imports (",
+                                                      import.module, ".", import.name, ")"));
+    }
+
+    auto state    = std::make_unique<State>(features);
+    state->module = wabt::interp::Module::New(state->store, std::move(module_desc));
+
+    wabt::interp::Trap::Ptr trap;
+    state->instance =
+        wabt::interp::Instance::Instantiate(state->store, state->module.ref(), {}, &trap);
+    if (!state->instance) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("failed to instantiate module: ",
+                                    trap ? trap->message() : std::string("unknown error")));
+    }
+
+    return WasmInstance(std::move(state));
+}
+
+util::Result<std::vector<WasmValue>> WasmInstance::call(const std::string_view     name,
+                                                        std::span<const WasmValue> args) {
+    const wabt::interp::ExportDesc* export_desc = nullptr;
+    for (const auto& desc : _state->module->desc().exports) {
+        if (desc.type.type->kind == wabt::ExternalKind::Func && desc.type.name == name) {
+            export_desc = &desc;
+            break;
+        }
+    }
+    if (export_desc == nullptr) {
+        return ERR_PTR(err::SimpleError, absl::StrCat("no exported function named \"", name, "\""));
+    }
+
+    const auto& func_type = *wabt::cast<wabt::interp::FuncType>(export_desc->type.type.get());
+    if (args.size() != func_type.params.size()) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("function \"", name, "\" takes ", func_type.params.size(),
+                                    " arguments, but was given ", args.size()));
+    }
+
+    wabt::interp::Values params;
+    params.reserve(args.size());
+    for (size_t i = 0; i < args.size(); ++i) {
+        auto param_result = to_interp_value(args[i], func_type.params[i]);
+        FORWARD_ERROR(param_result);
+        params.push_back(std::move(param_result).value());
+    }
+
+    auto func = _state->store.UnsafeGet<wabt::interp::Func>(
+        _state->instance->funcs()[export_desc->index]);
+
+    LineCountingStream      trace_stream;
+    wabt::interp::Values    results;
+    wabt::interp::Trap::Ptr trap;
+    const auto              call_result = func->Call(_state->store, params, results, &trap,
+                                                     _count_instructions ? &trace_stream : nullptr);
+    _instructions_executed += trace_stream.lines();
+    if (!wabt::Succeeded(call_result)) {
+        return ERR_PTR(err::SimpleError,
+                       absl::StrCat("function \"", name, "\" trapped: ",
+                                    trap ? trap->message() : std::string("unknown error")));
+    }
+
+    std::vector<WasmValue> values;
+    values.reserve(results.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        auto value_result = from_interp_value(results[i], func_type.results[i]);
+        FORWARD_ERROR(value_result);
+        values.push_back(std::move(value_result).value());
+    }
+    return values;
+}
+
+}  // namespace rain
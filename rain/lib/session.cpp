@@ -0,0 +1,34 @@
+#include "rain/session.hpp"
+
+#include "rain/compile.hpp"
+
+namespace rain {
+
+Session::Session(lang::Options& options) : _options(options) { reset(); }
+
+lang::code::Module Session::create_module() {
+    if (_modules_in_context >= _max_modules_per_context) {
+        _llvm_ctx           = std::make_shared<llvm::LLVMContext>();
+        _modules_in_context = 0;
+    }
+
+    ++_modules_in_context;
+    return lang::code::Module(_options, _llvm_ctx, _llvm_target_machine);
+}
+
+util::Result<lang::code::Module> Session::compile(
+    const std::string_view source, absl::Nullable<lang::code::FunctionCache*> function_cache) {
+    auto code_module = create_module();
+    auto result      = rain::compile(source, _options, code_module, function_cache);
+    FORWARD_ERROR(result);
+
+    return code_module;
+}
+
+void Session::reset() {
+    _llvm_ctx            = std::make_shared<llvm::LLVMContext>();
+    _llvm_target_machine = _options.create_target_machine();
+    _modules_in_context  = 0;
+}
+
+}  // namespace rain
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string_view>
 
+#include "absl/base/nullability.h"
+#include "llvm/ADT/STLFunctionalExtras.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetMachine.h"
 #include "rain/buffer.hpp"
 #include "rain/lang/code/module.hpp"
@@ -14,6 +19,24 @@
 namespace rain {
 
 util::Result<std::unique_ptr<Buffer>> link(lang::code::Module& module, lang::Options& options);
+/**
+ * Link a module given as either textual LLVM IR, LLVM bitcode, or compressed bitcode (see
+ * `code::Module::emit_bitcode`), detected from its contents.
+ *
+ * Textual IR has to be parsed and compiled to an object file first, while bitcode is passed to the
+ * linker as is, which makes bitcode the much cheaper format to keep between compile stages.
+ */
 util::Result<std::unique_ptr<Buffer>> link(const std::string_view llvm_ir, lang::Options& options);
 
+/**
+ * Link the module, writing the wasm binary directly into the memory returned by `allocate`, which
+ * is called once with the exact size of the output.
+ */
+util::Result<void> link(lang::code::Module& module, lang::Options& options,
+                        llvm::function_ref<absl::Nullable<uint8_t*>(size_t size)> allocate);
+
+/** Link the module, writing the wasm binary to `ostream`. */
+util::Result<void> link(lang::code::Module& module, lang::Options& options,
+                        llvm::raw_pwrite_stream& ostream);
+
 }  // namespace rain
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "absl/base/nullability.h"
+#include "absl/container/flat_hash_map.h"
+#include "llvm/Support/ThreadPool.h"
+#include "rain/crypto/sha256.hpp"
+#include "rain/lang/ast/module.hpp"
+#include "rain/lang/ast/scope/builtin.hpp"
+#include "rain/lang/code/module.hpp"
+#include "rain/lang/options.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain {
+
+/**
+ * Reads the contents of the file at the given (already resolved) path.
+ *
+ * When loading with a thread pool, the reader is called from multiple threads at once.
+ */
+using FileReader = std::function<util::Result<std::string>(std::string_view path)>;
+
+/**
+ * The set of source files reachable through `import` statements from a root file.
+ *
+ * Each file is parsed into its own `ast::Module`, and the names it imports are resolved directly
+ * against the (validated) scopes of the modules they come from. Files are read and parsed in
+ * parallel, and validated in parallel once all of the files they import have been; the function
+ * types and methods of derived types that they add to the shared builtin scope (and to the scopes
+ * of the modules they import) are guarded by `BuiltinScope::lock_shared_state()`.
+ *
+ * The graph is meant to be kept around between loads: a file whose contents have not changed, and
+ * that does not depend on any file that has, keeps its validated module instead of being parsed
+ * and validated again.
+ */
+class ModuleGraph {
+  public:
+    struct File {
+        std::string            path;
+        std::string            source;
+        crypto::sha256::Digest hash = {};
+
+        /** The resolved paths of the imported files, in the same order as `module->imports()`. */
+        std::vector<std::string> imports;
+
+        std::unique_ptr<lang::ast::Module> module;
+
+        /**
+         * When the module was last validated, relative to the other files in the graph; or 0 if it
+         * has not been validated since it was last parsed.
+         */
+        uint64_t validated_at = 0;
+    };
+
+  private:
+    lang::ast::BuiltinScope _builtin;
+    FileReader              _read_file;
+
+    absl::flat_hash_map<std::string, std::unique_ptr<File>> _files;
+
+    /** The files reachable from the last loaded root, ordered so that dependencies come first. */
+    std::vector<absl::Nonnull<File*>> _order;
+
+    uint64_t _validation_count = 0;
+
+  public:
+    explicit ModuleGraph(FileReader read_file);
+    ~ModuleGraph() = default;
+
+    ModuleGraph(const ModuleGraph&)            = delete;
+    ModuleGraph& operator=(const ModuleGraph&) = delete;
+
+    [[nodiscard]] constexpr const auto& order() const noexcept { return _order; }
+    [[nodiscard]] /*constexpr*/ size_t  size() const noexcept { return _files.size(); }
+
+    [[nodiscard]] absl::Nullable<const File*> find(std::string_view path) const;
+
+    /**
+     * Load the file at `root_path` and everything it (transitively) imports, reading, parsing, and
+     * validating the files on the thread pool if one is given.
+     */
+    util::Result<void> load(std::string_view root_path, lang::Options& options,
+                            absl::Nullable<llvm::ThreadPool*> thread_pool = nullptr);
+
+    /** Compile all of the loaded files into `module`, which must not have been compiled into. */
+    util::Result<void>               compile(lang::Options& options, lang::code::Module& module);
+    util::Result<lang::code::Module> compile(lang::Options& options);
+
+    /** Drop every cached file. */
+    void clear();
+
+    /**
+     * Return the path of the file imported as `import_path` from the file at `from_path`.
+     *
+     * Import paths are relative to the directory of the importing file, and the ".rain" extension
+     * may be left off.
+     */
+    static std::string resolve_path(std::string_view from_path, std::string_view import_path);
+};
+
+}  // namespace rain
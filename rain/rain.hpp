@@ -3,3 +3,5 @@
 #include "rain/compile.hpp"
 #include "rain/decompile.hpp"
 #include "rain/link.hpp"
+#include "rain/load.hpp"
+#include "rain/session.hpp"
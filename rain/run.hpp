@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "rain/lang/err/simple.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain {
+
+/** A value passed to, or returned from, a wasm function. */
+using WasmValue = std::variant<int32_t, int64_t, float, double>;
+
+/**
+ * An instance of a linked wasm module, running on wabt's interpreter.
+ *
+ * This is meant for checking (and measuring) what the compiler produces, not for running code
+ * quickly. The module must not import anything.
+ */
+class WasmInstance {
+    struct State;
+
+    std::unique_ptr<State> _state;
+
+    bool     _count_instructions    = false;
+    uint64_t _instructions_executed = 0;
+
+    explicit WasmInstance(std::unique_ptr<State> state);
+
+  public:
+    static util::Result<WasmInstance> instantiate(std::span<const uint8_t> wasm);
+
+    WasmInstance(const WasmInstance&)            = delete;
+    WasmInstance& operator=(const WasmInstance&) = delete;
+
+    WasmInstance(WasmInstance&&) noexcept;
+    WasmInstance& operator=(WasmInstance&&) noexcept;
+
+    ~WasmInstance();
+
+    /**
+     * Count the instructions executed by the calls that follow. Counting makes calls several times
+     * slower, as the interpreter has to trace every instruction.
+     */
+    void set_count_instructions(const bool count_instructions) noexcept {
+        _count_instructions = count_instructions;
+    }
+
+    [[nodiscard]] constexpr uint64_t instructions_executed() const noexcept {
+        return _instructions_executed;
+    }
+    constexpr void reset_instructions_executed() noexcept { _instructions_executed = 0; }
+
+    /** Call the exported function with the given name. */
+    util::Result<std::vector<WasmValue>> call(std::string_view           name,
+                                              std::span<const WasmValue> args);
+
+    /**
+     * Call the exported function with the given name, which must return a single value of type
+     * `R` (or nothing, if `R` is void). A bool is passed and returned as an i32.
+     */
+    template <typename R, typename... Args>
+    util::Result<R> invoke(const std::string_view name, Args... args) {
+        const std::array<WasmValue, sizeof...(Args)> values = {to_wasm_value(args)...};
+
+        auto results_result = call(name, values);
+        FORWARD_ERROR(results_result);
+        const auto results = std::move(results_result).value();
+
+        if constexpr (std::is_void_v<R>) {
+            if (!results.empty()) {
+                return ERR_PTR(lang::err::SimpleError,
+                               absl::StrCat("function \"", name, "\" returns a value"));
+            }
+            return {};
+        } else {
+            using WasmR = decltype(to_wasm_value(R{}));
+            if (results.size() != 1 || !std::holds_alternative<WasmR>(results.front())) {
+                return ERR_PTR(lang::err::SimpleError,
+                               absl::StrCat("function \"", name,
+                                            "\" does not return the requested type"));
+            }
+            return static_cast<R>(std::get<WasmR>(results.front()));
+        }
+    }
+
+  private:
+    template <typename T>
+    static constexpr auto to_wasm_value(const T value) noexcept {
+        if constexpr (std::is_same_v<T, bool>) {
+            return static_cast<int32_t>(value);
+        } else {
+            static_assert(std::is_same_v<T, int32_t> || std::is_same_v<T, int64_t> ||
+                              std::is_same_v<T, float> || std::is_same_v<T, double>,
+                          "unsupported wasm value type");
+            return value;
+        }
+    }
+};
+
+}  // namespace rain
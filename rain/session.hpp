@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include "absl/base/nullability.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Target/TargetMachine.h"
+#include "rain/lang/code/incremental.hpp"
+#include "rain/lang/code/module.hpp"
+#include "rain/lang/options.hpp"
+#include "rain/util/result.hpp"
+
+namespace rain {
+
+/**
+ * Keeps the LLVM state that does not depend on the source being compiled (the LLVM context and
+ * the target machine) alive between compiles, so that each compile only pays for creating a new
+ * module.
+ *
+ * Every module compiled by the session shares the same LLVM context. Types and constants created
+ * in a context are never freed while it is alive, so the session periodically starts over with a
+ * new context; modules that were handed out before keep their context alive for as long as they
+ * need it.
+ */
+class Session {
+  public:
+    static constexpr uint32_t DEFAULT_MAX_MODULES_PER_CONTEXT = 64;
+
+  private:
+    lang::Options& _options;
+
+    std::shared_ptr<llvm::LLVMContext>   _llvm_ctx;
+    std::shared_ptr<llvm::TargetMachine> _llvm_target_machine;
+
+    uint32_t _modules_in_context      = 0;
+    uint32_t _max_modules_per_context = DEFAULT_MAX_MODULES_PER_CONTEXT;
+
+  public:
+    explicit Session(lang::Options& options);
+    ~Session() = default;
+
+    Session(const Session&)            = delete;
+    Session& operator=(const Session&) = delete;
+
+    [[nodiscard]] constexpr lang::Options& options() const noexcept { return _options; }
+    [[nodiscard]] constexpr uint32_t       modules_in_context() const noexcept {
+        return _modules_in_context;
+    }
+
+    /** Set how many modules may be created in a context before it is replaced by a new one. */
+    constexpr void set_max_modules_per_context(uint32_t max_modules_per_context) noexcept {
+        _max_modules_per_context = max_modules_per_context;
+    }
+
+    /** Create a new, empty module using the session's LLVM state. */
+    [[nodiscard]] lang::code::Module create_module();
+
+    util::Result<lang::code::Module> compile(
+        const std::string_view                     source,
+        absl::Nullable<lang::code::FunctionCache*> function_cache = nullptr);
+
+    /**
+     * Drop the session's LLVM context, and recreate the target machine (in case the options
+     * changed).
+     */
+    void reset();
+};
+
+}  // namespace rain
@@ -0,0 +1,102 @@
+#include "absl/strings/str_cat.h"
+#include "rain/spec/util.hpp"
+
+namespace {
+
+// 32 bytes, so it is passed by pointer between rain functions.
+constexpr std::string_view BIG_STRUCT = R"(
+struct Big {
+    a: i32,
+    b: i32,
+    c: i32,
+    d: i32,
+    e: i32,
+    f: i32,
+    g: i32,
+    h: i32,
+}
+
+fn Big.splat(v: i32) -> Big {
+    Big{ a: v, b: v + 1, c: v + 2, d: v + 3, e: v + 4, f: v + 5, g: v + 6, h: v + 7 }
+}
+
+fn Big.sum(self) -> i32 {
+    self.a + self.b + self.c + self.d + self.e + self.f + self.g + self.h
+}
+
+fn first_and_last(big: Big) -> i32 {
+    big.a * big.h
+}
+)";
+
+}  // namespace
+
+TEST(Abi, large_struct_return_and_arguments) {
+    const std::string code = absl::StrCat(BIG_STRUCT, R"(
+export fn sum_of_splat(v: i32) -> i32 {
+    Big.splat(v).sum()
+}
+
+export fn first_times_last(v: i32) -> i32 {
+    first_and_last(Big.splat(v))
+}
+)");
+
+    EXPECT_RUN_RESULT(int32_t{8 * 10 + 28}, code, "sum_of_splat", int32_t{10});
+    EXPECT_RUN_RESULT(int32_t{2 * 9}, code, "first_times_last", int32_t{2});
+
+    // The large struct is returned through a pointer to memory owned by the caller, and passed as
+    // a pointer to a copy instead of being split up into its fields.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("define internal void @Big.splat(ptr noalias sret(%Big"), std::string::npos)
+        << ir;
+    EXPECT_NE(ir.find("define internal i32 @first_and_last(ptr noalias nocapture readonly"),
+              std::string::npos)
+        << ir;
+}
+
+TEST(Abi, small_struct_is_passed_directly) {
+    const std::string_view code = R"(
+struct Pair {
+    x: i32,
+    y: i32,
+}
+
+fn Pair.swap(self) -> Pair {
+    Pair{ x: self.y, y: self.x }
+}
+
+export fn swapped_difference(x: i32, y: i32) -> i32 {
+    let pair = Pair{ x: x, y: y }.swap()
+    pair.x - pair.y
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{3}, code, "swapped_difference", int32_t{1}, int32_t{4});
+
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("define internal %Pair @Pair.swap(%Pair"), std::string::npos) << ir;
+}
+
+TEST(Abi, export_keeps_direct_signature) {
+    const std::string code = absl::StrCat(BIG_STRUCT, R"(
+export fn make_big(v: i32) -> Big {
+    Big.splat(v)
+}
+
+export fn sum_of_made(v: i32) -> i32 {
+    make_big(v).sum()
+}
+)");
+
+    EXPECT_RUN_RESULT(int32_t{8 * 3 + 28}, code, "sum_of_made", int32_t{3});
+
+    // The host sees the struct returned by value, while rain code calls the function through its
+    // indirect signature.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("define %Big @make_big(i32"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("define internal void @make_big.impl(ptr noalias sret(%Big"),
+              std::string::npos)
+        << ir;
+    EXPECT_NE(ir.find("call void @make_big.impl("), std::string::npos) << ir;
+}
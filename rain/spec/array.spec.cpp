@@ -60,3 +60,27 @@ export fn array_assignment() -> i32 {
 
     EXPECT_COMPILE_SUCCESS(code);
 }
+
+TEST(Array, identical_constant_literals_share_a_global) {
+    const std::string_view code = R"(
+fn third() -> i32 {
+    let array = [4]i32{ 1, 2, 3, 4 }
+    array[2]
+}
+
+export fn sum_of_thirds() -> i32 {
+    let array = [4]i32{ 1, 2, 3, 4 }
+    array[2] = 42
+    third() + array[2]
+}
+)";
+
+    // Each variable is a copy, so assigning to one does not change the shared constant.
+    EXPECT_RUN_RESULT(int32_t{3 + 42}, code, "sum_of_thirds");
+
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("@\"const.[4]i32\" = internal unnamed_addr constant [4 x i32]"),
+              std::string::npos)
+        << ir;
+    EXPECT_EQ(ir.find("@\"const.[4]i32.1\""), std::string::npos) << ir;
+}
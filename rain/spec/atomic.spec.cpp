@@ -0,0 +1,77 @@
+#include "rain/spec/util.hpp"
+
+TEST(Atomic, global_counter) {
+    const std::string_view code = R"(
+let counter = 0
+
+export fn count(n: i32) -> i32 {
+    let i = 0
+    while i < n {
+        counter.atomic_add(1)
+        i = i + 1
+    }
+    counter.atomic_sub(2)
+    counter.atomic_load()
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{8}, code, "count", int32_t{10});
+}
+
+TEST(Atomic, read_modify_write_returns_previous_value) {
+    const std::string_view code = R"(
+export fn rmw(value: i32) -> i32 {
+    let x = value
+    let a = x.atomic_or(16)
+    let b = x.atomic_and(24)
+    let c = x.atomic_xor(1)
+    let d = x.atomic_exchange(100)
+    a + b + c + d + x.atomic_load()
+}
+)";
+
+    // 3 -> 19 -> 16 -> 17 -> 100
+    EXPECT_RUN_RESULT(int32_t{3 + 19 + 16 + 17 + 100}, code, "rmw", int32_t{3});
+}
+
+TEST(Atomic, compare_exchange) {
+    const std::string_view code = R"(
+export fn compare_exchange(expected: i32) -> i32 {
+    let value = 5
+    let previous = value.atomic_compare_exchange(expected, 9)
+    previous * 100 + value.atomic_load()
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{509}, code, "compare_exchange", int32_t{5});
+    EXPECT_RUN_RESULT(int32_t{505}, code, "compare_exchange", int32_t{4});
+}
+
+TEST(Atomic, i64) {
+    const std::string_view code = R"(
+export fn store_and_add(value: i64, delta: i64) -> i64 {
+    let x = value
+    x.atomic_store(value + value)
+    x.atomic_add(delta)
+    x.atomic_load()
+}
+)";
+
+    EXPECT_RUN_RESULT(int64_t{1} << 40 | 7, code, "store_and_add", int64_t{1} << 39,
+                      int64_t{7});
+}
+
+TEST(Atomic, wait_and_notify_without_shared_memory) {
+    const std::string_view code = R"(
+export fn wait(expected: i32) -> i32 {
+    let value = 5
+    value.atomic_wait(expected, value as i64) * 10 + value.atomic_notify(1)
+}
+)";
+
+    // Nothing can be waiting without shared memory: a different value returns "not equal" (1),
+    // and the same value "timed out" (2), right away.
+    EXPECT_RUN_RESULT(int32_t{10}, code, "wait", int32_t{4});
+    EXPECT_RUN_RESULT(int32_t{20}, code, "wait", int32_t{5});
+}
@@ -0,0 +1,42 @@
+#include "llvm/Support/ThreadPool.h"
+#include "rain/batch.hpp"
+#include "rain/spec/util.hpp"
+
+TEST(Batch, results_in_source_order) {
+    const std::array<rain::Source, 3> sources{
+        rain::Source{.file_name = "four.rain", .code = R"(
+export fn four() -> i32 {
+    4
+}
+)"},
+        rain::Source{.file_name = "broken.rain", .code = R"(
+export fn broken() -> i32 {
+    missing()
+}
+)"},
+        rain::Source{.file_name = "five.rain", .code = R"(
+export fn five() -> i32 {
+    5
+}
+)"},
+    };
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    llvm::ThreadPool          thread_pool(llvm::hardware_concurrency(2));
+
+    auto results = rain::compile_batch(sources, options, thread_pool);
+    ASSERT_EQ(results.size(), sources.size());
+
+    ASSERT_TRUE(check_success(results[0]));
+    EXPECT_NE(results[0].value().llvm_module().getFunction("four"), nullptr);
+
+    EXPECT_FALSE(results[1].has_value());
+
+    ASSERT_TRUE(check_success(results[2]));
+    EXPECT_NE(results[2].value().llvm_module().getFunction("five"), nullptr);
+
+    // Each module has its own LLVM context, so they can be processed in parallel afterwards.
+    EXPECT_NE(&results[0].value().llvm_context(), &results[2].value().llvm_context());
+}
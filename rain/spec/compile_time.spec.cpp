@@ -0,0 +1,61 @@
+#include "rain/spec/util.hpp"
+
+TEST(CompileTime, no_engine_without_compile_time_expressions) {
+    const std::string_view code = R"(
+export fn four() -> i32 {
+    4
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    auto                      module_result = rain::compile(code, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    EXPECT_FALSE(mod.has_llvm_engine());
+}
+
+TEST(CompileTime, engine_created_on_demand) {
+    const std::string_view code = R"(
+fn four() -> i32 {
+    4
+}
+
+export fn sixteen() -> i32 {
+    #(four() * four())
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    auto                      module_result = rain::compile(code, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    EXPECT_TRUE(mod.has_llvm_engine());
+
+    mod.optimize();
+    ASSERT_TRUE(check_success(mod.emit_ir()));
+}
+
+TEST(CompileTime, engine_created_with_default_options) {
+    const std::string_view code = R"(
+export fn four() -> i32 {
+    4
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    // The options are created (and owned) by the module, and outlive the compile.
+    auto module_result = rain::compile(code);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    EXPECT_FALSE(mod.has_llvm_engine());
+    [[maybe_unused]] auto& engine = mod.llvm_engine();
+    EXPECT_TRUE(mod.has_llvm_engine());
+}
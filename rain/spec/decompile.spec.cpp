@@ -0,0 +1,83 @@
+#include <string>
+#include <vector>
+
+#include "rain/spec/util.hpp"
+
+namespace {
+
+constexpr std::string_view ARITHMETIC = R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+
+export fn mul(a: i32, b: i32) -> i32 {
+    a * b
+}
+)";
+
+/** Return the text of a function in the WAT, up to the next top-level field of the module. */
+std::string_view function_text(std::string_view wat, std::string_view name) {
+    const auto start = wat.find("(func $" + std::string(name) + " ");
+    if (start == std::string_view::npos) {
+        return std::string_view();
+    }
+    return wat.substr(start, wat.find("\n  (", start) - start);
+}
+
+}  // namespace
+
+TEST(Decompile, streamed_chunks_match_buffered_output) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+
+    auto module_result = rain::compile(ARITHMETIC, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto link_result = rain::link(mod, options);
+    ASSERT_TRUE(check_success(link_result));
+    const auto wasm = std::move(link_result).value();
+
+    auto buffered_result = rain::decompile(wasm->data());
+    ASSERT_TRUE(check_success(buffered_result));
+    const std::string buffered(std::move(buffered_result).value()->string());
+    EXPECT_NE(function_text(buffered, "add").find("i32.add"), std::string_view::npos) << buffered;
+    EXPECT_NE(function_text(buffered, "mul").find("i32.mul"), std::string_view::npos) << buffered;
+
+    {
+        std::vector<std::string> chunks;
+        ASSERT_TRUE(check_success(rain::decompile(
+            wasm->data(), [&chunks](std::string_view chunk) { chunks.emplace_back(chunk); },
+            rain::DecompileOptions{.chunk_size = 16})));
+
+        // Every chunk but the last is passed along as soon as it reaches the chunk size.
+        ASSERT_GT(chunks.size(), 1);
+        std::string streamed;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            EXPECT_FALSE(chunks[i].empty());
+            if (i + 1 < chunks.size()) {
+                EXPECT_GE(chunks[i].size(), 16);
+            }
+            streamed.append(chunks[i]);
+        }
+        EXPECT_EQ(streamed, buffered);
+    }
+
+    {
+        // Only the selected function keeps its body; the other is listed with just its signature.
+        std::string streamed;
+        ASSERT_TRUE(check_success(rain::decompile(
+            wasm->data(), [&streamed](std::string_view chunk) { streamed.append(chunk); },
+            rain::DecompileOptions{.functions = {"$add"}, .chunk_size = 16})));
+
+        const auto add = function_text(streamed, "add");
+        const auto mul = function_text(streamed, "mul");
+        ASSERT_FALSE(add.empty()) << streamed;
+        ASSERT_FALSE(mul.empty()) << streamed;
+        EXPECT_EQ(add, function_text(buffered, "add"));
+        EXPECT_EQ(mul.find("local.get"), std::string_view::npos) << streamed;
+        EXPECT_EQ(mul.find("i32.mul"), std::string_view::npos) << streamed;
+    }
+}
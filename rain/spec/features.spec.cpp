@@ -0,0 +1,158 @@
+#include "rain/spec/util.hpp"
+
+#include "rain/lang/target/wasm/linker.hpp"
+
+namespace {
+
+constexpr std::string_view CODE = R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+)";
+
+}  // namespace
+
+TEST(Features, options) {
+    rain::lang::wasm::Options options;
+    for (const auto feature : rain::lang::wasm::DEFAULT_FEATURES) {
+        EXPECT_TRUE(options.has_feature(feature)) << feature;
+    }
+    EXPECT_FALSE(options.has_feature("tail-call"));
+
+    EXPECT_TRUE(check_success(options.set_features("+tail-call,-bulk-memory")));
+    EXPECT_TRUE(options.has_feature("tail-call"));
+    EXPECT_FALSE(options.has_feature("bulk-memory"));
+
+    // Invalid feature strings leave the options as they were.
+    EXPECT_FALSE(options.set_features("+tail-call,+not-a-feature").has_value());
+    EXPECT_FALSE(options.set_features("-simd128,+relaxed-simd").has_value());
+    EXPECT_TRUE(options.has_feature("simd128"));
+    EXPECT_FALSE(options.has_feature("relaxed-simd"));
+
+    EXPECT_TRUE(check_success(options.set_cpu("mvp")));
+    EXPECT_FALSE(options.has_feature("simd128"));
+    EXPECT_FALSE(options.set_cpu("pentium").has_value());
+    EXPECT_EQ(options.cpu(), "mvp");
+}
+
+TEST(Features, baseline_build_runs) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    ASSERT_TRUE(check_success(options.set_cpu("mvp")));
+
+    auto module_result = rain::compile(CODE, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    // The features are kept in the module, so that they also apply when it is linked from bitcode.
+    const auto& llvm_function = *mod.llvm_module().getFunction("add");
+    EXPECT_EQ(llvm_function.getFnAttribute("target-cpu").getValueAsString(), "mvp");
+    EXPECT_TRUE(llvm_function.getFnAttribute("target-features")
+                    .getValueAsString()
+                    .contains("-simd128"));
+
+    auto link_result = rain::link(mod, options);
+    ASSERT_TRUE(check_success(link_result));
+    const auto wasm = std::move(link_result).value();
+
+    auto instance_result = rain::WasmInstance::instantiate(wasm->data());
+    ASSERT_TRUE(check_success(instance_result));
+    auto instance   = std::move(instance_result).value();
+    auto add_result = instance.invoke<int32_t>("add", int32_t{2}, int32_t{3});
+    ASSERT_TRUE(check_success(add_result));
+    EXPECT_EQ(std::move(add_result).value(), 5);
+}
+
+TEST(Features, linker_rejects_disallowed_features) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    ASSERT_TRUE(check_success(options.set_features("+tail-call")));
+
+    auto module_result = rain::compile(CODE, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    // The output is only allowed to use the baseline features, which the module goes beyond.
+    const std::vector<std::string> baseline = {"mutable-globals", "sign-ext"};
+    rain::lang::wasm::Linker       linker;
+    linker.set_features(baseline);
+    ASSERT_TRUE(check_success(linker.add(mod.llvm_module(), mod.llvm_target_machine())));
+    EXPECT_FALSE(linker.link().has_value());
+}
+
+TEST(Features, shared_memory_options) {
+    rain::lang::wasm::Options options;
+    ASSERT_TRUE(check_success(options.set_features("-bulk-memory")));
+
+    options.set_shared_memory(true);
+    EXPECT_TRUE(options.shared_memory());
+    for (const auto feature : rain::lang::wasm::SHARED_MEMORY_FEATURES) {
+        EXPECT_TRUE(options.has_feature(feature)) << feature;
+    }
+
+    // The features that shared memory needs cannot be taken away while it is enabled.
+    EXPECT_FALSE(options.set_features("-atomics").has_value());
+    EXPECT_FALSE(options.set_cpu("mvp").has_value());
+    EXPECT_TRUE(check_success(options.set_cpu("bleeding-edge")));
+    EXPECT_TRUE(options.has_feature("atomics"));
+
+    options.set_shared_memory(false);
+    EXPECT_TRUE(check_success(options.set_features("-atomics")));
+}
+
+TEST(Features, shared_memory_link) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    options.set_shared_memory(true);
+    options.set_max_memory(64 * 65536);
+
+    auto module_result = rain::compile(R"(
+let ready = 1
+
+export fn publish(value: i32) -> i32 {
+    ready.atomic_store(value)
+    ready.atomic_notify(-1)
+}
+
+export fn wait_for(value: i32) -> i32 {
+    ready.atomic_wait(value, -1 as i64)
+}
+)",
+                                       options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto link_result = rain::link(mod, options);
+    ASSERT_TRUE(check_success(link_result));
+    const auto wasm = std::move(link_result).value();
+
+    auto wat_result = rain::decompile(wasm->data());
+    ASSERT_TRUE(check_success(wat_result));
+    const auto wat = std::string(std::move(wat_result).value()->string());
+
+    const auto contains = [&wat](const std::string_view text) {
+        return wat.find(text) != std::string::npos;
+    };
+
+    // Every thread instantiates the module with the same (imported) memory.
+    EXPECT_TRUE(contains(R"((import "env" "memory" (memory (;0;) )")) << wat;
+    EXPECT_TRUE(contains(" 64 shared))")) << wat;
+    EXPECT_TRUE(contains("i32.atomic.store")) << wat;
+    EXPECT_TRUE(contains("memory.atomic.wait32")) << wat;
+    EXPECT_TRUE(contains("memory.atomic.notify")) << wat;
+
+    // The data segments are passive, and copied into memory once (by the start function) rather
+    // than by every instance.
+    EXPECT_TRUE(contains("(start ")) << wat;
+    EXPECT_TRUE(contains("memory.init")) << wat;
+
+    // Each thread sets up its own stack and thread-local storage.
+    for (const auto name : {"__stack_pointer", "__wasm_init_tls", "__tls_size", "__tls_align"}) {
+        EXPECT_TRUE(contains(std::string("(export \"") + name + "\"")) << name;
+    }
+}
@@ -8,6 +8,7 @@ export fn four() -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{4}, code, "four");
 }
 
 TEST(Function, calling_another) {
@@ -22,6 +23,7 @@ export fn double_four() -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{8}, code, "double_four");
 }
 
 TEST(Function, out_of_order_definition) {
@@ -50,6 +52,7 @@ export fn double_four() -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{8}, code, "double_four");
 }
 
 TEST(Function, call_static_method) {
@@ -69,6 +72,7 @@ export fn call_static_method() -> f32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(0.0f, code, "call_static_method");
 }
 
 TEST(Function, if_else) {
@@ -83,6 +87,7 @@ export fn conditional() -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{8}, code, "conditional");
 }
 
 TEST(Function, if_else_if) {
@@ -99,4 +104,5 @@ export fn conditional() -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{10}, code, "conditional");
 }
@@ -0,0 +1,305 @@
+#include "rain/spec/util.hpp"
+
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/str_cat.h"
+#include "llvm/IR/Verifier.h"
+#include "rain/lang/err/simple.hpp"
+
+namespace {
+
+rain::FileReader read_from(const absl::flat_hash_map<std::string, std::string>& files) {
+    return [&files](std::string_view path) -> rain::util::Result<std::string> {
+        if (const auto it = files.find(std::string(path)); it != files.end()) {
+            return it->second;
+        }
+        return ERR_PTR(rain::lang::err::SimpleError, "file not found");
+    };
+}
+
+}  // namespace
+
+TEST(Import, resolve_path) {
+    EXPECT_EQ(rain::ModuleGraph::resolve_path("math/mat4.rain", "./vec4"), "math/vec4.rain");
+    EXPECT_EQ(rain::ModuleGraph::resolve_path("math/mat4.rain", "../util.rain"), "util.rain");
+    EXPECT_EQ(rain::ModuleGraph::resolve_path("/std/math/mat4.rain", "./vec4"),
+              "/std/math/vec4.rain");
+    EXPECT_EQ(rain::ModuleGraph::resolve_path("main.rain", "/std/math/vec4"),
+              "/std/math/vec4.rain");
+}
+
+TEST(Import, types_and_functions_across_files) {
+    absl::flat_hash_map<std::string, std::string> files = {
+        {"vec2.rain", R"(
+export struct Vec2 {
+    x: f32,
+    y: f32,
+}
+
+export fn Vec2.new(x: f32, y: f32) -> Vec2 {
+    Vec2{ x: x, y: y }
+}
+
+export fn Vec2.dot(self, other: Vec2) -> f32 {
+    self.x * other.x + self.y * other.y
+}
+)"},
+        {"main.rain", R"(
+import { Vec2 } from "./vec2";
+
+export fn length_squared(x: f32, y: f32) -> f32 {
+    let v = Vec2.new(x, y)
+    v.dot(v)
+}
+)"},
+    };
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    rain::ModuleGraph         graph(read_from(files));
+
+    ASSERT_TRUE(check_success(graph.load("main.rain", options)));
+    ASSERT_EQ(graph.order().size(), 2);
+    EXPECT_EQ(graph.order()[0]->path, "vec2.rain");
+    EXPECT_EQ(graph.order()[1]->path, "main.rain");
+
+    auto module_result = graph.compile(options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+    mod.optimize();
+    ASSERT_TRUE(check_success(mod.emit_ir()));
+}
+
+TEST(Import, unchanged_files_are_not_validated_again) {
+    absl::flat_hash_map<std::string, std::string> files = {
+        {"four.rain", R"(
+export fn four() -> i32 {
+    4
+}
+)"},
+        {"eight.rain", R"(
+import { four } from "./four"
+
+export fn eight() -> i32 {
+    four() + four()
+}
+)"},
+        {"main.rain", R"(
+import { eight } from "./eight"
+import { four } from "./four"
+
+export fn twelve() -> i32 {
+    eight() + four()
+}
+)"},
+    };
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    llvm::ThreadPool          thread_pool;
+    rain::ModuleGraph         graph(read_from(files));
+
+    ASSERT_TRUE(check_success(graph.load("main.rain", options, &thread_pool)));
+    const auto four_validated_at  = graph.find("four.rain")->validated_at;
+    const auto eight_validated_at = graph.find("eight.rain")->validated_at;
+    const auto main_validated_at  = graph.find("main.rain")->validated_at;
+
+    // Only the root changed.
+    files["main.rain"] = R"(
+import { eight } from "./eight"
+
+export fn sixteen() -> i32 {
+    eight() * 2
+}
+)";
+    ASSERT_TRUE(check_success(graph.load("main.rain", options, &thread_pool)));
+    EXPECT_EQ(graph.find("four.rain")->validated_at, four_validated_at);
+    EXPECT_EQ(graph.find("eight.rain")->validated_at, eight_validated_at);
+    EXPECT_GT(graph.find("main.rain")->validated_at, main_validated_at);
+    ASSERT_TRUE(check_success(graph.compile(options)));
+
+    // A change to a leaf invalidates everything that (transitively) imports it.
+    files["four.rain"] = R"(
+export fn four() -> i32 {
+    2 + 2
+}
+)";
+    ASSERT_TRUE(check_success(graph.load("main.rain", options, &thread_pool)));
+    EXPECT_GT(graph.find("four.rain")->validated_at, four_validated_at);
+    EXPECT_GT(graph.find("eight.rain")->validated_at, eight_validated_at);
+    ASSERT_TRUE(check_success(graph.compile(options)));
+}
+
+TEST(Import, errors) {
+    absl::flat_hash_map<std::string, std::string> files = {
+        {"a.rain", R"(import { b } from "./b")"},
+        {"b.rain", R"(import { a } from "./a")"},
+        {"missing_name.rain", R"(import { nope } from "./c")"},
+        {"missing_file.rain", R"(import { c } from "./nope")"},
+        {"c.rain", R"(
+export fn c() -> i32 {
+    1
+}
+)"},
+    };
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    rain::ModuleGraph         graph(read_from(files));
+
+    EXPECT_FALSE(graph.load("a.rain", options).has_value());
+    EXPECT_FALSE(graph.load("missing_name.rain", options).has_value());
+    EXPECT_FALSE(graph.load("missing_file.rain", options).has_value());
+    EXPECT_TRUE(check_success(graph.load("c.rain", options)));
+}
+
+TEST(Import, sibling_modules_share_builtin_derived_types) {
+    // Both files use the same slice type and the same builtin-only function signature, which are
+    // added to the shared builtin scope, and are parsed at the same import level.
+    absl::flat_hash_map<std::string, std::string> files = {
+        {"a.rain", R"(
+export fn sum_a(n: i32) -> i32 {
+    let values = []i32{ n, n, n }
+    values.length() * values[0]
+}
+)"},
+        {"b.rain", R"(
+fn twice(n: i32) -> i32 {
+    n * 2
+}
+
+export fn sum_b(n: i32) -> i32 {
+    []i32{ n, n }.length() + twice(n)
+}
+)"},
+        {"main.rain", R"(
+import { sum_a } from "./a"
+import { sum_b } from "./b"
+
+export fn both(n: i32) -> i32 {
+    sum_a(n) + sum_b(n)
+}
+)"},
+    };
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    llvm::ThreadPool          thread_pool;
+    rain::ModuleGraph         graph(read_from(files));
+
+    const auto run_both = [&](const int32_t n) -> rain::util::Result<int32_t> {
+        auto load_result = graph.load("main.rain", options, &thread_pool);
+        FORWARD_ERROR(load_result);
+        auto module_result = graph.compile(options);
+        FORWARD_ERROR(module_result);
+        return rain::spec::run_module<int32_t>(std::move(module_result).value(), options, "both",
+                                               n);
+    };
+
+    auto first_result = run_both(2);
+    ASSERT_TRUE(check_success(first_result));
+    EXPECT_EQ(std::move(first_result).value(), (3 * 2) + (2 + 2 * 2));
+
+    // Only `a.rain` is parsed again, while `b.rain` keeps its module, which must still be able to
+    // use the slice methods.
+    const auto b_validated_at = graph.find("b.rain")->validated_at;
+    files["a.rain"]           = R"(
+export fn sum_a(n: i32) -> i32 {
+    let values = []i32{ n, n, n, n }
+    values.length() * values[0]
+}
+)";
+
+    auto second_result = run_both(2);
+    ASSERT_TRUE(check_success(second_result));
+    EXPECT_EQ(std::move(second_result).value(), (4 * 2) + (2 + 2 * 2));
+    EXPECT_EQ(graph.find("b.rain")->validated_at, b_validated_at);
+}
+
+TEST(Import, independent_files_are_loaded_in_parallel) {
+    // Every part is at the same depth, so they are parsed and validated at the same time. Each one
+    // derives the same slice types from both a builtin type and a type imported from `vec2.rain`,
+    // which add their methods to the shared builtin scope and to the scope of `vec2.rain`.
+    constexpr int PART_COUNT = 16;
+
+    absl::flat_hash_map<std::string, std::string> files = {
+        {"vec2.rain", R"(
+export struct Vec2 {
+    x: i32,
+    y: i32,
+}
+)"},
+    };
+
+    std::string main_imports;
+    std::string main_sum = "0";
+    for (int i = 0; i < PART_COUNT; ++i) {
+        const std::string name             = absl::StrCat("part", i);
+        files[absl::StrCat(name, ".rain")] = absl::StrCat(
+            "import { Vec2 } from \"./vec2\"\n"
+            "\n"
+            "export fn ", name, "(n: i32) -> i32 {\n"
+            "    let points = []Vec2{ Vec2{ x: n, y: ", i, " }, Vec2{ x: n, y: n } }\n"
+            "    let values = []i32{ points[0].y, points[1].x }\n"
+            "    points.length() + values[0] + values[1]\n"
+            "}\n");
+
+        absl::StrAppend(&main_imports, "import { ", name, " } from \"./", name, "\"\n");
+        absl::StrAppend(&main_sum, " + ", name, "(n)");
+    }
+    files["main.rain"] = absl::StrCat(main_imports,
+                                      "\n"
+                                      "export fn sum(n: i32) -> i32 {\n"
+                                      "    ", main_sum, "\n"
+                                      "}\n");
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    llvm::ThreadPool          thread_pool;
+    rain::ModuleGraph         graph(read_from(files));
+
+    ASSERT_TRUE(check_success(graph.load("main.rain", options, &thread_pool)));
+    ASSERT_EQ(graph.order().size(), PART_COUNT + 2);
+    EXPECT_EQ(graph.order().front()->path, "vec2.rain");
+    EXPECT_EQ(graph.order().back()->path, "main.rain");
+
+    // The parts are numbered after the file they import, and before the file that imports them.
+    const auto vec2_validated_at = graph.find("vec2.rain")->validated_at;
+    const auto main_validated_at = graph.find("main.rain")->validated_at;
+    for (int i = 0; i < PART_COUNT; ++i) {
+        const auto* part = graph.find(absl::StrCat("part", i, ".rain"));
+        ASSERT_NE(part, nullptr);
+        EXPECT_GT(part->validated_at, vec2_validated_at);
+        EXPECT_LT(part->validated_at, main_validated_at);
+    }
+
+    auto module_result = graph.compile(options);
+    ASSERT_TRUE(check_success(module_result));
+    auto run_result = rain::spec::run_module<int32_t>(std::move(module_result).value(), options,
+                                                      "sum", int32_t{3});
+    ASSERT_TRUE(check_success(run_result));
+
+    // Each part returns 2 + i + 3.
+    int32_t expected = 0;
+    for (int i = 0; i < PART_COUNT; ++i) {
+        expected += 2 + i + 3;
+    }
+    EXPECT_EQ(std::move(run_result).value(), expected);
+
+    // An error in one of the parts fails the load, and drops its partially validated module.
+    files["part7.rain"] = R"(
+export fn part7(n: i32) -> i32 {
+    missing(n)
+}
+)";
+    EXPECT_FALSE(graph.load("main.rain", options, &thread_pool).has_value());
+    EXPECT_EQ(graph.find("part7.rain")->module.get(), nullptr);
+}
@@ -0,0 +1,228 @@
+#include "llvm/IR/Verifier.h"
+#include "rain/spec/util.hpp"
+
+TEST(Incremental, unchanged_functions_are_reused) {
+    const std::string_view before = R"(
+fn four() -> i32 {
+    4
+}
+
+export fn double_four() -> i32 {
+    2 * four()
+}
+
+export fn triple_four() -> i32 {
+    3 * four()
+}
+)";
+
+    const std::string_view after = R"(
+fn four() -> i32 {
+    4
+}
+
+export fn double_four() -> i32 {
+    four() + four()
+}
+
+// Comments and whitespace do not invalidate a function.
+export fn triple_four() -> i32 {
+    3  *  four()
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options       options;
+    rain::lang::code::FunctionCache cache;
+
+    {
+        auto module_result = rain::compile(before, options, cache);
+        ASSERT_TRUE(check_success(module_result));
+        EXPECT_EQ(cache.size(), 3);
+    }
+
+    const auto previous = cache.graph();
+
+    auto module_result = rain::compile(after, options, cache);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    const auto invalidated = cache.graph().invalidated(previous);
+    EXPECT_EQ(invalidated.size(), 1);
+    EXPECT_TRUE(invalidated.contains("double_four:fn() -> i32"));
+
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+    for (const auto* name : {"four", "double_four", "triple_four"}) {
+        const auto* llvm_function = mod.llvm_module().getFunction(name);
+        ASSERT_NE(llvm_function, nullptr) << name;
+        EXPECT_FALSE(llvm_function->isDeclaration()) << name;
+    }
+    EXPECT_TRUE(mod.llvm_module().getFunction("four")->hasInternalLinkage());
+
+    mod.optimize();
+    auto ir_result = mod.emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+}
+
+TEST(Incremental, signature_change_invalidates_callers) {
+    const std::string_view before = R"(
+fn four() -> i32 {
+    4
+}
+
+export fn double_four() -> i32 {
+    2 * four()
+}
+)";
+
+    const std::string_view after = R"(
+fn four() -> f32 {
+    4.0
+}
+
+export fn double_four() -> f32 {
+    2.0 * four()
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options       options;
+    rain::lang::code::FunctionCache cache;
+
+    ASSERT_TRUE(check_success(rain::compile(before, options, cache)));
+    const auto previous = cache.graph();
+
+    ASSERT_TRUE(check_success(rain::compile(after, options, cache)));
+    EXPECT_EQ(cache.graph().invalidated(previous).size(), 2);
+}
+
+TEST(Incremental, option_change_invalidates_everything) {
+    const std::string_view code = R"(
+fn four() -> i32 {
+    4
+}
+
+export fn double_four() -> i32 {
+    2 * four()
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options       options;
+    rain::lang::code::FunctionCache cache;
+
+    ASSERT_TRUE(check_success(rain::compile(code, options, cache)));
+    auto previous = cache.graph();
+
+    ASSERT_TRUE(check_success(rain::compile(code, options, cache)));
+    EXPECT_TRUE(cache.graph().invalidated(previous).empty());
+    previous = cache.graph();
+
+    // Tail calls change the code generated for the same source.
+    ASSERT_TRUE(check_success(options.set_features("+tail-call")));
+    ASSERT_TRUE(check_success(rain::compile(code, options, cache)));
+    EXPECT_EQ(cache.graph().invalidated(previous).size(), 2);
+}
+
+TEST(Incremental, overloads_keep_their_symbols_when_reordered) {
+    const std::string_view before = R"(
+fn scale(x: i32) -> i32 {
+    x * 10
+}
+
+fn scale(x: f32) -> f32 {
+    x * 2.0
+}
+
+export fn scale_int() -> i32 {
+    scale(4)
+}
+
+export fn scale_float() -> f32 {
+    scale(4.0)
+}
+)";
+
+    const std::string_view reordered = R"(
+fn scale(x: f32) -> f32 {
+    x * 2.0
+}
+
+fn scale(x: i32) -> i32 {
+    x * 10
+}
+
+export fn scale_int() -> i32 {
+    scale(4)
+}
+
+export fn scale_float() -> f32 {
+    scale(4.0)
+}
+)";
+
+    const std::string_view single = R"(
+fn scale(x: i32) -> i32 {
+    x * 10
+}
+
+export fn scale_int() -> i32 {
+    scale(4)
+}
+)";
+
+    rain::spec::initialize_llvm();
+
+    rain::spec::Options             options;
+    rain::lang::code::FunctionCache cache;
+
+    ASSERT_TRUE(check_success(rain::compile(before, options, cache)));
+    auto previous = cache.graph();
+
+    {
+        // Every function is reused, so each caller must still link against the same overload.
+        auto module_result = rain::compile(reordered, options, cache);
+        ASSERT_TRUE(check_success(module_result));
+        auto mod = std::move(module_result).value();
+        EXPECT_TRUE(cache.graph().invalidated(previous).empty());
+
+        EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+        EXPECT_NE(mod.llvm_module().getFunction("scale(i32)"), nullptr);
+        EXPECT_NE(mod.llvm_module().getFunction("scale(f32)"), nullptr);
+
+        auto run_result = rain::spec::run_module<int32_t>(std::move(mod), options, "scale_int");
+        ASSERT_TRUE(check_success(run_result));
+        EXPECT_EQ(std::move(run_result).value(), 40);
+    }
+
+    {
+        auto module_result = rain::compile(reordered, options, cache);
+        ASSERT_TRUE(check_success(module_result));
+        auto run_result = rain::spec::run_module<float>(std::move(module_result).value(), options,
+                                                        "scale_float");
+        ASSERT_TRUE(check_success(run_result));
+        EXPECT_EQ(std::move(run_result).value(), 8.0f);
+    }
+    previous = cache.graph();
+
+    // Without its overload the function goes back to its plain symbol, which its caller links
+    // against, so both are generated again.
+    auto module_result = rain::compile(single, options, cache);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    const auto invalidated = cache.graph().invalidated(previous);
+    EXPECT_EQ(invalidated.size(), 2);
+    EXPECT_TRUE(invalidated.contains("scale:fn(i32) -> i32"));
+    EXPECT_TRUE(invalidated.contains("scale_int:fn() -> i32"));
+
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+    EXPECT_NE(mod.llvm_module().getFunction("scale"), nullptr);
+
+    auto run_result = rain::spec::run_module<int32_t>(std::move(mod), options, "scale_int");
+    ASSERT_TRUE(check_success(run_result));
+    EXPECT_EQ(std::move(run_result).value(), 40);
+}
@@ -19,6 +19,7 @@ export fn fib_iteration(n: i32) -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{55}, code, "fib_iteration", int32_t{10});
 }
 
 TEST(Integration, mat4) {
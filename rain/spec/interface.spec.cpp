@@ -1,3 +1,4 @@
+#include "absl/strings/str_cat.h"
 #include "rain/spec/util.hpp"
 
 TEST(Interface, static_definition_only) {
@@ -31,13 +32,329 @@ interface Entity {
     fn update(&self)
 }
 
-//impl Player : Entity {
-//    fn update(&self) {
-//        self.x = self.x + 1.0
-//        self.y = self.y + 1.0
-//    }
-//}
+impl Player : Entity {
+    fn update(&self) {
+        self.x = self.x + 1.0
+        self.y = self.y + 1.0
+    }
+}
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
 }
+
+namespace {
+
+constexpr std::string_view PLAYER = R"(
+struct Player {
+    x: i32,
+    y: i32,
+}
+
+interface Entity {
+    fn update(&self)
+    fn score(&self) -> i32
+}
+
+impl Player : Entity {
+    fn update(&self) {
+        self.x = self.x + 1
+        self.y = self.y + 2
+    }
+
+    fn score(&self) -> i32 {
+        self.x * 10 + self.y
+    }
+}
+
+fn update_twice(entity: Entity) -> i32 {
+    entity.update()
+    entity.update()
+    entity.score()
+}
+)";
+
+}  // namespace
+
+TEST(Interface, dispatch) {
+    const std::string code = absl::StrCat(PLAYER, R"(
+export fn run(x: i32, y: i32) -> i32 {
+    let player = Player{ x: x, y: y }
+    update_twice(player as Entity) + player.x
+}
+)");
+
+    // The interface value points to the player, which is updated in place.
+    EXPECT_RUN_RESULT(int32_t{36 + 3}, code, "run", int32_t{1}, int32_t{2});
+
+    // The implementation is not known within `update_twice`, so it calls through the vtbl.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("call void %"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("call i32 %"), std::string::npos) << ir;
+}
+
+TEST(Interface, vtbl_layout) {
+    const std::string code = absl::StrCat(PLAYER, R"(
+export fn run(x: i32, y: i32) -> i32 {
+    update_twice(Player{ x: x, y: y } as Entity)
+}
+)");
+
+    EXPECT_RUN_RESULT(int32_t{36}, code, "run", int32_t{1}, int32_t{2});
+
+    // An interface value is a pointer to the value and a pointer to the vtbl, which points to the
+    // implementation of each method in the order that the interface declares them.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("%Entity = type { ptr, ptr }"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("@Player.Entity.vtbl = internal unnamed_addr constant { ptr, ptr } "
+                      "{ ptr @Player.update, ptr @Player.score }"),
+              std::string::npos)
+        << ir;
+}
+
+TEST(Interface, vtbl_is_shared) {
+    const std::string code = absl::StrCat(PLAYER, R"(
+export fn run(x: i32, y: i32) -> i32 {
+    let a = Player{ x: x, y: 0 }
+    let b = Player{ x: 0, y: y }
+    update_twice(a as Entity) + update_twice(b as Entity)
+}
+)");
+
+    EXPECT_RUN_RESULT(int32_t{(30 + 4) + (20 + 6)}, code, "run", int32_t{1}, int32_t{2});
+
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("@Player.Entity.vtbl ="), std::string::npos) << ir;
+    EXPECT_EQ(ir.find("@Player.Entity.vtbl.1"), std::string::npos) << ir;
+}
+
+TEST(Interface, known_implementation_is_called_directly) {
+    const std::string code = absl::StrCat(PLAYER, R"(
+export fn run(x: i32, y: i32) -> i32 {
+    let player = Player{ x: x, y: y }
+    (player as Entity).update()
+    let entity = player as Entity
+    entity.score()
+}
+)");
+
+    EXPECT_RUN_RESULT(int32_t{20 + 4}, code, "run", int32_t{1}, int32_t{2});
+
+    // The vtbl of each interface value is known where its method is called, so the calls are
+    // devirtualized even before any optimizations run.
+    const auto ir  = rain::spec::compile_unoptimized_ir(code);
+    const auto run = ir.find("@run(");
+    ASSERT_NE(run, std::string::npos) << ir;
+    const auto run_ir = ir.substr(run, ir.find("\n}\n", run) - run);
+    EXPECT_NE(run_ir.find("call void @Player.update("), std::string::npos) << ir;
+    EXPECT_NE(run_ir.find("call i32 @Player.score("), std::string::npos) << ir;
+    EXPECT_EQ(run_ir.find("call void %"), std::string::npos) << ir;
+    EXPECT_EQ(run_ir.find("call i32 %"), std::string::npos) << ir;
+}
+
+TEST(Interface, whole_program_devirtualization) {
+    const std::string code = absl::StrCat(PLAYER, R"(
+export fn run(x: i32, y: i32) -> i32 {
+    update_twice(Player{ x: x, y: y } as Entity)
+}
+)");
+
+    const auto compile_update_twice = [](const std::string_view source, bool devirtualize,
+                                         int32_t expected) -> std::string {
+        rain::spec::initialize_llvm();
+
+        rain::spec::Options options;
+        options.set_whole_program_devirtualization(devirtualize);
+
+        auto module_result = rain::compile(source, options);
+        EXPECT_TRUE(check_success(module_result));
+        if (!module_result.has_value()) {
+            return "";
+        }
+        auto mod = std::move(module_result).value();
+        EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+
+        auto ir_result = mod.emit_ir();
+        EXPECT_TRUE(check_success(ir_result));
+
+        auto run_result = rain::spec::run_module<int32_t>(std::move(mod), options, "run",
+                                                          int32_t{1}, int32_t{2});
+        EXPECT_TRUE(check_success(run_result));
+        if (run_result.has_value()) {
+            EXPECT_EQ(std::move(run_result).value(), expected);
+        }
+
+        if (!ir_result.has_value()) {
+            return "";
+        }
+        const auto ir    = std::move(ir_result).value();
+        const auto start = ir.find("@update_twice(");
+        EXPECT_NE(start, std::string::npos) << ir;
+        return start == std::string::npos ? "" : ir.substr(start, ir.find("\n}\n", start) - start);
+    };
+
+    // Player is the only type that implements Entity, so its methods are called directly, even
+    // where the value's vtbl is not known.
+    auto ir = compile_update_twice(code, true, 36);
+    EXPECT_NE(ir.find("call void @Player.update("), std::string::npos) << ir;
+    EXPECT_NE(ir.find("call i32 @Player.score("), std::string::npos) << ir;
+    EXPECT_EQ(ir.find("call void %"), std::string::npos) << ir;
+    EXPECT_EQ(ir.find("call i32 %"), std::string::npos) << ir;
+
+    // Without the option, other modules may still implement the interface.
+    ir = compile_update_twice(code, false, 36);
+    EXPECT_NE(ir.find("call void %"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("call i32 %"), std::string::npos) << ir;
+
+    // With a second implementation, the call has to go through the vtbl.
+    const std::string two_implementations = absl::StrCat(code, R"(
+struct Ghost {
+    score: i32,
+}
+
+impl Ghost : Entity {
+    fn update(&self) {
+        self.score = self.score + 1
+    }
+
+    fn score(&self) -> i32 {
+        self.score
+    }
+}
+
+export fn haunt(score: i32) -> i32 {
+    update_twice(Ghost{ score: score } as Entity)
+}
+)");
+    ir = compile_update_twice(two_implementations, true, 36);
+    EXPECT_NE(ir.find("call void %"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("call i32 %"), std::string::npos) << ir;
+}
+
+TEST(Interface, self_by_value) {
+    const std::string_view code = R"(
+struct Rect {
+    w: i32,
+    h: i32,
+}
+
+interface Shape {
+    fn area(self) -> i32
+}
+
+impl Rect : Shape {
+    fn area(self) -> i32 {
+        self.w * self.h
+    }
+}
+
+fn area_of(shape: Shape) -> i32 {
+    shape.area()
+}
+
+export fn run(w: i32, h: i32) -> i32 {
+    area_of(Rect{ w: w, h: h } as Shape)
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{3 * 4}, code, "run", int32_t{3}, int32_t{4});
+}
+
+TEST(Interface, missing_method) {
+    const std::string_view code = R"(
+struct Player {
+    x: i32,
+}
+
+interface Entity {
+    fn update(&self)
+    fn score(&self) -> i32
+}
+
+impl Player : Entity {
+    fn update(&self) {
+        self.x = self.x + 1
+    }
+}
+)";
+
+    EXPECT_COMPILE_ERROR(code);
+}
+
+TEST(Interface, mismatched_return_type) {
+    const std::string_view code = R"(
+struct Player {
+    x: i32,
+}
+
+interface Entity {
+    fn score(&self) -> i32
+}
+
+impl Player : Entity {
+    fn score(&self) -> f32 {
+        1.0
+    }
+}
+)";
+
+    EXPECT_COMPILE_ERROR(code);
+}
+
+TEST(Interface, implemented_twice) {
+    const std::string_view code = R"(
+struct Player {
+    x: i32,
+}
+
+interface Entity {
+    fn score(&self) -> i32
+}
+
+impl Player : Entity {
+    fn score(&self) -> i32 {
+        self.x
+    }
+}
+
+impl Player : Entity {
+    fn score(&self) -> i32 {
+        self.x
+    }
+}
+)";
+
+    EXPECT_COMPILE_ERROR(code);
+}
+
+TEST(Interface, cast_without_implementation) {
+    const std::string_view code = R"(
+struct Player {
+    x: i32,
+}
+
+interface Entity {
+    fn score(&self) -> i32
+}
+
+export fn run(x: i32) -> i32 {
+    (Player{ x: x } as Entity).score()
+}
+)";
+
+    EXPECT_COMPILE_ERROR(code);
+}
+
+TEST(Interface, static_method_call) {
+    const std::string_view code = R"(
+interface Closable {
+    fn close()
+}
+
+export fn run() {
+    Closable.close()
+}
+)";
+
+    EXPECT_COMPILE_ERROR(code);
+}
@@ -0,0 +1,167 @@
+#include "rain/spec/util.hpp"
+
+#include <cmath>
+
+#include "rain/lang/target/native/init.hpp"
+#include "rain/lang/target/native/jit.hpp"
+#include "rain/lang/target/native/options.hpp"
+
+namespace {
+
+int32_t host_triple(int32_t x) { return x * 3; }
+
+rain::lang::native::Jit create_jit(std::string_view code) {
+    rain::lang::native::initialize_llvm();
+
+    rain::lang::native::Options options;
+    auto                        module_result = rain::compile(code, options);
+    EXPECT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto jit_result = rain::lang::native::Jit::create();
+    EXPECT_TRUE(check_success(jit_result));
+    auto jit = std::move(jit_result).value();
+    EXPECT_TRUE(check_success(jit.define_host_function("host_triple", host_triple)));
+    EXPECT_TRUE(check_success(jit.add_module(std::move(mod))));
+    return jit;
+}
+
+}  // namespace
+
+TEST(Jit, invoke_exported_functions) {
+    auto jit = create_jit(R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+
+export fn is_positive(x: f32) -> bool {
+    x > 0.0
+}
+)");
+
+    auto add_result = jit.invoke<int32_t>("add", int32_t{2}, int32_t{3});
+    ASSERT_TRUE(check_success(add_result));
+    EXPECT_EQ(std::move(add_result).value(), 5);
+
+    auto is_positive_result = jit.invoke<bool>("is_positive", -1.0f);
+    ASSERT_TRUE(check_success(is_positive_result));
+    EXPECT_FALSE(std::move(is_positive_result).value());
+
+    // The signature is checked before the function is called.
+    EXPECT_FALSE(jit.invoke<int32_t>("add", 2.0f, 3.0f).has_value());
+    EXPECT_FALSE(jit.invoke<int32_t>("add", int32_t{2}).has_value());
+    EXPECT_FALSE(jit.invoke<void>("missing").has_value());
+}
+
+TEST(Jit, function_pointers_are_stable) {
+    auto jit = create_jit(R"(
+export fn square(x: i32) -> i32 {
+    x * x
+}
+)");
+
+    auto first_result = jit.lookup<int32_t(int32_t)>("square");
+    ASSERT_TRUE(check_success(first_result));
+    auto second_result = jit.lookup<int32_t(int32_t)>("square");
+    ASSERT_TRUE(check_success(second_result));
+
+    auto* square = std::move(first_result).value();
+    EXPECT_EQ(square, std::move(second_result).value());
+    EXPECT_EQ(square(7), 49);
+}
+
+TEST(Jit, externs_call_host_functions) {
+    auto jit = create_jit(R"(
+extern ("host", "host_triple") fn host_triple(x: i32) -> i32
+extern ("js", "math", "sqrt") fn sqrt(x: f64) -> f64
+
+export fn nine() -> i32 {
+    host_triple(3)
+}
+
+export fn hypotenuse(a: f64, b: f64) -> f64 {
+    sqrt(a * a + b * b)
+}
+)");
+
+    auto nine_result = jit.invoke<int32_t>("nine");
+    ASSERT_TRUE(check_success(nine_result));
+    EXPECT_EQ(std::move(nine_result).value(), 9);
+
+    // Externs that are not host functions are looked up in the running process.
+    auto hypotenuse_result = jit.invoke<double>("hypotenuse", 3.0, 4.0);
+    ASSERT_TRUE(check_success(hypotenuse_result));
+    EXPECT_DOUBLE_EQ(std::move(hypotenuse_result).value(), 5.0);
+}
+
+TEST(Jit, f32_externs_call_float_libm_functions) {
+    auto jit = create_jit(R"(
+extern ("js", "math", "sqrt") fn sqrt(x: f32) -> f32
+extern ("js", "math", "atan2") fn atan2(y: f32, x: f32) -> f32
+
+export fn root(x: f32) -> f32 {
+    sqrt(x)
+}
+
+export fn angle(y: f32, x: f32) -> f32 {
+    atan2(y, x)
+}
+)");
+
+    // Calling `sqrt` (which takes a double) with a float would return garbage.
+    auto root_result = jit.invoke<float>("root", 2.0f);
+    ASSERT_TRUE(check_success(root_result));
+    EXPECT_FLOAT_EQ(std::move(root_result).value(), std::sqrt(2.0f));
+
+    auto angle_result = jit.invoke<float>("angle", 1.0f, 1.0f);
+    ASSERT_TRUE(check_success(angle_result));
+    EXPECT_FLOAT_EQ(std::move(angle_result).value(), std::atan2(1.0f, 1.0f));
+}
+
+TEST(Jit, externs_with_mismatched_libm_signatures_fail) {
+    rain::lang::native::initialize_llvm();
+    rain::lang::native::Options options;
+
+    EXPECT_FALSE(rain::compile(R"(
+extern ("js", "math", "sqrt") fn sqrt(x: i32) -> i32
+
+export fn root(x: i32) -> i32 {
+    sqrt(x)
+}
+)",
+                               options)
+                     .has_value());
+
+    EXPECT_FALSE(rain::compile(R"(
+extern ("js", "math", "sin") fn sin(x: f32) -> f64
+
+export fn wave(x: f32) -> f64 {
+    sin(x)
+}
+)",
+                               options)
+                     .has_value());
+}
+
+TEST(Jit, externs_with_taken_symbols_fail) {
+    rain::lang::native::initialize_llvm();
+    rain::lang::native::Options options;
+
+    // The extern would otherwise be silently renamed to `sqrtf.1`, which does not exist.
+    auto module_result = rain::compile(R"(
+export fn sqrtf(x: f32) -> f32 {
+    x
+}
+
+extern ("js", "math", "sqrt") fn root(x: f32) -> f32
+
+export fn call_root(x: f32) -> f32 {
+    root(x)
+}
+)",
+                                       options);
+    ASSERT_FALSE(module_result.has_value());
+    EXPECT_NE(module_result.error()->message().find("sqrtf"), std::string::npos)
+        << module_result.error()->message();
+}
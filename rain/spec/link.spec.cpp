@@ -0,0 +1,128 @@
+#include <string>
+#include <vector>
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/Compression.h"
+#include "llvm/Support/raw_ostream.h"
+#include "rain/spec/util.hpp"
+
+TEST(Link, output_sinks_match) {
+    const std::string_view code = R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+
+    const auto compile = [&]() {
+        auto module_result = rain::compile(code, options);
+        EXPECT_TRUE(check_success(module_result));
+        return std::move(module_result).value();
+    };
+
+    std::vector<uint8_t> expected;
+    {
+        auto mod         = compile();
+        auto wasm_result = rain::link(mod, options);
+        ASSERT_TRUE(check_success(wasm_result));
+        const auto wasm = std::move(wasm_result).value();
+        expected.assign(wasm->data().begin(), wasm->data().end());
+    }
+    ASSERT_FALSE(expected.empty());
+
+    {
+        // Link directly into memory owned by the caller.
+        std::vector<uint8_t> output;
+        auto                 mod = compile();
+        ASSERT_TRUE(check_success(rain::link(mod, options, [&output](size_t size) {
+            output.resize(size);
+            return output.data();
+        })));
+        EXPECT_EQ(output, expected);
+    }
+
+    {
+        llvm::SmallVector<char, 0> output;
+        llvm::raw_svector_ostream  ostream(output);
+        auto                       mod = compile();
+        ASSERT_TRUE(check_success(rain::link(mod, options, ostream)));
+        EXPECT_EQ(std::vector<uint8_t>(output.begin(), output.end()), expected);
+    }
+
+    {
+        // The link fails cleanly if the caller cannot provide the memory.
+        auto mod = compile();
+        EXPECT_FALSE(
+            rain::link(mod, options, [](size_t) -> uint8_t* { return nullptr; }).has_value());
+    }
+}
+
+TEST(Link, llvm_ir_and_bitcode) {
+    const std::string_view code = R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+
+    auto module_result = rain::compile(code, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto ir_result = mod.emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+    EXPECT_TRUE(check_success(rain::link(std::move(ir_result).value(), options)));
+
+    std::string              bitcode;
+    llvm::raw_string_ostream ostream(bitcode);
+    llvm::WriteBitcodeToFile(mod.llvm_module(), ostream);
+    ostream.flush();
+    EXPECT_TRUE(check_success(rain::link(bitcode, options)));
+
+    EXPECT_FALSE(rain::link("this is not llvm ir", options).has_value());
+}
+
+TEST(Link, emit_bitcode) {
+    const std::string_view code = R"(
+export fn add(a: i32, b: i32) -> i32 {
+    a + b
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+
+    auto module_result = rain::compile(code, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto bitcode_result = mod.emit_bitcode();
+    ASSERT_TRUE(check_success(bitcode_result));
+    const auto bitcode = std::move(bitcode_result).value();
+    EXPECT_TRUE(check_success(rain::link(bitcode, options)));
+
+    auto compressed_result = mod.emit_bitcode(rain::lang::code::BitcodeCompression::Zstd);
+    if (!llvm::compression::zstd::isAvailable()) {
+        EXPECT_FALSE(compressed_result.has_value());
+        return;
+    }
+    ASSERT_TRUE(check_success(compressed_result));
+    const auto compressed = std::move(compressed_result).value();
+    EXPECT_TRUE(rain::lang::code::is_compressed_bitcode(compressed));
+    EXPECT_LT(compressed.size(), bitcode.size());
+
+    auto decompressed_result = rain::lang::code::decompress_bitcode(compressed);
+    ASSERT_TRUE(check_success(decompressed_result));
+    EXPECT_EQ(decompressed_result.value(), bitcode);
+    EXPECT_TRUE(check_success(rain::link(compressed, options)));
+}
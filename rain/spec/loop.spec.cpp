@@ -0,0 +1,324 @@
+#include "llvm/IR/Verifier.h"
+#include "rain/spec/util.hpp"
+
+TEST(Loop, for_range) {
+    const std::string_view code = R"(
+export fn sum_to(n: i32) -> i32 {
+    let total = 0
+    for i in 0..n {
+        total = total + i
+    }
+    total
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{45}, code, "sum_to", int32_t{10});
+    EXPECT_RUN_RESULT(int32_t{0}, code, "sum_to", int32_t{0});
+    EXPECT_RUN_RESULT(int32_t{0}, code, "sum_to", int32_t{-5});
+}
+
+TEST(Loop, for_range_i64) {
+    const std::string_view code = R"(
+export fn product(start: i64, end: i64) -> i64 {
+    let total = 1 as i64
+    for i in start..end {
+        total = total * i
+    }
+    total
+}
+)";
+
+    EXPECT_RUN_RESULT(int64_t{120}, code, "product", int64_t{1}, int64_t{6});
+}
+
+TEST(Loop, for_slice_and_array) {
+    const std::string_view code = R"(
+export fn sum_slice() -> i32 {
+    let items = []i32{ 1, 2, 3, 4 }
+    let total = 0
+    for item in items {
+        total = total + item
+    }
+    total
+}
+
+export fn sum_array() -> i32 {
+    let items = [3]i32{ 10, 20, 30 }
+    let total = 0
+    for item in items {
+        total = total + item
+    }
+    total
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{10}, code, "sum_slice");
+    EXPECT_RUN_RESULT(int32_t{60}, code, "sum_array");
+}
+
+TEST(Loop, break_and_continue) {
+    const std::string_view code = R"(
+export fn sum_odd_until(limit: i32) -> i32 {
+    let total = 0
+    for i in 0..100 {
+        if i % 2 == 0 {
+            continue
+        }
+        if i > limit {
+            break
+        }
+        total = total + i
+    }
+    total
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{1 + 3 + 5 + 7 + 9}, code, "sum_odd_until", int32_t{10});
+}
+
+TEST(Loop, loop_until_break) {
+    const std::string_view code = R"(
+export fn first_power_of_two_above(n: i32) -> i32 {
+    let value = 1
+    loop {
+        value = value * 2
+        if value > n {
+            break
+        }
+    }
+    value
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{128}, code, "first_power_of_two_above", int32_t{100});
+}
+
+TEST(Loop, while_continue) {
+    const std::string_view code = R"(
+export fn count_multiples_of_three(n: i32) -> i32 {
+    let count = 0
+    let i = 0
+    while i < n {
+        i = i + 1
+        if i % 3 != 0 {
+            continue
+        }
+        count = count + 1
+    }
+    count
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{3}, code, "count_multiples_of_three", int32_t{10});
+}
+
+TEST(Loop, while_else_value) {
+    // The value is the last iteration of the loop, or the else block if the loop does not run. The
+    // `break` only exits the inner loop, so the while still has a value.
+    const std::string_view code = R"(
+export fn last_square(n: i32) -> i32 {
+    let i = 0
+    while i < n {
+        loop {
+            break
+        }
+        i = i + 1
+        i * i
+    } else {
+        if n < 0 {
+            100
+        } else {
+            200
+        }
+    }
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{9}, code, "last_square", int32_t{3});
+    EXPECT_RUN_RESULT(int32_t{200}, code, "last_square", int32_t{0});
+    EXPECT_RUN_RESULT(int32_t{100}, code, "last_square", int32_t{-2});
+}
+
+TEST(Loop, while_else_with_break_and_continue) {
+    const std::string_view code = R"(
+export fn find_multiple(n: i32, of: i32) -> i32 {
+    let found = 0
+    let i = 0
+    while i < n {
+        i = i + 1
+        if i % of != 0 {
+            continue
+        }
+        found = i
+        break
+    } else {
+        found = 99
+    }
+    found
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{3}, code, "find_multiple", int32_t{10}, int32_t{3});
+    EXPECT_RUN_RESULT(int32_t{0}, code, "find_multiple", int32_t{10}, int32_t{11});
+    EXPECT_RUN_RESULT(int32_t{99}, code, "find_multiple", int32_t{0}, int32_t{3});
+}
+
+TEST(Loop, while_else_continues_outer_loop) {
+    // The else block never reaches the end of the while, so only the loop's value is merged.
+    const std::string_view code = R"(
+export fn sum_of_last_squares(n: i32) -> i32 {
+    let total = 0
+    for j in 0..n {
+        let i = 0
+        let last = while i < j {
+            i = i + 1
+            i * i
+        } else {
+            continue
+            0
+        }
+        total = total + last
+    }
+    total
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{1 + 4 + 9}, code, "sum_of_last_squares", int32_t{4});
+}
+
+TEST(Loop, while_else_value_without_break_or_continue) {
+    // An iteration that is left early has no value to give the while-else.
+    EXPECT_COMPILE_ERROR(R"(
+export fn f(n: i32) -> i32 {
+    let i = 0
+    while i < n {
+        i = i + 1
+        if i == 2 {
+            break
+        }
+        i
+    } else {
+        0
+    }
+}
+)");
+    EXPECT_COMPILE_ERROR(R"(
+export fn f(n: i32) -> i32 {
+    let i = 0
+    while i < n {
+        i = i + 1
+        if i == 2 {
+            continue
+        }
+        i
+    } else {
+        0
+    }
+}
+)");
+}
+
+TEST(Loop, nested_break_only_exits_inner_loop) {
+    const std::string_view code = R"(
+export fn triangle(n: i32) -> i32 {
+    let total = 0
+    for i in 0..n {
+        for j in 0..n {
+            if j > i {
+                break
+            }
+            total = total + 1
+        }
+    }
+    total
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{1 + 2 + 3 + 4}, code, "triangle", int32_t{4});
+}
+
+TEST(Loop, invalid) {
+    // `break` and `continue` have to be inside of a loop, and not in a function nested within one.
+    EXPECT_COMPILE_ERROR(R"(
+export fn f() -> i32 {
+    break
+    1
+}
+)");
+    EXPECT_COMPILE_ERROR(R"(
+export fn f() -> i32 {
+    loop {
+        fn g() -> i32 {
+            continue
+            1
+        }
+        break
+    }
+    1
+}
+)");
+
+    // The range bounds must be the same integer type.
+    EXPECT_COMPILE_ERROR(R"(
+export fn f(n: i64) -> i32 {
+    for i in 0..n {
+        i
+    }
+    1
+}
+)");
+    EXPECT_COMPILE_ERROR(R"(
+export fn f() -> i32 {
+    for i in 0.0..1.0 {
+        i
+    }
+    1
+}
+)");
+    EXPECT_COMPILE_ERROR(R"(
+export fn f(n: i32) -> i32 {
+    for i in n {
+        i
+    }
+    1
+}
+)");
+}
+
+TEST(Loop, canonical_induction_variable) {
+    const std::string_view code = R"(
+export fn sum_to(n: i32) -> i32 {
+    let total = 0
+    for i in 0..n {
+        total = total + i
+    }
+    total
+}
+)";
+
+    rain::spec::initialize_llvm();
+
+    rain::spec::Options options;
+    auto                module_result = rain::compile(code, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+
+    auto ir_result = mod.emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+    const auto ir = std::move(ir_result).value();
+
+    // The range is checked once before the loop, and the index is only incremented (without
+    // overflow) and compared against the end in the single latch.
+    EXPECT_NE(ir.find("%i = phi i32"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("%i.next = add nsw i32 %i, 1"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("fornext:"), std::string::npos) << ir;
+}
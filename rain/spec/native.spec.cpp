@@ -0,0 +1,70 @@
+#include "rain/spec/util.hpp"
+
+#include <string>
+
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/FileSystem.h"
+#include "rain/lang/target/native/init.hpp"
+#include "rain/lang/target/native/linker.hpp"
+#include "rain/lang/target/native/options.hpp"
+
+namespace {
+
+constexpr std::string_view CODE = R"(
+struct Vec2 {
+    x: f32,
+    y: f32,
+}
+
+export fn dot(ax: f32, ay: f32, bx: f32, by: f32) -> f32 {
+    let a = Vec2{ x: ax, y: ay }
+    let b = Vec2{ x: bx, y: by }
+    a.x * b.x + a.y * b.y
+}
+)";
+
+}  // namespace
+
+TEST(Native, emits_elf_objects) {
+    rain::lang::native::initialize_llvm();
+
+    for (const auto* target_triple : {"x86_64-unknown-linux-gnu", "aarch64-unknown-linux-gnu"}) {
+        rain::lang::native::Options options;
+        options.set_target_triple(target_triple);
+
+        auto module_result = rain::compile(CODE, options);
+        ASSERT_TRUE(check_success(module_result)) << target_triple;
+        auto mod = std::move(module_result).value();
+        mod.optimize();
+
+        auto obj_result = mod.emit_obj();
+        ASSERT_TRUE(check_success(obj_result)) << target_triple;
+        const auto obj = std::move(obj_result).value();
+
+        auto object_file = llvm::object::ObjectFile::createObjectFile(obj->getMemBufferRef());
+        ASSERT_TRUE(static_cast<bool>(object_file)) << target_triple;
+        EXPECT_TRUE((*object_file)->isELF()) << target_triple;
+    }
+}
+
+TEST(Native, links_shared_library) {
+    rain::lang::native::initialize_llvm();
+
+    rain::lang::native::Options options;
+    if (!llvm::Triple(options.target_triple()).isOSBinFormatELF()) {
+        GTEST_SKIP() << "shared libraries are only supported for ELF hosts";
+    }
+
+    auto module_result = rain::compile(CODE, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    llvm::SmallString<128> output_path;
+    ASSERT_FALSE(llvm::sys::fs::createTemporaryFile("rain", "so", output_path));
+
+    const std::string output(output_path.str());
+    EXPECT_TRUE(check_success(rain::lang::native::link_shared_library(mod, output)));
+    EXPECT_TRUE(llvm::sys::fs::exists(output));
+    llvm::sys::fs::remove(output);
+}
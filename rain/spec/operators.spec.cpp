@@ -20,6 +20,10 @@ export fn neg_f64() -> f64 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{-1}, code, "neg_i32");
+    EXPECT_RUN_RESULT(int64_t{-2}, code, "neg_i64");
+    EXPECT_RUN_RESULT(-3.0f, code, "neg_f32");
+    EXPECT_RUN_RESULT(-4.0, code, "neg_f64");
 }
 
 TEST(Operator, negative) {
@@ -56,6 +60,8 @@ export fn a_mul_b_plus_c(a: f32, b: f32, c: f32) -> f32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(7.0f, code, "a_plus_b_mul_c", 1.0f, 2.0f, 3.0f);
+    EXPECT_RUN_RESULT(5.0f, code, "a_mul_b_plus_c", 1.0f, 2.0f, 3.0f);
 }
 
 TEST(Cast, as_i32) {
@@ -74,6 +80,7 @@ export fn f64_to_i32(value: f64) -> i32 {
 )";
 
     EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{3}, code, "f32_to_i32", 3.75f);
 }
 
 TEST(Cast, as_i64) {
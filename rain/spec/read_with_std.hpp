@@ -0,0 +1,34 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "absl/strings/str_cat.h"
+#include "rain/lang/err/simple.hpp"
+#include "rain/load.hpp"
+
+namespace rain::spec {
+
+/**
+ * Serve `main.rain` from memory, and everything else (such as lib/std, which the specs and
+ * benchmarks depend on as data) from disk. The source must outlive the reader.
+ */
+inline rain::FileReader read_with_std(const std::string_view main) {
+    return [main](std::string_view path) -> rain::util::Result<std::string> {
+        if (path == "main.rain") {
+            return std::string(main);
+        }
+
+        std::ifstream file{std::string(path)};
+        if (!file) {
+            return ERR_PTR(rain::lang::err::SimpleError, absl::StrCat("failed to open ", path));
+        }
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    };
+}
+
+}  // namespace rain::spec
@@ -0,0 +1,76 @@
+#include "rain/spec/util.hpp"
+
+namespace {
+
+rain::WasmInstance instantiate(const std::string_view code) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    auto                      module_result = rain::compile(code, options);
+    EXPECT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto link_result = rain::link(mod, options);
+    EXPECT_TRUE(check_success(link_result));
+    const auto wasm = std::move(link_result).value();
+
+    auto instance_result = rain::WasmInstance::instantiate(wasm->data());
+    EXPECT_TRUE(check_success(instance_result));
+    return std::move(instance_result).value();
+}
+
+}  // namespace
+
+TEST(Run, call) {
+    auto instance = instantiate(R"(
+export fn divide(a: i32, b: i32) -> i32 {
+    a / b
+}
+)");
+
+    const rain::WasmValue args[] = {int32_t{42}, int32_t{6}};
+    auto                  results_result = instance.call("divide", args);
+    ASSERT_TRUE(check_success(results_result));
+    const auto results = std::move(results_result).value();
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(std::get<int32_t>(results.front()), 7);
+
+    // Division by zero traps, instead of taking down the caller.
+    EXPECT_FALSE(instance.invoke<int32_t>("divide", int32_t{1}, int32_t{0}).has_value());
+
+    // The arguments and result are checked against the function's type.
+    EXPECT_FALSE(instance.invoke<int32_t>("divide", int32_t{1}).has_value());
+    EXPECT_FALSE(instance.invoke<int32_t>("divide", 1.0f, 2.0f).has_value());
+    EXPECT_FALSE(instance.invoke<float>("divide", int32_t{1}, int32_t{1}).has_value());
+    EXPECT_FALSE(instance.invoke<int32_t>("missing").has_value());
+}
+
+TEST(Run, count_instructions) {
+    auto instance = instantiate(R"(
+export fn sum_to(n: i32) -> i32 {
+    let sum = 0
+    let i = 0
+    while i < n {
+        i = i + 1
+        sum = sum + i
+    }
+    sum
+}
+)");
+
+    auto uncounted_result = instance.invoke<int32_t>("sum_to", int32_t{10});
+    ASSERT_TRUE(check_success(uncounted_result));
+    EXPECT_EQ(std::move(uncounted_result).value(), 55);
+    EXPECT_EQ(instance.instructions_executed(), 0);
+
+    instance.set_count_instructions(true);
+    ASSERT_TRUE(check_success(instance.invoke<int32_t>("sum_to", int32_t{10})));
+    const auto ten_instructions = instance.instructions_executed();
+    EXPECT_GT(ten_instructions, 0);
+
+    // The loop runs ten times as often, so it has to execute (many) more instructions.
+    instance.reset_instructions_executed();
+    ASSERT_TRUE(check_success(instance.invoke<int32_t>("sum_to", int32_t{100})));
+    EXPECT_GT(instance.instructions_executed(), ten_instructions * 5);
+}
@@ -0,0 +1,63 @@
+#include "rain/spec/util.hpp"
+
+TEST(Session, modules_share_llvm_context) {
+    const std::string_view code = R"(
+struct Vec2 {
+    x: f32,
+    y: f32,
+}
+
+export fn dot(a: Vec2, b: Vec2) -> f32 {
+    a.x * b.x + a.y * b.y
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    rain::Session             session(options);
+
+    auto first_result = session.compile(code);
+    ASSERT_TRUE(check_success(first_result));
+    auto first = std::move(first_result).value();
+
+    auto second_result = session.compile(code);
+    ASSERT_TRUE(check_success(second_result));
+    auto second = std::move(second_result).value();
+
+    EXPECT_EQ(&first.llvm_context(), &second.llvm_context());
+    EXPECT_EQ(&first.llvm_target_machine(), &second.llvm_target_machine());
+    EXPECT_EQ(session.modules_in_context(), 2);
+
+    second.optimize();
+    ASSERT_TRUE(check_success(second.emit_ir()));
+}
+
+TEST(Session, context_is_replaced_after_limit) {
+    const std::string_view code = R"(
+export fn four() -> i32 {
+    4
+}
+)";
+
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    rain::Session             session(options);
+    session.set_max_modules_per_context(1);
+
+    auto first_result = session.compile(code);
+    ASSERT_TRUE(check_success(first_result));
+    auto first = std::move(first_result).value();
+
+    auto second_result = session.compile(code);
+    ASSERT_TRUE(check_success(second_result));
+    auto second = std::move(second_result).value();
+
+    // The first module keeps its own context alive.
+    EXPECT_NE(&first.llvm_context(), &second.llvm_context());
+    ASSERT_TRUE(check_success(first.emit_ir()));
+
+    session.reset();
+    EXPECT_EQ(session.modules_in_context(), 0);
+}
@@ -0,0 +1,196 @@
+#include "rain/spec/util.hpp"
+
+TEST(Simd, i32x4_arithmetic) {
+    const std::string_view code = R"(
+export fn arithmetic(n: i32) -> i32 {
+    let a = i32x4{ x: 1, y: 2, z: 3, w: 4 }
+    let b = i32x4.splat(n)
+    let c = (a + b) * a - (-b)
+    c.x + c.y + c.z + c.w
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(int32_t{21 + 34 + 49 + 66}, code, "arithmetic", int32_t{10});
+}
+
+TEST(Simd, i32x4_bitwise_and_shifts) {
+    const std::string_view code = R"(
+export fn bitwise(shift: i32) -> i32 {
+    let a = i32x4{ x: 12, y: 10, z: -16, w: 1 }
+    let b = i32x4.splat(6)
+    let c = ((a & b) | (a ^ b)) | (!i32x4.splat(-1))
+    let d = a >> shift
+    let e = a << (shift + 31)
+    c.x + c.y * 100 + d.z * 10000 + e.x * 1000000
+}
+)";
+
+    // The shift amount wraps to the width of a lane, so shifting by 33 shifts by 1.
+    EXPECT_RUN_RESULT(int32_t{14 + 1400 - 40000 + 24000000}, code, "bitwise", int32_t{2});
+}
+
+TEST(Simd, u32x4_shifts_are_logical) {
+    const std::string_view code = R"(
+export fn shift(value: i32) -> i32 {
+    let signed = i32x4.splat(value) >> 28
+    let unsigned = u32x4.splat(value) >> 28
+    signed.x * 100 + unsigned.x
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{-100 + 15}, code, "shift", int32_t{-1});
+}
+
+TEST(Simd, comparisons_and_select) {
+    const std::string_view code = R"(
+export fn clamp_low(limit: i32) -> i32 {
+    let a = i32x4{ x: 1, y: 5, z: 3, w: 8 }
+    let b = i32x4.splat(limit)
+    let c = (a < b).select(b, a)
+    let mask = a == i32x4{ x: 1, y: 0, z: 3, w: 0 }
+    c.x + c.y * 10 + c.z * 100 + c.w * 1000 + mask.x + mask.y + mask.z + mask.w
+}
+)";
+
+    // Each lane of the mask is -1 (every bit set) where the comparison holds.
+    EXPECT_RUN_RESULT(int32_t{4 + 50 + 400 + 8000 - 2}, code, "clamp_low", int32_t{4});
+}
+
+TEST(Simd, unsigned_comparisons) {
+    const std::string_view code = R"(
+export fn less(value: i32) -> i32 {
+    let signed = i32x4.splat(value) < i32x4.splat(1)
+    let unsigned = u32x4.splat(value) < u32x4.splat(1)
+    signed.x * 10 + unsigned.x
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{-10}, code, "less", int32_t{-1});
+}
+
+TEST(Simd, saturating_arithmetic) {
+    const std::string_view code = R"(
+export fn saturate(value: i32) -> i32 {
+    let a = i16x8.splat((value * 300) as i16).add_sat(i16x8.splat(30000 as i16))
+    let b = u8x16.splat(value as u8).sub_sat(u8x16.splat(200 as u8))
+    let c = u8x16.splat(value as u8).add_sat(u8x16.splat(200 as u8))
+    (a.s7 as i32) * 10000 + (b.extend_low().s0 as i32) * 1000 + (c.extend_high().s7 as i32)
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{32767 * 10000 + 0 * 1000 + 255}, code, "saturate", int32_t{100});
+}
+
+TEST(Simd, min_max_and_abs) {
+    const std::string_view code = R"(
+export fn min_max(value: i32) -> i32 {
+    let a = i32x4{ x: -3, y: 7, z: 0, w: 2 }
+    let b = i32x4.splat(value)
+    let low = a.min(b)
+    let high = a.max(b)
+    let distance = (a - b).abs()
+    let unsigned = u32x4.splat(-1).min(u32x4.splat(value))
+    low.x + low.y * 10 + high.x * 100 + distance.x * 1000 + distance.y * 10000 + unsigned.x
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{-3 + 10 + 100 + 4000 + 60000 + 1}, code, "min_max", int32_t{1});
+}
+
+TEST(Simd, extend_and_narrow) {
+    const std::string_view code = R"(
+export fn narrow(value: i32) -> i32 {
+    let ints = i32x4{ x: value, y: -value, z: 1, w: 2 }
+    let shorts = ints.narrow(i32x4.splat(3))
+    let bytes = shorts.narrow(i16x8.splat(300 as i16))
+    let low = bytes.extend_low()
+    let high = bytes.extend_high()
+    let wide = shorts.extend_low()
+    (low.s0 as i32) + (low.s3 as i32) * 1000 + (high.s0 as i32) * 10000 + wide.x + wide.y
+}
+)";
+
+    // shorts = {32767, -32768, 1, 2, 3, 3, 3, 3}, and bytes saturates those (and 300) to 0..255.
+    EXPECT_RUN_RESULT(int32_t{255 + 2000 + 2550000 + 32767 - 32768}, code, "narrow",
+                      int32_t{40000});
+}
+
+TEST(Simd, float_conversions) {
+    const std::string_view code = R"(
+export fn convert(value: f32) -> f32 {
+    let floats = f32x4{ x: value, y: -value, z: 3000000000.0, w: 0.5 }
+    let ints = floats as i32x4
+    let unsigned = floats as u32x4
+    let back = ints as f32x4
+    let doubles = floats as f64x2
+    let demoted = (doubles * f64x2.splat(2.0 as f64)) as f32x4
+    let rest = demoted.y + demoted.z
+    back.x + back.y * 10.0 + (unsigned.x as f32) * 100.0 + (unsigned.y as f32) + rest
+}
+)";
+
+    // Out of range lanes saturate (to 0 for -2.5 as unsigned), and demoting fills z and w with 0.
+    EXPECT_RUN_RESULT(2.0f - 20.0f + 200.0f + 0.0f - 5.0f + 0.0f, code, "convert", 2.5f);
+}
+
+TEST(Simd, f64x2_arithmetic_and_select) {
+    const std::string_view code = R"(
+export fn f64x2_math(value: f64) -> f64 {
+    let a = f64x2{ x: value, y: 1.0 as f64 }
+    let b = f64x2.splat(2.0 as f64)
+    let c = (a * b + b) / b - (-a)
+    let d = (a > b).select(a, b)
+    c.x + c.y + d.x * (100.0 as f64) + d.y * (1000.0 as f64)
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(7.0 + 3.0 + 300.0 + 2000.0, code, "f64x2_math", 3.0);
+}
+
+TEST(Simd, f32x4_rounding_and_sqrt) {
+    const std::string_view code = R"(
+export fn rounding(value: f32) -> f32 {
+    let a = f32x4{ x: value, y: -4.0, z: 2.25, w: -0.5 }
+    let roots = a.abs().sqrt()
+    let b = f32x4{ x: 1.5, y: -1.5, z: 2.5, w: -2.7 }
+    roots.x + roots.y * 10.0 + b.floor().sum() * 100.0 + b.ceil().sum() * 1000.0 +
+        b.trunc().sum() + b.nearest().sum() * 10000.0
+}
+)";
+
+    // floor = {1, -2, 2, -3}, ceil = {2, -1, 3, -2}, trunc = {1, -1, 2, -2} and (rounding halfway
+    // values to even) nearest = {2, -2, 2, -3}.
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(3.0f + 20.0f - 200.0f + 2000.0f + 0.0f - 10000.0f, code, "rounding", 9.0f);
+}
+
+TEST(Simd, f32x4_min_max_fma_and_reductions) {
+    const std::string_view code = R"(
+export fn reductions(value: f32) -> f32 {
+    let a = f32x4{ x: 1.0, y: 5.0, z: -2.0, w: 8.0 }
+    let b = f32x4{ x: value, y: 3.0, z: 0.0, w: -1.0 }
+    let low = a.min(b).sum()
+    let high = a.max(b).sum()
+    let fused = a.fma(b, f32x4.splat(1.0)).sum()
+    low + high * 10.0 + fused * 100.0 + a.dot(b) * 1000.0 + a.min_lane() * 10000.0 +
+        a.max_lane() * 100000.0
+}
+)";
+
+    EXPECT_COMPILE_SUCCESS(code);
+    EXPECT_RUN_RESULT(1.0f + 170.0f + 1500.0f + 11000.0f - 20000.0f + 800000.0f, code, "reductions",
+                      4.0f);
+}
+
+TEST(Simd, f64x2_reductions) {
+    const std::string_view code = R"(
+export fn length_squared(value: f64) -> f64 {
+    let v = f64x2{ x: value, y: 4.0 as f64 }
+    v.dot(v) + v.max_lane() * (100.0 as f64) + v.min(f64x2.splat(1.0 as f64)).sum()
+}
+)";
+
+    EXPECT_RUN_RESULT(25.0 + 400.0 + 2.0, code, "length_squared", 3.0);
+}
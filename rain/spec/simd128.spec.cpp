@@ -0,0 +1,126 @@
+#include <string>
+
+#include "rain/spec/util.hpp"
+
+// Checks that the SIMD builtins lower to the wasm simd128 instruction that matches them (where
+// there is one), rather than to a sequence of scalar operations.
+
+namespace {
+
+rain::util::Result<std::string> compile_to_wat(const std::string_view code) {
+    rain::lang::wasm::initialize_llvm();
+
+    rain::lang::wasm::Options options;
+    auto                      module_result = rain::compile(code, options);
+    FORWARD_ERROR(module_result);
+    auto mod = std::move(module_result).value();
+    mod.optimize();
+
+    auto link_result = rain::link(mod, options);
+    FORWARD_ERROR(link_result);
+    const auto wasm = std::move(link_result).value();
+
+    auto wat_result = rain::decompile(wasm->data());
+    FORWARD_ERROR(wat_result);
+    return std::string(std::move(wat_result).value()->string());
+}
+
+}  // namespace
+
+TEST(Simd128, integer_vectors) {
+    auto wat_result = compile_to_wat(R"(
+export fn add(a: i32x4, b: i32x4) -> i32x4 { a + b }
+export fn shl(a: i32x4, n: i32) -> i32x4 { a << n }
+export fn shr_u(a: u32x4, n: i32) -> u32x4 { a >> n }
+export fn less(a: i32x4, b: i32x4) -> i32x4 { a < b }
+export fn pick(mask: i32x4, a: i32x4, b: i32x4) -> i32x4 { mask.select(a, b) }
+export fn splat(n: i32) -> i32x4 { i32x4.splat(n) }
+export fn min_u(a: u32x4, b: u32x4) -> u32x4 { a.min(b) }
+export fn abs(a: i32x4) -> i32x4 { a.abs() }
+export fn add_sat(a: i16x8, b: i16x8) -> i16x8 { a.add_sat(b) }
+export fn sub_sat(a: u8x16, b: u8x16) -> u8x16 { a.sub_sat(b) }
+export fn extend(a: u8x16) -> i16x8 { a.extend_low() }
+export fn narrow(a: i16x8, b: i16x8) -> u8x16 { a.narrow(b) }
+)");
+    ASSERT_TRUE(check_success(wat_result));
+    const auto wat = std::move(wat_result).value();
+
+    for (const auto instruction : {
+             "i32x4.add",
+             "i32x4.shl",
+             "i32x4.shr_u",
+             "i32x4.lt_s",
+             "v128.bitselect",
+             "i32x4.splat",
+             "i32x4.min_u",
+             "i32x4.abs",
+             "i16x8.add_sat_s",
+             "i8x16.sub_sat_u",
+             "i16x8.extend_low_i8x16_u",
+             "i8x16.narrow_i16x8_u",
+         }) {
+        EXPECT_NE(wat.find(instruction), std::string::npos) << instruction << "\n" << wat;
+    }
+}
+
+TEST(Simd128, float_vectors_and_conversions) {
+    auto wat_result = compile_to_wat(R"(
+export fn div(a: f64x2, b: f64x2) -> f64x2 { a / b }
+export fn greater(a: f64x2, b: f64x2) -> f64x2 { a > b }
+export fn trunc(a: f32x4) -> i32x4 { a as i32x4 }
+export fn convert(a: i32x4) -> f32x4 { a as f32x4 }
+export fn promote(a: f32x4) -> f64x2 { a as f64x2 }
+export fn demote(a: f64x2) -> f32x4 { a as f32x4 }
+)");
+    ASSERT_TRUE(check_success(wat_result));
+    const auto wat = std::move(wat_result).value();
+
+    for (const auto instruction : {
+             "f64x2.div",
+             "f64x2.gt",
+             "i32x4.trunc_sat_f32x4_s",
+             "f32x4.convert_i32x4_s",
+             "f64x2.promote_low_f32x4",
+             "f32x4.demote_f64x2_zero",
+         }) {
+        EXPECT_NE(wat.find(instruction), std::string::npos) << instruction << "\n" << wat;
+    }
+}
+
+TEST(Simd128, float_math) {
+    auto wat_result = compile_to_wat(R"(
+export fn sqrt(a: f32x4) -> f32x4 { a.sqrt() }
+export fn abs(a: f32x4) -> f32x4 { a.abs() }
+export fn min(a: f32x4, b: f32x4) -> f32x4 { a.min(b) }
+export fn max(a: f32x4, b: f32x4) -> f32x4 { a.max(b) }
+export fn floor(a: f32x4) -> f32x4 { a.floor() }
+export fn ceil(a: f32x4) -> f32x4 { a.ceil() }
+export fn trunc(a: f32x4) -> f32x4 { a.trunc() }
+export fn nearest(a: f32x4) -> f32x4 { a.nearest() }
+export fn fma(a: f32x4, b: f32x4, c: f32x4) -> f32x4 { a.fma(b, c) }
+export fn dot(a: f32x4, b: f32x4) -> f32 { a.dot(b) }
+export fn sqrt64(a: f64x2) -> f64x2 { a.sqrt() }
+)");
+    ASSERT_TRUE(check_success(wat_result));
+    const auto wat = std::move(wat_result).value();
+
+    for (const auto instruction : {
+             "f32x4.sqrt",
+             "f32x4.abs",
+             "f32x4.min",
+             "f32x4.max",
+             "f32x4.floor",
+             "f32x4.ceil",
+             "f32x4.trunc",
+             "f32x4.nearest",
+             "f32x4.mul",
+             "f32x4.add",
+             "i8x16.shuffle",
+             "f64x2.sqrt",
+         }) {
+        EXPECT_NE(wat.find(instruction), std::string::npos) << instruction << "\n" << wat;
+    }
+
+    // Nothing is scalarized into calls to libm.
+    EXPECT_EQ(wat.find("(import"), std::string::npos) << wat;
+}
@@ -60,3 +60,121 @@ export fn slice_indexed_assignment() -> i32 {
 
     EXPECT_COMPILE_SUCCESS(code);
 }
+
+TEST(Slice, assignment_does_not_change_identical_literals) {
+    const std::string_view code = R"(
+fn read_then_write() -> i32 {
+    let slice = []i32{ 1, 2, 3, 4 }
+    let value = slice[2]
+    slice[2] = 42
+    slice.fill(7)
+    value
+}
+
+export fn literals_are_fresh() -> i32 {
+    let first = read_then_write()
+    let slice = []i32{ 1, 2, 3, 4 }
+    let array = [4]i32{ 1, 2, 3, 4 }
+    first + slice[2] + array[2]
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{3 + 3 + 3}, code, "literals_are_fresh");
+
+    // Each slice literal gets its own writable global, while array literals share a constant one.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("@\"literal.[]i32\" = internal global [4 x i32]"), std::string::npos) << ir;
+    EXPECT_NE(ir.find("@\"literal.[]i32.1\" = internal global [4 x i32]"), std::string::npos)
+        << ir;
+    EXPECT_NE(ir.find("@\"const.[4]i32\" = internal unnamed_addr constant [4 x i32]"),
+              std::string::npos)
+        << ir;
+}
+
+TEST(Slice, literal_outlives_function) {
+    const std::string_view code = R"(
+fn ints() -> []i32 {
+    []i32{ 1, 2, 3, 4 }
+}
+
+export fn sum_of_ints() -> i32 {
+    let slice = ints()
+    let sum = 0
+    let i = 0
+    while i < slice.length() {
+        sum = sum + slice[i]
+        i = i + 1
+    }
+    sum
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{1 + 2 + 3 + 4}, code, "sum_of_ints");
+}
+
+TEST(Slice, copy_from) {
+    const std::string_view code = R"(
+export fn copy_prefix(a: i32, b: i32) -> i32 {
+    let dst = []i32{ a, a, a, a }
+    let copied = dst.copy_from([]i32{ b, b })
+    (copied * 100) + dst[0] + dst[1] + dst[2] + dst[3]
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{200 + 5 + 5 + 1 + 1}, code, "copy_prefix", int32_t{1}, int32_t{5});
+
+    // The slices may overlap, so the elements are moved rather than copied.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("call void @llvm.memmove"), std::string::npos) << ir;
+}
+
+TEST(Slice, fill) {
+    const std::string_view code = R"(
+export fn fill_sum(a: i32, b: i32) -> i32 {
+    let slice = []i32{ a, a, a }
+    slice.fill(b)
+    slice[0] + slice[1] + slice[2]
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{3 * 7}, code, "fill_sum", int32_t{1}, int32_t{7});
+}
+
+TEST(Slice, equals) {
+    const std::string_view code = R"(
+export fn equals_sequence(last: i32) -> i32 {
+    let lhs = []i32{ 1, 2, 3, 4, 5, 6, 7, 8, 9 }
+    if lhs.equals([]i32{ 1, 2, 3, 4, 5, 6, 7, 8, last }) {
+        1
+    } else {
+        0
+    }
+}
+
+export fn equals_shorter(last: i32) -> i32 {
+    if []i32{ 1, 2, 3 }.equals([]i32{ 1, 2, last, 4 }) {
+        1
+    } else {
+        0
+    }
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{1}, code, "equals_sequence", int32_t{9});
+    EXPECT_RUN_RESULT(int32_t{0}, code, "equals_sequence", int32_t{8});
+    EXPECT_RUN_RESULT(int32_t{0}, code, "equals_shorter", int32_t{3});
+}
+
+TEST(Slice, index_of) {
+    const std::string_view code = R"(
+export fn find_digit(value: i32) -> i32 {
+    []i32{ 3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 8 }.index_of(value)
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{0}, code, "find_digit", int32_t{3});
+    EXPECT_RUN_RESULT(int32_t{4}, code, "find_digit", int32_t{5});
+    EXPECT_RUN_RESULT(int32_t{7}, code, "find_digit", int32_t{6});
+    EXPECT_RUN_RESULT(int32_t{10}, code, "find_digit", int32_t{8});
+    EXPECT_RUN_RESULT(int32_t{-1}, code, "find_digit", int32_t{7});
+}
@@ -0,0 +1,108 @@
+#include "rain/spec/util.hpp"
+
+namespace {
+
+size_t count_occurrences(const std::string_view haystack, const std::string_view needle) {
+    size_t count = 0;
+    for (size_t i = haystack.find(needle); i != std::string_view::npos;
+         i = haystack.find(needle, i + needle.size())) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(Stack, let_in_loop_is_allocated_in_entry_block) {
+    const std::string_view code = R"(
+export fn sum_of_squares(n: i32) -> i32 {
+    let total = 0
+    for i in 0..n {
+        let square = i * i
+        total = total + square
+    }
+    total
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{0 + 1 + 4 + 9}, code, "sum_of_squares", int32_t{4});
+
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+
+    // Both slots are allocated once, before the loop, and the one in the loop body is only alive
+    // for a single iteration.
+    const auto loop_position = ir.find("\nfor:");
+    ASSERT_NE(loop_position, std::string::npos) << ir;
+    EXPECT_EQ(count_occurrences(ir, " = alloca "), 2) << ir;
+    EXPECT_LT(ir.rfind(" = alloca "), loop_position) << ir;
+    EXPECT_NE(ir.find("call void @llvm.lifetime.start", loop_position), std::string::npos) << ir;
+    EXPECT_NE(ir.find("call void @llvm.lifetime.end", loop_position), std::string::npos) << ir;
+}
+
+TEST(Stack, sibling_blocks_share_a_slot) {
+    const std::string_view code = R"(
+export fn distance(a: i32, b: i32) -> i32 {
+    let total = 0
+    if a > b {
+        let x = a - b
+        total = x
+    } else {
+        let y = b - a
+        total = y
+    }
+    total
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{3}, code, "distance", int32_t{5}, int32_t{2});
+    EXPECT_RUN_RESULT(int32_t{4}, code, "distance", int32_t{1}, int32_t{5});
+
+    // `x` is no longer alive by the time that `y` is declared, so they use the same slot.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_EQ(count_occurrences(ir, " = alloca "), 2) << ir;
+}
+
+TEST(Stack, break_and_continue_end_lifetimes) {
+    const std::string_view code = R"(
+export fn sum_until(n: i32, limit: i32) -> i32 {
+    let total = 0
+    for i in 0..n {
+        let next = total + i
+        if next > limit {
+            break
+        }
+        let odd = i % 2
+        if odd == 0 {
+            continue
+        }
+        total = next
+    }
+    total
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{1 + 3 + 5}, code, "sum_until", int32_t{100}, int32_t{10});
+
+    // Every path out of the loop body ends the lifetimes of the slots that it started: `next` on
+    // the `break`, `next` and `odd` on the `continue` and at the end of the body, and `total` at
+    // the end of the function.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_EQ(count_occurrences(ir, "call void @llvm.lifetime.start"), 3) << ir;
+    EXPECT_EQ(count_occurrences(ir, "call void @llvm.lifetime.end"), 1 + 2 + 2 + 1) << ir;
+}
+
+TEST(Stack, array_value_of_block_stays_alive) {
+    const std::string_view code = R"(
+export fn pick(swap: i32, a: i32, b: i32) -> i32 {
+    let pair = if swap != 0 {
+        [2]i32{ b, a }
+    } else {
+        [2]i32{ a, b }
+    }
+    pair[0] - pair[1]
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{-1}, code, "pick", int32_t{0}, int32_t{1}, int32_t{2});
+    EXPECT_RUN_RESULT(int32_t{1}, code, "pick", int32_t{1}, int32_t{1}, int32_t{2});
+}
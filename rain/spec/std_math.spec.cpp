@@ -0,0 +1,147 @@
+#include "rain/spec/util.hpp"
+
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "llvm/IR/Verifier.h"
+#include "rain/spec/read_with_std.hpp"
+
+// Specs for lib/std/math, which is read from disk (the tests depend on it as data).
+
+namespace {
+
+rain::util::Result<float> run_with_std(const std::string_view code,
+                                       const std::string_view function_name, const float arg) {
+    rain::spec::initialize_llvm();
+
+    rain::spec::Options options;
+    rain::ModuleGraph   graph(rain::spec::read_with_std(code));
+
+    auto load_result = graph.load("main.rain", options);
+    FORWARD_ERROR(load_result);
+
+    auto module_result = graph.compile(options);
+    FORWARD_ERROR(module_result);
+    return rain::spec::run_module<float>(std::move(module_result).value(), options, function_name,
+                                         arg);
+}
+
+constexpr std::string_view IMPORTS = R"(
+import { Mat4 } from "lib/std/math/mat4"
+import { Vec4 } from "lib/std/math/vec4"
+)";
+
+}  // namespace
+
+TEST(StdMath, compiles) {
+    rain::spec::initialize_llvm();
+
+    rain::spec::Options options;
+    rain::ModuleGraph   graph(rain::spec::read_with_std(""));
+    ASSERT_TRUE(check_success(graph.load("lib/std/math/mat4.rain", options)));
+    ASSERT_EQ(graph.order().size(), 2);
+
+    auto module_result = graph.compile(options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+    mod.optimize();
+    ASSERT_TRUE(check_success(mod.emit_ir()));
+}
+
+TEST(StdMath, vec4) {
+    const auto code = absl::StrCat(IMPORTS, R"(
+export fn vec4(x: f32) -> f32 {
+    let a = Vec4.new(x, 0.0, 0.0, 7.0)
+    let b = Vec4.y()
+    let c = a.cross(b)
+    let n = Vec4.new(3.0, 4.0, 0.0, 0.0)
+    let d = a.add(b).dot(b)
+    c.v.z + c.v.w * 10.0 + n.length() * 100.0 + n.normalize().v.y * 1000.0 + d * 10000.0
+}
+)");
+
+    auto result = run_with_std(code, "vec4", 2.0f);
+    ASSERT_TRUE(check_success(result));
+    EXPECT_FLOAT_EQ(std::move(result).value(), 2.0f + 0.0f + 500.0f + 800.0f + 10000.0f);
+}
+
+TEST(StdMath, mul_and_translate) {
+    const auto code = absl::StrCat(IMPORTS, R"(
+export fn transform(x: f32) -> f32 {
+    let a = Mat4.translation(1.0, 2.0, 3.0).mul(Mat4.scaling(2.0, 2.0, 2.0))
+    let b = Mat4.scaling(2.0, 2.0, 2.0).translate(1.0, 2.0, 3.0)
+    let u = a.mul_vec4(Vec4.new(x, 1.0, 1.0, 1.0)).v
+    let v = b.mul_vec4(Vec4.new(x, 1.0, 1.0, 1.0)).v
+    u.x + u.y * 10.0 + u.z * 100.0 + u.w * 1000.0 + v.x * 10000.0 + v.z * 100000.0
+}
+)");
+
+    // Scaling then translating (1, 1, 1) gives (3, 4, 5), and translating then scaling (4, 6, 8).
+    auto result = run_with_std(code, "transform", 1.0f);
+    ASSERT_TRUE(check_success(result));
+    EXPECT_FLOAT_EQ(std::move(result).value(), 3.0f + 40.0f + 500.0f + 1000.0f + 40000.0f +
+                                                   800000.0f);
+}
+
+TEST(StdMath, transpose) {
+    const auto code = absl::StrCat(IMPORTS, R"(
+export fn transpose(x: f32) -> f32 {
+    let m = Mat4.new(
+        x, 2.0, 3.0, 4.0,
+        5.0, 6.0, 7.0, 8.0,
+        9.0, 10.0, 11.0, 12.0,
+        13.0, 14.0, 15.0, 16.0,
+    )
+    let t = m.transpose()
+    m.x.y + t.x.y * 100.0 + t.w.x * 10000.0
+}
+)");
+
+    auto result = run_with_std(code, "transpose", 1.0f);
+    ASSERT_TRUE(check_success(result));
+    EXPECT_FLOAT_EQ(std::move(result).value(), 5.0f + 200.0f + 130000.0f);
+}
+
+TEST(StdMath, inverse) {
+    const auto code = absl::StrCat(IMPORTS, R"(
+export fn inverse_error(x: f32) -> f32 {
+    let m = Mat4.new(
+        2.0, 0.0, 1.0, x,
+        1.0, 3.0, 0.0, 2.0,
+        0.0, 1.0, 4.0, 1.0,
+        1.0, 0.0, 0.0, 1.0,
+    )
+    let p = m.mul(m.inverse())
+    let i = Mat4.identity()
+    let e = (p.x - i.x).abs() + (p.y - i.y).abs() + (p.z - i.z).abs() + (p.w - i.w).abs()
+    e.sum()
+}
+)");
+
+    auto result = run_with_std(code, "inverse_error", 1.0f);
+    ASSERT_TRUE(check_success(result));
+    EXPECT_NEAR(std::move(result).value(), 0.0f, 1e-5f);
+}
+
+TEST(StdMath, look_at_and_perspective) {
+    const auto code = absl::StrCat(IMPORTS, R"(
+fn depth(m: Mat4, z: f32) -> f32 {
+    let p = m.mul_vec4(Vec4.new(0.0, 0.0, z, 1.0)).v
+    p.z / p.w
+}
+
+export fn depths(distance: f32) -> f32 {
+    let view = Mat4.look_at(Vec4.new(0.0, 0.0, distance, 1.0), Vec4.w(), Vec4.y())
+    let projection = Mat4.perspective(1.0, 1.0, 1.0, 10.0)
+    let m = projection.mul(view)
+    depth(m, distance - 1.0) + depth(m, distance - 10.0) * 10.0
+}
+)");
+
+    // The near plane maps to a depth of 0, and the far plane to 1.
+    auto result = run_with_std(code, "depths", 5.0f);
+    ASSERT_TRUE(check_success(result));
+    EXPECT_NEAR(std::move(result).value(), 10.0f, 1e-5f);
+}
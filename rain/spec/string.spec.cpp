@@ -9,3 +9,27 @@ export fn string_length() -> i32 {
 
     EXPECT_COMPILE_SUCCESS(code);
 }
+
+TEST(String, identical_literals_share_a_global) {
+    const std::string_view code = R"(
+fn greeting() -> i32 {
+    "Hello, world!".length()
+}
+
+export fn total_length() -> i32 {
+    greeting() + "Hello, world!".length() + "Goodbye".length()
+}
+)";
+
+    EXPECT_RUN_RESULT(int32_t{13 + 13 + 7}, code, "total_length");
+
+    // One global for each distinct string, which the linker may merge with other modules' data.
+    const auto ir = rain::spec::compile_unoptimized_ir(code);
+    EXPECT_NE(ir.find("@const.string = internal unnamed_addr constant [13 x i8]"),
+              std::string::npos)
+        << ir;
+    EXPECT_NE(ir.find("@const.string.1 = internal unnamed_addr constant [7 x i8]"),
+              std::string::npos)
+        << ir;
+    EXPECT_EQ(ir.find("@const.string.2 ="), std::string::npos) << ir;
+}
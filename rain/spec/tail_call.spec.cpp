@@ -0,0 +1,112 @@
+#include <string>
+
+#include "rain/spec/util.hpp"
+
+// Checks that calls in tail position become wasm `return_call`s when the tail-call feature is
+// enabled, so that recursion through them does not grow the stack.
+
+namespace {
+
+constexpr std::string_view PARITY = R"(
+export fn is_even(n: i32) -> i32 {
+    if n == 0 {
+        1
+    } else {
+        is_odd(n - 1)
+    }
+}
+
+fn is_odd(n: i32) -> i32 {
+    if n == 0 {
+        0
+    } else if n == 1 {
+        1
+    } else {
+        is_even(n - 1)
+    }
+}
+)";
+
+/** Compile the code without optimizing it, so that the recursion is not turned into a loop. */
+rain::util::Result<rain::lang::code::Module> compile_unoptimized(
+    const std::string_view code, rain::lang::wasm::Options& options) {
+    rain::lang::wasm::initialize_llvm();
+
+    auto module_result = rain::compile(code, options);
+    FORWARD_ERROR(module_result);
+    auto mod = std::move(module_result).value();
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+    return mod;
+}
+
+}  // namespace
+
+TEST(TailCall, mutual_recursion_runs_in_constant_stack) {
+    rain::lang::wasm::Options options;
+    ASSERT_TRUE(check_success(options.set_features("+tail-call")));
+
+    auto module_result = compile_unoptimized(PARITY, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto mod = std::move(module_result).value();
+
+    auto ir_result = mod.emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+    const auto ir = std::move(ir_result).value();
+    EXPECT_NE(ir.find("musttail call i32 @is_odd("), std::string::npos) << ir;
+    EXPECT_NE(ir.find("musttail call i32 @is_even("), std::string::npos) << ir;
+
+    auto link_result = rain::link(mod, options);
+    ASSERT_TRUE(check_success(link_result));
+    const auto wasm = std::move(link_result).value();
+
+    auto wat_result = rain::decompile(wasm->data());
+    ASSERT_TRUE(check_success(wat_result));
+    const std::string wat(std::move(wat_result).value()->string());
+    EXPECT_NE(wat.find("return_call "), std::string::npos) << wat;
+
+    // Far deeper than the interpreter's call stack, or the shadow stack, would allow otherwise.
+    auto instance_result = rain::WasmInstance::instantiate(wasm->data());
+    ASSERT_TRUE(check_success(instance_result));
+    auto instance = std::move(instance_result).value();
+
+    auto even_result = instance.invoke<int32_t>("is_even", int32_t{1'000'000});
+    ASSERT_TRUE(check_success(even_result));
+    EXPECT_EQ(std::move(even_result).value(), 1);
+
+    auto odd_result = instance.invoke<int32_t>("is_even", int32_t{1'000'001});
+    ASSERT_TRUE(check_success(odd_result));
+    EXPECT_EQ(std::move(odd_result).value(), 0);
+}
+
+TEST(TailCall, disabled_by_default) {
+    rain::lang::wasm::Options options;
+
+    auto module_result = compile_unoptimized(PARITY, options);
+    ASSERT_TRUE(check_success(module_result));
+    auto ir_result = std::move(module_result).value().emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+    const auto ir = std::move(ir_result).value();
+    EXPECT_EQ(ir.find("tail call"), std::string::npos) << ir;
+}
+
+TEST(TailCall, not_with_stack_slots) {
+    rain::lang::wasm::Options options;
+    ASSERT_TRUE(check_success(options.set_features("+tail-call")));
+
+    // The callee gets a slice of an array in the frame of the caller, which a tail call would free.
+    auto module_result = compile_unoptimized(R"(
+fn first(values: []i32) -> i32 {
+    values[0]
+}
+
+export fn first_of(a: i32, b: i32) -> i32 {
+    first([]i32{ a, b })
+}
+)",
+                                             options);
+    ASSERT_TRUE(check_success(module_result));
+    auto ir_result = std::move(module_result).value().emit_ir();
+    ASSERT_TRUE(check_success(ir_result));
+    const auto ir = std::move(ir_result).value();
+    EXPECT_EQ(ir.find("tail call i32 @first("), std::string::npos) << ir;
+}
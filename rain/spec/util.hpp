@@ -3,6 +3,7 @@
 #include <string_view>
 
 #include "gtest/gtest.h"
+#include "llvm/IR/Verifier.h"
 
 // This must be included after gtest.h because the util::Result class checks if gtest was included
 // in order to add additional functionality.
@@ -10,15 +11,104 @@
 #include "rain/lang/target/wasm/options.hpp"
 #include "rain/rain.hpp"
 
+#if defined(RAIN_SPEC_NATIVE)
+#include "rain/lang/target/native/init.hpp"
+#include "rain/lang/target/native/jit.hpp"
+#include "rain/lang/target/native/options.hpp"
+#else
+#include "rain/run.hpp"
+#endif  // defined(RAIN_SPEC_NATIVE)
+
+namespace rain::spec {
+
+// The target that the EXPECT_COMPILE_* specs are compiled for.
+#if defined(RAIN_SPEC_NATIVE)
+using Options = rain::lang::native::Options;
+inline void initialize_llvm() { rain::lang::native::initialize_llvm(); }
+#else
+using Options = rain::lang::wasm::Options;
+inline void initialize_llvm() { rain::lang::wasm::initialize_llvm(); }
+#endif  // defined(RAIN_SPEC_NATIVE)
+
+}  // namespace rain::spec
+
 #define DO_OPTIMIZE true
 #define DO_PRINT false
 
+namespace rain::spec {
+
+/**
+ * Call the exported function of an already compiled module with the given arguments: linked to
+ * wasm and run on the interpreter, or run in-process on the JIT for the native specs.
+ */
+template <typename R, typename... Args>
+util::Result<R> run_module(rain::lang::code::Module mod, Options& options,
+                           const std::string_view function_name, Args... args) {
+    if (DO_OPTIMIZE) {
+        mod.optimize();
+    }
+
+#if defined(RAIN_SPEC_NATIVE)
+    auto jit_result = rain::lang::native::Jit::create();
+    FORWARD_ERROR(jit_result);
+    auto jit = std::move(jit_result).value();
+
+    auto add_result = jit.add_module(std::move(mod));
+    FORWARD_ERROR(add_result);
+    return jit.invoke<R>(function_name, args...);
+#else
+    auto link_result = rain::link(mod, options);
+    FORWARD_ERROR(link_result);
+    const auto wasm = std::move(link_result).value();
+
+    auto instance_result = rain::WasmInstance::instantiate(wasm->data());
+    FORWARD_ERROR(instance_result);
+    auto instance = std::move(instance_result).value();
+    return instance.invoke<R>(function_name, args...);
+#endif  // defined(RAIN_SPEC_NATIVE)
+}
+
+/** Compile the code and call the exported function with the given arguments. */
+template <typename R, typename... Args>
+util::Result<R> run(const std::string_view code, const std::string_view function_name,
+                    Args... args) {
+    initialize_llvm();
+
+    Options options;
+    auto    module_result = rain::compile(code, options);
+    FORWARD_ERROR(module_result);
+    return run_module<R>(std::move(module_result).value(), options, function_name, args...);
+}
+
+/** Compile the code without optimizing it, and return the (verified) IR that codegen emitted. */
+inline std::string compile_unoptimized_ir(const std::string_view code) {
+    initialize_llvm();
+
+    Options options;
+    auto    module_result = rain::compile(code, options);
+    EXPECT_TRUE(check_success(module_result));
+    if (!module_result.has_value()) {
+        return "";
+    }
+    auto mod = std::move(module_result).value();
+    EXPECT_FALSE(llvm::verifyModule(mod.llvm_module(), &llvm::errs()));
+
+    auto ir_result = mod.emit_ir();
+    EXPECT_TRUE(check_success(ir_result));
+    if (!ir_result.has_value()) {
+        return "";
+    }
+    return std::move(ir_result).value();
+}
+
+}  // namespace rain::spec
+
 #define EXPECT_COMPILE_SUCCESS($code)                                            \
     do {                                                                         \
-        rain::lang::wasm::initialize_llvm();                                     \
+        rain::spec::initialize_llvm();                                           \
                                                                                  \
-        rain::lang::wasm::Options options;                                       \
-        auto                      module_result = rain::compile($code, options); \
+        rain::spec::Options options;                                             \
+        auto                module_result = rain::compile($code, options);       \
         ASSERT_TRUE(check_success(module_result));                               \
         auto mod = std::move(module_result).value();                             \
                                                                                  \
@@ -37,9 +127,18 @@
 
 #define EXPECT_COMPILE_ERROR($code)                                              \
     do {                                                                         \
-        rain::lang::wasm::initialize_llvm();                                     \
+        rain::spec::initialize_llvm();                                           \
                                                                                  \
-        rain::lang::wasm::Options options;                                       \
-        auto                      module_result = rain::compile($code, options); \
+        rain::spec::Options options;                                             \
+        auto                module_result = rain::compile($code, options);       \
         ASSERT_FALSE(check_success(module_result));                              \
     } while (false)
+
+#define EXPECT_RUN_RESULT($expected, $code, $function_name, ...)                 \
+    do {                                                                         \
+        using result_type = std::decay_t<decltype($expected)>;                   \
+        auto run_result   = rain::spec::run<result_type>(                        \
+            $code, $function_name __VA_OPT__(, ) __VA_ARGS__);                   \
+        ASSERT_TRUE(check_success(run_result));                                  \
+        EXPECT_EQ(std::move(run_result).value(), $expected);                     \
+    } while (false)